@@ -102,6 +102,8 @@ export PFE_CFG_RT_MEM?="pfe_ddr"
 export PFE_CFG_RT_HASH_SIZE?=256
 #Routing table collision size (number of entries)
 export PFE_CFG_RT_COLLISION_SIZE?=256
+#Routing table maximum number of entries within a hash bucket (0 = unlimited)
+export PFE_CFG_RT_MAX_CHAIN_LEN?=8
 #Conntrack stats table size (number of entries)
 export PFE_CFG_CONN_STATS_SIZE?=20
 #Health monitor error string compiled in switch(true or false)
@@ -231,7 +233,11 @@ ifneq ($(PFE_CFG_HIF_NOCPY_SUPPORT),0)
   ifeq ($(TARGET_OS),QNX)
     GLOBAL_CCFLAGS+=-DPFE_CFG_HIF_NOCPY_SUPPORT
   else
-	#todo Implement HIF NOCPY support on Linux AAVB-2829
+    # Linux: NOCPY mode is not supported, the HIF layer implements only the
+    # standard BD ring format. NOCPY frames stay in PFE (BMU) buffers which must
+    # be returned to the PFE, so passing them to the stack would need a CPU copy
+    # out of PFE memory. Standard mode keeps the HIF DMA copy into host pages,
+    # which are attached to the skb without a further copy. Ignore the option.
   endif
 endif
 
@@ -363,6 +369,9 @@ ifneq ($(PFE_CFG_RT_COLLISION_SIZE),0)
     GLOBAL_CCFLAGS+=-DPFE_CFG_RT_COLLISION_SIZE=$(PFE_CFG_RT_COLLISION_SIZE)
 endif
 
+# Zero is a valid value (unlimited) so the symbol is always passed
+GLOBAL_CCFLAGS+=-DPFE_CFG_RT_MAX_CHAIN_LEN=$(PFE_CFG_RT_MAX_CHAIN_LEN)
+
 ifneq ($(PFE_CFG_CONN_STATS_SIZE),0)
     GLOBAL_CCFLAGS+=-DPFE_CFG_CONN_STATS_SIZE=$(PFE_CFG_CONN_STATS_SIZE)
 endif
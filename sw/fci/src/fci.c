@@ -298,6 +298,23 @@ errno_t fci_process_ipc_message(fci_msg_t *msg, fci_msg_t *rep_msg)
 						break;
 					}
 
+					case FPP_CMD_CONNTRACK_STATS:
+					{
+						/*	Bulk readout of conntrack statistics */
+						ret = oal_mutex_lock(&fci_context->db_mutex);
+						if (EOK == ret)
+						{
+							ret = fci_connections_stats_cmd(msg, &fci_ret, (fpp_conntrack_stats_bulk_cmd_t *)reply_buf_ptr, reply_buf_len_ptr);
+							(void)oal_mutex_unlock(&fci_context->db_mutex);
+						}
+						else
+						{
+							NXP_LOG_ERROR("Mutex lock failed\n");
+						}
+
+						break;
+					}
+
 					case FPP_CMD_IPV4_CONNTRACK:
 					{
 						/*	Process 'ipv4 connection' commands (add/del/updated/query/...) */
@@ -657,6 +674,11 @@ errno_t fci_init(fci_init_info_t *info, const char_t *const identifier)
 			            	{
 			            		fci_context->l2_bridge = info->l2_bridge;
 			            		fci_context->l2_bridge_initialized = TRUE;
+
+			            		if (EOK == fci_l2br_fdb_event_cb_register())
+			            		{
+			            			fci_context->fdb_event_cb_registered = TRUE;
+			            		}
 			            	}
 			            }
 
@@ -723,6 +745,13 @@ void fci_fini(void)
 				}
 			}
 		}
+
+		/* Deregister MAC table callback function */
+		if (TRUE == fci_context->fdb_event_cb_registered)
+		{
+			(void)fci_l2br_fdb_event_cb_deregister();
+			fci_context->fdb_event_cb_registered = FALSE;
+		}
 #endif /* PFE_CFG_PFE_MASTER */
 
 		/* Deregister HM callback function */
@@ -844,6 +844,7 @@ static errno_t fci_connections_entry_to_ipv4_cmd(pfe_rtable_entry_t *entry, pfe_
 		ct_cmd->route_id = route_id;
 		ct_cmd->stats.hit = oal_htonl(stats.hit);
 		ct_cmd->stats.hit_bytes = oal_htonl(stats.hit_bytes);
+		ct_cmd->stats_index = pfe_rtable_entry_get_stats_index(entry);
 
 		/*	Check if reply direction exists */
 		if (NULL == rep_entry)
@@ -868,6 +869,7 @@ static errno_t fci_connections_entry_to_ipv4_cmd(pfe_rtable_entry_t *entry, pfe_
 			/*	Prepare reply direction statistics data */
 			ct_cmd->stats_reply.hit = oal_htonl(stats.hit);
 			ct_cmd->stats_reply.hit_bytes = oal_htonl(stats.hit_bytes);
+			ct_cmd->stats_index_reply = pfe_rtable_entry_get_stats_index(rep_entry);
 
 			/*	Prepare reply direction route id */
 			pfe_rtable_entry_get_route_id(rep_entry, &route_id);
@@ -976,6 +978,7 @@ static errno_t fci_connections_entry_to_ipv6_cmd(pfe_rtable_entry_t *entry, pfe_
 		ct6_cmd->route_id = route_id;
 		ct6_cmd->stats.hit = oal_htonl(stats.hit);
 		ct6_cmd->stats.hit_bytes = oal_htonl(stats.hit_bytes);
+		ct6_cmd->stats_index = pfe_rtable_entry_get_stats_index(entry);
 
 		/*	Check if reply direction exists */
 		if (NULL == rep_entry)
@@ -1000,6 +1003,7 @@ static errno_t fci_connections_entry_to_ipv6_cmd(pfe_rtable_entry_t *entry, pfe_
 			/*	Prepare reply direction statistics data */
 			ct6_cmd->stats_reply.hit = oal_htonl(stats.hit);
 			ct6_cmd->stats_reply.hit_bytes = oal_htonl(stats.hit_bytes);
+			ct6_cmd->stats_index_reply = pfe_rtable_entry_get_stats_index(rep_entry);
 
 			/*	Prepare reply direction route id */
 			pfe_rtable_entry_get_route_id(rep_entry, &route_id);
@@ -1201,6 +1205,9 @@ static errno_t fci_connections_ipvx_ct_cmd(bool_t ipv6, const fci_msg_t *msg, ui
 	fpp_ct6_cmd_t *ct6_cmd, *ct6_reply;
 	errno_t ret = EOK;
 	pfe_rtable_entry_t *entry = NULL, *rep_entry = NULL;
+	pfe_rtable_entry_t *add_entries[2];
+	errno_t add_results[2] = {EOK, EOK};
+	uint32_t add_count = 0U;
 	pfe_5_tuple_t tuple;
 	pfe_phy_if_t *phy_if = NULL, *phy_if_reply = NULL;
 
@@ -1309,14 +1316,33 @@ static errno_t fci_connections_ipvx_ct_cmd(bool_t ipv6, const fci_msg_t *msg, ui
 						;
 					}
 
-					/*	Add entry into the routing table */
+					/*	Remember the issuing FCI client and the associated reply entry */
 					if (NULL != entry)
 					{
-						/*	Remember the issuing FCI client and the associated reply entry */
 						pfe_rtable_entry_set_refptr(entry, msg->client);
 						pfe_rtable_entry_set_child(entry, rep_entry);
+						add_entries[add_count] = entry;
+						add_count++;
+					}
+
+					if (NULL != rep_entry)
+					{
+						pfe_rtable_entry_set_refptr(rep_entry, msg->client);
+						add_entries[add_count] = rep_entry;
+						add_count++;
+					}
+
+					/*	Add both directions at once, the results are evaluated per direction below.
+						Failed entry in one direction causes removal of the other one. */
+					if (0U != add_count)
+					{
+						(void)pfe_rtable_add_entries(fci_context->rtable, add_entries, add_count, add_results);
+					}
 
-						ret = pfe_rtable_add_entry(fci_context->rtable, entry);
+					/*	Add entry into the routing table */
+					if (NULL != entry)
+					{
+						ret = add_results[0];
 						if (EEXIST == ret)
 						{
 							NXP_LOG_WARNING("FPP_CMD_IPVx_CONNTRACK: Entry already added\n");
@@ -1373,10 +1399,7 @@ static errno_t fci_connections_ipvx_ct_cmd(bool_t ipv6, const fci_msg_t *msg, ui
 					/*	Add entry also for reply direction if requested */
 					if (NULL != rep_entry)
 					{
-						/*	Remember the issuing FCI client */
-						pfe_rtable_entry_set_refptr(rep_entry, msg->client);
-
-						ret = pfe_rtable_add_entry(fci_context->rtable, rep_entry);
+						ret = add_results[add_count - 1U];
 						if (EEXIST == ret)
 						{
 							NXP_LOG_WARNING("FPP_CMD_IPVx_CONNTRACK: Reply entry already added\n");
@@ -1702,6 +1725,123 @@ errno_t fci_connections_ipv6_ct_cmd(const fci_msg_t *msg, uint16_t *fci_ret, fpp
 	return ret;
 }
 
+/**
+ * @brief			Process FPP_CMD_CONNTRACK_STATS commands
+ * @param[in]		msg FCI message containing the FPP_CMD_CONNTRACK_STATS command
+ * @param[out]		fci_ret FCI command return value
+ * @param[out]		reply_buf Pointer to a buffer where function will construct command reply (fpp_conntrack_stats_bulk_cmd_t)
+ * @param[in,out]	reply_len Maximum reply buffer size on input, real reply size on output (in bytes)
+ * @return			EOK if success, error code otherwise
+ * @note			Function is only called within the FCI worker thread context.
+ * @note			Must run with route DB protected against concurrent accesses.
+ */
+errno_t fci_connections_stats_cmd(const fci_msg_t *msg, uint16_t *fci_ret, fpp_conntrack_stats_bulk_cmd_t *reply_buf, uint32_t *reply_len)
+{
+	fci_t *fci_context = (fci_t *)&__context;
+	const fpp_conntrack_stats_bulk_cmd_t *stats_cmd;
+	pfe_ct_conntrack_stats_t stats[FPP_CONNTRACK_STATS_BULK_MAX];
+	uint32_t total;
+	uint32_t count;
+	uint32_t ii;
+	errno_t ret;
+
+#if defined(PFE_CFG_NULL_ARG_CHECK)
+	if (unlikely((NULL == msg) || (NULL == fci_ret) || (NULL == reply_buf) || (NULL == reply_len)))
+	{
+		NXP_LOG_ERROR("NULL argument received\n");
+		ret = EINVAL;
+	}
+	else if (unlikely(FALSE == fci_context->fci_initialized))
+	{
+		NXP_LOG_ERROR("Context not initialized\n");
+		ret = EPERM;
+	}
+	else
+#endif /* PFE_CFG_NULL_ARG_CHECK */
+	{
+		if (*reply_len < sizeof(fpp_conntrack_stats_bulk_cmd_t))
+		{
+			NXP_LOG_ERROR("Buffer length does not match expected value (fpp_conntrack_stats_bulk_cmd_t)\n");
+			ret = EINVAL;
+		}
+		else
+		{
+			/*	No data written to reply buffer (yet) */
+			*reply_len = 0U;
+			/*	Initialize the reply buffer */
+			(void)memset(reply_buf, 0, sizeof(fpp_conntrack_stats_bulk_cmd_t));
+
+			stats_cmd = (fpp_conntrack_stats_bulk_cmd_t *)(msg->msg_cmd.payload);
+			total = pfe_rtable_get_stats_table_size(fci_context->rtable);
+			ret = EOK;
+
+			switch (stats_cmd->action)
+			{
+				case FPP_ACTION_QUERY:
+				{
+					fci_context->ct_stats_next = 0U;
+					break;
+				}
+
+				case FPP_ACTION_QUERY_CONT:
+				{
+					break;
+				}
+
+				default:
+				{
+					NXP_LOG_ERROR("Connection Command: Unknown action received: 0x%x\n", stats_cmd->action);
+					*fci_ret = FPP_ERR_WRONG_COMMAND_PARAM;
+					ret = EINVAL;
+					break;
+				}
+			}
+
+			if (EOK == ret)
+			{
+				if (fci_context->ct_stats_next >= total)
+				{
+					/*	End of the query session */
+					*fci_ret = FPP_ERR_CT_ENTRY_NOT_FOUND;
+				}
+				else
+				{
+					count = total - fci_context->ct_stats_next;
+					if (count > FPP_CONNTRACK_STATS_BULK_MAX)
+					{
+						count = FPP_CONNTRACK_STATS_BULK_MAX;
+					}
+
+					/*	One DMEM burst per PE for the whole chunk */
+					ret = pfe_rtable_get_stats_bulk(fci_context->rtable, stats, (uint8_t)fci_context->ct_stats_next, count);
+					if (EOK != ret)
+					{
+						NXP_LOG_ERROR("Failed to get conntrack statistics: %d\n", ret);
+						*fci_ret = FPP_ERR_INTERNAL_FAILURE;
+					}
+					else
+					{
+						reply_buf->first_index = oal_htons((uint16_t)fci_context->ct_stats_next);
+						reply_buf->count = oal_htons((uint16_t)count);
+						reply_buf->total = oal_htons((uint16_t)total);
+						for (ii = 0U; ii < count; ii++)
+						{
+							reply_buf->stats[ii].hit = oal_htonl(stats[ii].hit);
+							reply_buf->stats[ii].hit_bytes = oal_htonl(stats[ii].hit_bytes);
+						}
+
+						fci_context->ct_stats_next += (uint16_t)count;
+						*reply_len = sizeof(fpp_conntrack_stats_bulk_cmd_t);
+						*fci_ret = FPP_ERR_OK;
+					}
+				}
+			}
+		}
+	}
+
+	return ret;
+}
+
 /**
  * @brief			Process FPP_CMD_IPV4_SET_TIMEOUT commands
  * @param[in]		msg FCI message containing the FPP_CMD_IPV4_SET_TIMEOUT command
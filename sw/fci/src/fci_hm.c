@@ -132,7 +132,8 @@ errno_t fci_hm_cb_register(void)
  */
 errno_t fci_hm_cb_deregister(void)
 {
-	return EOK; /* HM module currently does not support callback deregistration. */
+	pfe_hm_unregister_event_cb(fci_hm_cb);
+	return EOK;
 }
 
 #endif /* PFE_CFG_FCI_ENABLE */
@@ -73,7 +73,10 @@ struct fci_tag
 		uint32_t timeout_other;
 	} default_timeouts;
 
+	uint16_t ct_stats_next;			/* Next conntrack statistics index to be reported by FPP_CMD_CONNTRACK_STATS */
+
 	bool_t hm_cb_registered;
+	bool_t fdb_event_cb_registered;
 	bool_t is_some_client;			/* TRUE if there is at least one client registered for FCI events. */
 
 #ifdef PFE_CFG_MULTI_INSTANCE_SUPPORT
@@ -106,10 +109,13 @@ errno_t fci_interfaces_mac_cmd(fci_msg_t *msg, uint16_t *fci_ret, fpp_if_mac_cmd
 errno_t fci_routes_cmd(fci_msg_t *msg, uint16_t *fci_ret, fpp_rt_cmd_t *reply_buf, uint32_t *reply_len);
 errno_t fci_connections_ipv4_ct_cmd(const fci_msg_t *msg, uint16_t *fci_ret, fpp_ct_cmd_t *reply_buf, uint32_t *reply_len);
 errno_t fci_connections_ipv6_ct_cmd(const fci_msg_t *msg, uint16_t *fci_ret, fpp_ct6_cmd_t *reply_buf, uint32_t *reply_len);
+errno_t fci_connections_stats_cmd(const fci_msg_t *msg, uint16_t *fci_ret, fpp_conntrack_stats_bulk_cmd_t *reply_buf, uint32_t *reply_len);
 errno_t fci_connections_ipv4_timeout_cmd(fci_msg_t *msg, uint16_t *fci_ret, fpp_timeout_cmd_t *reply_buf, uint32_t *reply_len);
 errno_t fci_l2br_domain_cmd(fci_msg_t *msg, uint16_t *fci_ret, fpp_l2_bd_cmd_t *reply_buf, uint32_t *reply_len);
 errno_t fci_l2br_static_entry_cmd(fci_msg_t *msg, uint16_t *fci_ret, fpp_l2_static_ent_cmd_t *reply_buf, uint32_t *reply_len);
 errno_t fci_l2br_flush_cmd(uint32_t code, uint16_t *fci_ret);
+errno_t fci_l2br_fdb_event_cb_register(void);
+errno_t fci_l2br_fdb_event_cb_deregister(void);
 errno_t fci_routes_drop_one(fci_rt_db_entry_t *route);
 void fci_routes_drop_all(void);
 void fci_routes_drop_all_ipv4(void);
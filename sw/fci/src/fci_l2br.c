@@ -105,6 +105,107 @@ errno_t fci_l2br_flush_cmd(uint32_t code, uint16_t *fci_ret)
 	return ret;
 }
 
+/**
+ * @brief			Callback from the MAC table. Intended for sending of FPP_CMD_L2_FDB_EVENT.
+ * @details			Called for every MAC table entry added, removed or changed including entries
+ *					learned and aged by the hardware.
+ * @param[in]		arg Not used
+ * @param[in]		event The event
+ * @param[in]		entry The affected MAC table entry
+ */
+static void fci_l2br_fdb_event_cb(void *arg, pfe_l2br_table_event_t event, const pfe_l2br_table_entry_t *entry)
+{
+	const fci_t *fci_context = (fci_t *)&__context;
+	fpp_l2_fdb_event_t *fdb_event;
+	pfe_ct_mac_table_result_t action_data;
+	fci_msg_t msg = {0};
+
+	(void)arg;
+
+	if (TRUE == fci_context->is_some_client)  /* Report only if there is someone to send data to. */
+	{
+		msg.type = FCI_MSG_CMD;
+		msg.msg_cmd.code = FPP_CMD_L2_FDB_EVENT;
+		msg.msg_cmd.length = sizeof(fpp_l2_fdb_event_t);
+
+		{
+			/* Indented code block needed because ct_assert() otherwise causes
+			 * compilation error 'ISO C90 forbids mixed declarations and code' */
+			ct_assert(sizeof(msg.msg_cmd.payload) >= sizeof(fpp_l2_fdb_event_t));
+		}
+		fdb_event = (fpp_l2_fdb_event_t *)msg.msg_cmd.payload;
+
+		switch (event)
+		{
+			case L2BR_TABLE_EVT_ADDED:
+			{
+				fdb_event->action = FPP_ACTION_REGISTER;
+				break;
+			}
+
+			case L2BR_TABLE_EVT_REMOVED:
+			{
+				fdb_event->action = FPP_ACTION_REMOVED;
+				break;
+			}
+
+			default:
+			{
+				fdb_event->action = FPP_ACTION_UPDATE;
+				break;
+			}
+		}
+
+		action_data.val = (uint32_t)pfe_l2br_table_entry_get_action_data(entry);
+		fdb_event->vlan = oal_htons((uint16_t)pfe_l2br_table_entry_get_vlan(entry));
+		(void)pfe_l2br_table_entry_get_mac_addr(entry, fdb_event->mac);
+		fdb_event->forward_list = oal_htonl(action_data.item.forward_list);
+		fdb_event->local = (uint8_t)action_data.item.local_l3;
+		fdb_event->dst_discard = (uint8_t)action_data.item.dst_discard;
+		fdb_event->src_discard = (uint8_t)action_data.item.src_discard;
+		fdb_event->is_static = (uint8_t)action_data.item.static_flag;
+
+		if (EOK != fci_core_client_send_broadcast(&msg, NULL))
+		{
+			NXP_LOG_DEBUG("Could not send FDB event\n");
+		}
+	}
+}
+
+/**
+ * @brief	Register FCI callback in the MAC table. This needs to be called during FCI init.
+ * @return	EOK if success, error code otherwise.
+ */
+errno_t fci_l2br_fdb_event_cb_register(void)
+{
+	const fci_t *fci_context = (fci_t *)&__context;
+	errno_t ret = EINVAL;
+
+	if (TRUE == fci_context->l2_bridge_initialized)
+	{
+		ret = pfe_l2br_table_register_event_cb(pfe_l2br_get_mac_table(fci_context->l2_bridge), &fci_l2br_fdb_event_cb, NULL);
+	}
+
+	return ret;
+}
+
+/**
+ * @brief	Deregister FCI callback from the MAC table. This needs to be called during FCI fini.
+ * @return	EOK if success, error code otherwise.
+ */
+errno_t fci_l2br_fdb_event_cb_deregister(void)
+{
+	const fci_t *fci_context = (fci_t *)&__context;
+	errno_t ret = EINVAL;
+
+	if (TRUE == fci_context->l2_bridge_initialized)
+	{
+		ret = pfe_l2br_table_unregister_event_cb(pfe_l2br_get_mac_table(fci_context->l2_bridge), &fci_l2br_fdb_event_cb, NULL);
+	}
+
+	return ret;
+}
+
 #ifdef PFE_CFG_TARGET_OS_AUTOSAR
 #define ETH_43_PFE_STOP_SEC_CODE
 #include "Eth_43_PFE_MemMap.h"
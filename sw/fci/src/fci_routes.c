@@ -34,20 +34,25 @@
 #include "Eth_43_PFE_MemMap.h"
 #endif /* PFE_CFG_TARGET_OS_AUTOSAR */
 
+/*	Number of connections removed from the routing table at once when a route is dropped */
+#define FCI_ROUTES_CFG_DROP_BATCH_SIZE	16U
+
 static void fci_routes_remove_related_connections(fci_rt_db_entry_t *route);
 
 /*
  * @brief		Remove all connections related to the given route
  * @details		When a route becomes invalid or it is being removed, all related connections need
- * 				to be handled. Go therefore through all registered connections and remove ones which
- *				are related to the referenced route (by ID).
+ * 				to be handled. Go therefore through all connections which are related to the referenced
+ *				route (by ID) and remove them. The routing table keeps them indexed by route ID.
  * @param[in]	route The reference route
  */
 static void fci_routes_remove_related_connections(fci_rt_db_entry_t *route)
 {
 	const fci_t *fci_context = (fci_t *)&__context;
+	pfe_rtable_entry_t *entries[FCI_ROUTES_CFG_DROP_BATCH_SIZE];
+	errno_t results[FCI_ROUTES_CFG_DROP_BATCH_SIZE];
 	pfe_rtable_entry_t *entry;
-	errno_t ret;
+	uint32_t ii, count, dropped;
 
 #if defined(PFE_CFG_NULL_ARG_CHECK)
 	if (unlikely((NULL == route)))
@@ -61,20 +66,45 @@ static void fci_routes_remove_related_connections(fci_rt_db_entry_t *route)
 	else
 #endif /* PFE_CFG_NULL_ARG_CHECK */
 	{
-		entry = pfe_rtable_get_first(fci_context->rtable, RTABLE_CRIT_BY_ROUTE_ID, &route->id);
-		while (NULL != entry)
+		do
 		{
-			ret = pfe_rtable_del_entry(fci_context->rtable, entry);
-			if (EOK != ret)
+			/*	Collect a batch. The walk is started over for every batch since the
+				removal reorganizes the table under the walk position. */
+			count = 0U;
+			entry = pfe_rtable_get_first(fci_context->rtable, RTABLE_CRIT_BY_ROUTE_ID, &route->id);
+			while ((NULL != entry) && (count < FCI_ROUTES_CFG_DROP_BATCH_SIZE))
 			{
-				NXP_LOG_WARNING("Couldn't properly drop a connection: %d\n", ret);
+				entries[count] = entry;
+				count++;
+
+				if (count < FCI_ROUTES_CFG_DROP_BATCH_SIZE)
+				{
+					entry = pfe_rtable_get_next(fci_context->rtable);
+				}
 			}
 
-			/*	Release the entry */
-			pfe_rtable_entry_free(fci_context->rtable, entry);
+			dropped = 0U;
+			if (0U != count)
+			{
+				(void)pfe_rtable_del_entries(fci_context->rtable, entries, count, results);
+				for (ii = 0U; ii < count; ii++)
+				{
+					if (EOK != results[ii])
+					{
+						NXP_LOG_WARNING("Couldn't properly drop a connection: %d\n", results[ii]);
+					}
+					else
+					{
+						dropped++;
+					}
 
-			entry = pfe_rtable_get_next(fci_context->rtable);
-		}
+					/*	Release the entry */
+					pfe_rtable_entry_free(fci_context->rtable, entries[ii]);
+				}
+			}
+
+			/*	Stop if nothing could be removed, the entries left would be collected again */
+		} while ((FCI_ROUTES_CFG_DROP_BATCH_SIZE == count) && (0U != dropped));
 	}
 }
 
@@ -94,6 +124,7 @@ errno_t fci_routes_cmd(fci_msg_t *msg, uint16_t *fci_ret, fpp_rt_cmd_t *reply_bu
 	fpp_rt_cmd_t *rt_cmd;
 	bool_t is_ipv6 = FALSE;
 	errno_t ret = EOK;
+	errno_t unlock_ret;
 	pfe_mac_addr_t src_mac;
 	pfe_mac_addr_t dst_mac;
 	pfe_ip_addr_t ip;
@@ -252,9 +283,76 @@ errno_t fci_routes_cmd(fci_msg_t *msg, uint16_t *fci_ret, fpp_rt_cmd_t *reply_bu
 
 				case FPP_ACTION_UPDATE:
 				{
-					/*	Not supported yet */
-					NXP_LOG_WARNING("FPP_CMD_IP_ROUTE: FPP_ACTION_UPDATE not supported (yet)\n");
-					*fci_ret = FPP_ERR_UNKNOWN_COMMAND;
+					/*	Validate the route */
+					rt_entry = fci_rt_db_get_first(&fci_context->route_db, RT_DB_CRIT_BY_ID, (void *)&rt_cmd->id);
+					if (NULL == rt_entry)
+					{
+						NXP_LOG_WARNING("FPP_CMD_IP_ROUTE: Requested route %d not found\n", (int_t)oal_ntohl(rt_cmd->id));
+						*fci_ret = FPP_ERR_RT_ENTRY_NOT_FOUND;
+						break;
+					}
+
+					ret = pfe_if_db_lock(&session_id);
+					if (EOK == ret)
+					{
+						/*	Validate the interface */
+						ret = pfe_if_db_get_first(fci_context->phy_if_db, session_id, IF_DB_CRIT_BY_NAME, (void *)rt_cmd->output_device, &if_entry);
+						if(EOK != ret)
+						{
+							NXP_LOG_WARNING("FPP_CMD_IP_ROUTE: DB is locked in different session, entry was not retrieved from DB\n");
+						}
+					}
+					else
+					{
+						NXP_LOG_ERROR("FPP_CMD_IP_ROUTE: DB lock failed\n");
+					}
+
+					if (NULL == if_entry)
+					{
+						/*	No such interface */
+						NXP_LOG_WARNING("FPP_CMD_IP_ROUTE: Interface %s not found\n", rt_cmd->output_device);
+						*fci_ret = FPP_ERR_WRONG_COMMAND_PARAM;
+						break;
+					}
+
+					phy_if = pfe_if_db_entry_get_phy_if(if_entry);
+
+					/*	Prepare MAC source address */
+					{
+						const pfe_mac_addr_t zero_mac = {0u};
+						(void)memset(src_mac, 0, sizeof(pfe_mac_addr_t));
+						if (0 == memcmp(rt_cmd->src_mac, zero_mac, sizeof(pfe_mac_addr_t)))
+						{
+							if(EOK != pfe_phy_if_get_mac_addr_first(phy_if, src_mac, MAC_DB_CRIT_ALL, PFE_TYPE_ANY, PFE_CFG_LOCAL_IF))
+							{
+								NXP_LOG_ERROR("FPP_CMD_IP_ROUTE: Get the first MAC address from mac addr db failed\n");
+							}
+						}
+						else
+						{
+							(void)memcpy(src_mac, rt_cmd->src_mac, sizeof(pfe_mac_addr_t));
+						}
+					}
+
+					/*	Re-point all connections using the route */
+					ret = pfe_rtable_update_route(fci_context->rtable, rt_entry->id, phy_if, src_mac, dst_mac, NULL);
+					if (EOK != ret)
+					{
+						NXP_LOG_ERROR("FPP_CMD_IP_ROUTE: Can't update route connections: %d\n", ret);
+						*fci_ret = FPP_ERR_WRONG_COMMAND_PARAM;
+						break;
+					}
+					else
+					{
+						/*	Keep the route DB in line with the routing table */
+						rt_entry->iface = phy_if;
+						(void)memcpy(rt_entry->src_mac, src_mac, sizeof(pfe_mac_addr_t));
+						(void)memcpy(rt_entry->dst_mac, dst_mac, sizeof(pfe_mac_addr_t));
+
+						NXP_LOG_DEBUG("FPP_CMD_IP_ROUTE: Route (ID: %d, IF: %s) updated\n", (int_t)oal_ntohl(rt_cmd->id), rt_cmd->output_device);
+						*fci_ret = FPP_ERR_OK;
+					}
+
 					break;
 				}
 
@@ -322,13 +420,19 @@ errno_t fci_routes_cmd(fci_msg_t *msg, uint16_t *fci_ret, fpp_rt_cmd_t *reply_bu
 			}
 
 			/* Unlock interfaces for required actions */
-			if(FPP_ACTION_REGISTER == rt_cmd->action)
+			if((FPP_ACTION_REGISTER == rt_cmd->action) || ((FPP_ACTION_UPDATE == rt_cmd->action) && (0U != session_id)))
 			{
-				ret = pfe_if_db_unlock(session_id);
-				if(EOK != ret)
+				unlock_ret = pfe_if_db_unlock(session_id);
+				if(EOK != unlock_ret)
 				{
 					NXP_LOG_ERROR("FPP_CMD_IP_ROUTE: DB unlock failed\n");
 				}
+
+				/*	Report the first error */
+				if (EOK == ret)
+				{
+					ret = unlock_ret;
+				}
 			}
 		}
 	}
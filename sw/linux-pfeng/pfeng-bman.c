@@ -15,6 +15,9 @@
 #define PFE_RXB_DMA_SIZE	(SKB_WITH_OVERHEAD(PFE_RXB_TRUESIZE) - PFE_RXB_PAD)
 
 #define PFENG_BMAN_REFILL_THR	32
+/* Pages kept aside per channel for atomic allocation failures */
+#define PFENG_BMAN_RX_RESERVE	32
+#define PFENG_BMAN_REFILL_DELAY	msecs_to_jiffies(10)
 
 /* sanity check: we need RX buffering internal support disabled */
 #if (TRUE == PFE_HIF_CHNL_CFG_RX_BUFFERS_ENABLED)
@@ -30,6 +33,7 @@ struct pfeng_rx_map {
 struct pfeng_rx_chnl_pool {
 	struct device			*dev;
 	pfe_hif_chnl_t			*ll_chnl;
+	struct pfeng_hif_chnl		*chnl;
 	struct sk_buff			*skb;
 	u32				id;
 	u32				depth;
@@ -40,6 +44,17 @@ struct pfeng_rx_chnl_pool {
 	u32				wr_idx;
 	u32				alloc_idx;
 	u32				idx_mask;
+
+	/* ring slots left empty by the last refill */
+	u32				deficit;
+
+	/* emergency pages, restocked by the refill work */
+	spinlock_t			reserve_lock;
+	struct page			*reserve[PFENG_BMAN_RX_RESERVE];
+	u32				reserve_cnt;
+	struct delayed_work		refill_work;
+
+	struct pfeng_bman_rx_stats	stats;
 };
 
 struct pfeng_tx_map {
@@ -59,6 +74,79 @@ struct pfeng_tx_chnl_pool {
 	struct pfeng_tx_map		*tx_tbl;
 };
 
+static struct page *pfeng_bman_reserve_get(struct pfeng_rx_chnl_pool *pool)
+{
+	struct page *page = NULL;
+
+	spin_lock_bh(&pool->reserve_lock);
+	if (pool->reserve_cnt)
+		page = pool->reserve[--pool->reserve_cnt];
+	spin_unlock_bh(&pool->reserve_lock);
+
+	return page;
+}
+
+/* Returns true if the reserve is full */
+static bool pfeng_bman_reserve_restock(struct pfeng_rx_chnl_pool *pool, gfp_t gfp)
+{
+	struct page *page;
+	bool full;
+
+	while (true) {
+		spin_lock_bh(&pool->reserve_lock);
+		full = pool->reserve_cnt == PFENG_BMAN_RX_RESERVE;
+		spin_unlock_bh(&pool->reserve_lock);
+		if (full)
+			return true;
+
+		page = __dev_alloc_page(gfp | GFP_DMA32 | __GFP_NOWARN);
+		if (!page)
+			return false;
+
+		spin_lock_bh(&pool->reserve_lock);
+		if (pool->reserve_cnt < PFENG_BMAN_RX_RESERVE) {
+			pool->reserve[pool->reserve_cnt++] = page;
+			page = NULL;
+		}
+		spin_unlock_bh(&pool->reserve_lock);
+
+		if (page) {
+			__free_page(page);
+			return true;
+		}
+	}
+}
+
+static void pfeng_bman_reserve_free(struct pfeng_rx_chnl_pool *pool)
+{
+	while (pool->reserve_cnt)
+		__free_page(pool->reserve[--pool->reserve_cnt]);
+}
+
+/*
+ * Runs whenever the RX path could not get a page. Restocks the reserve by a
+ * sleeping allocation and kicks NAPI to top up the ring from it, since a
+ * drained ring raises no more RX interrupts.
+ */
+static void pfeng_bman_refill_work(struct work_struct *work)
+{
+	struct pfeng_rx_chnl_pool *pool = container_of(to_delayed_work(work), struct pfeng_rx_chnl_pool, refill_work);
+	bool restocked;
+
+	restocked = pfeng_bman_reserve_restock(pool, GFP_KERNEL);
+	pool->stats.deferred_refill++;
+
+	/* NAPI raises the RX softirq, process context needs BHs off for it to run */
+	if (pool->chnl->status >= PFENG_HIF_STATUS_ENABLED) {
+		local_bh_disable();
+		napi_schedule(&pool->chnl->napi);
+		local_bh_enable();
+	}
+
+	if (!restocked)
+		schedule_delayed_work(&pool->refill_work, PFENG_BMAN_REFILL_DELAY);
+}
+
 int pfeng_bman_pool_create(struct pfeng_hif_chnl *chnl)
 {
 	struct pfeng_rx_chnl_pool *rx_pool;
@@ -73,10 +161,19 @@ int pfeng_bman_pool_create(struct pfeng_hif_chnl *chnl)
 
 	chnl->bman.rx_pool = rx_pool;
 	rx_pool->ll_chnl = chnl->priv;
+	rx_pool->chnl = chnl;
 	rx_pool->dev = chnl->dev;
 	rx_pool->id = pfe_hif_chnl_get_id(chnl->priv);
 	rx_pool->depth = PFE_CFG_HIF_RING_LENGTH;
 	rx_pool->idx_mask = PFE_CFG_HIF_RING_LENGTH - 1;
+	spin_lock_init(&rx_pool->reserve_lock);
+	INIT_DELAYED_WORK(&rx_pool->refill_work, pfeng_bman_refill_work);
+
+	/* Not fatal, the refill work keeps trying */
+	if (!pfeng_bman_reserve_restock(rx_pool, GFP_KERNEL)) {
+		HM_MSG_DEV_WARN(chnl->dev, "chnl%d: RX page reserve not complete\n", rx_pool->id);
+		schedule_delayed_work(&rx_pool->refill_work, PFENG_BMAN_REFILL_DELAY);
+	}
 
 	rx_pool->rx_tbl = kcalloc(rx_pool->depth, sizeof(struct pfeng_rx_map), GFP_KERNEL);
 	if (!rx_pool->rx_tbl) {
@@ -273,8 +370,16 @@ static bool pfeng_bman_buf_alloc_and_map(struct pfeng_rx_chnl_pool *pool, struct
 
 	/* Request page from DMA safe region */
 	page = __dev_alloc_page(GFP_DMA32 | GFP_ATOMIC | __GFP_NOWARN);
-	if (unlikely(!page))
-		return false;
+	if (unlikely(!page)) {
+		/* Fall back to the reserve and let the work restock it */
+		page = pfeng_bman_reserve_get(pool);
+		schedule_delayed_work(&pool->refill_work, 0);
+		if (!page) {
+			pool->stats.alloc_fail++;
+			return false;
+		}
+		pool->stats.reserve_used++;
+	}
 
 	/* do dma map */
 	dma = dma_map_page(pool->dev, page, 0, PAGE_SIZE, DMA_FROM_DEVICE);
@@ -318,7 +423,8 @@ static int pfeng_hif_chnl_refill_rx_buffer(struct pfeng_rx_chnl_pool *pool, stru
 	/*	Ask for new buffer */
 	if (unlikely(!rx_map->page))
 		if (unlikely(!pfeng_bman_buf_alloc_and_map(pool, rx_map))) {
-			HM_MSG_DEV_ERR(pool->dev, "buffer allocation error\n");
+			if (net_ratelimit())
+				HM_MSG_DEV_ERR(pool->dev, "buffer allocation error\n");
 			return -ENOMEM;
 		}
 
@@ -346,6 +452,11 @@ static int pfeng_hif_chnl_refill_rx_pool(struct pfeng_rx_chnl_pool *pool, int co
 
 	pool->alloc_idx = pool->wr_idx;
 
+	/* Missing buffers are supplied on the next poll, or by the refill work */
+	pool->deficit = count - i;
+	if (unlikely(pool->deficit) && pfeng_bman_rx_chnl_pool_unused(pool) == pool->depth - 1)
+		pool->stats.ring_starved++;
+
 	return ret;
 }
 
@@ -419,6 +530,7 @@ static struct sk_buff *pfeng_rx_map_buff_to_skb(struct pfeng_rx_chnl_pool *pool,
 		 * the BD ring, in which case the HW will stop receiving frames.*/
 		dma_unmap_page(pool->dev, rx_map->dma, PAGE_SIZE, DMA_FROM_DEVICE);
 		__free_page(rx_map->page);
+		pool->stats.alloc_fail++;
 
 		memset(rx_map, 0, sizeof(*rx_map));
 		/* pull rx map */
@@ -463,7 +575,9 @@ struct sk_buff *pfeng_hif_chnl_receive_pkt(struct pfeng_hif_chnl *chnl)
 	void *buf_pa;
 	u32 rx_len;
 
-	if (unlikely(pfeng_bman_rx_chnl_pool_unused(pool) >= PFENG_BMAN_REFILL_THR))
+	if (unlikely(pool->deficit))
+		pfeng_hif_chnl_refill_rx_pool(pool, min_t(int, pfeng_bman_rx_chnl_pool_unused(pool), PFENG_BMAN_REFILL_THR));
+	else if (unlikely(pfeng_bman_rx_chnl_pool_unused(pool) >= PFENG_BMAN_REFILL_THR))
 		pfeng_hif_chnl_refill_rx_pool(pool, PFENG_BMAN_REFILL_THR);
 
 	while (!lifm) {
@@ -512,12 +626,28 @@ int pfeng_hif_chnl_fill_rx_buffers(struct pfeng_hif_chnl *chnl)
 	return cnt;
 }
 
+void pfeng_bman_rx_stats_add(struct pfeng_hif_chnl *chnl, struct pfeng_bman_rx_stats *stats)
+{
+	struct pfeng_rx_chnl_pool *pool = chnl->bman.rx_pool;
+
+	if (!pool)
+		return;
+
+	stats->alloc_fail += READ_ONCE(pool->stats.alloc_fail);
+	stats->reserve_used += READ_ONCE(pool->stats.reserve_used);
+	stats->deferred_refill += READ_ONCE(pool->stats.deferred_refill);
+	stats->ring_starved += READ_ONCE(pool->stats.ring_starved);
+}
+
 void pfeng_bman_pool_destroy(struct pfeng_hif_chnl *chnl)
 {
 	struct pfeng_rx_chnl_pool *rx_pool = (struct pfeng_rx_chnl_pool *)chnl->bman.rx_pool;
 	struct pfeng_tx_chnl_pool *tx_pool = (struct pfeng_tx_chnl_pool *)chnl->bman.tx_pool;
 
 	if (rx_pool) {
+		cancel_delayed_work_sync(&rx_pool->refill_work);
+		pfeng_bman_reserve_free(rx_pool);
+
 		if(rx_pool->rx_tbl) {
 			pfeng_bman_free_rx_buffers(rx_pool);
 			kfree(rx_pool->rx_tbl);
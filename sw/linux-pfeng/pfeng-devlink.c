@@ -0,0 +1,973 @@
+/*
+ * Copyright 2023 NXP
+ *
+ * SPDX-License-Identifier: GPL-2.0
+ *
+ */
+
+#include <linux/version.h>
+#include <linux/clk.h>
+#include <linux/kfifo.h>
+#include <linux/spinlock.h>
+#include <linux/workqueue.h>
+#include <net/devlink.h>
+
+#include "pfe_cfg.h"
+#include "oal.h"
+#include "pfe_platform.h"
+#include "pfe_hm.h"
+#include "pfe_fp.h"
+#include "pfe_bmu.h"
+#include "pfe_tmu.h"
+#include "pfe_l2br_table.h"
+#include "pfeng.h"
+
+#if IS_ENABLED(CONFIG_NET_DEVLINK) && (LINUX_VERSION_CODE >= KERNEL_VERSION(5,15,0))
+
+/* Since 6.3 the instance lock is held while the reload callbacks run */
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6,3,0)
+#define pfeng_devl_driverinit_value_get(dl, id, val)	devl_param_driverinit_value_get(dl, id, val)
+#define pfeng_devl_driverinit_value_set(dl, id, val)	devl_param_driverinit_value_set(dl, id, val)
+#else
+#define pfeng_devl_driverinit_value_get(dl, id, val)	devlink_param_driverinit_value_get(dl, id, val)
+#define pfeng_devl_driverinit_value_set(dl, id, val)	devlink_param_driverinit_value_set(dl, id, val)
+#endif
+
+#define PFENG_DEVLINK_HM_FIFO_LEN	16
+#define PFENG_DEVLINK_HR_HISTORY	8
+/* Minimal period between two auto-recoveries of one reporter */
+#define PFENG_DEVLINK_HR_GRACE_MS	60000
+
+enum pfeng_devlink_hr_id {
+	PFENG_DEVLINK_HR_ECC,
+	PFENG_DEVLINK_HR_PARITY,
+	PFENG_DEVLINK_HR_WDT,
+	PFENG_DEVLINK_HR_BUS,
+	PFENG_DEVLINK_HR_BMU,
+	PFENG_DEVLINK_HR_CNT
+};
+
+static const char * const pfeng_devlink_hr_names[PFENG_DEVLINK_HR_CNT] = {
+	[PFENG_DEVLINK_HR_ECC] = "ecc",
+	[PFENG_DEVLINK_HR_PARITY] = "parity",
+	[PFENG_DEVLINK_HR_WDT] = "watchdog",
+	[PFENG_DEVLINK_HR_BUS] = "bus",
+	[PFENG_DEVLINK_HR_BMU] = "bmu",
+};
+
+enum pfeng_devlink_param_id {
+	PFENG_DEVLINK_PARAM_ID_BASE = DEVLINK_PARAM_GENERIC_ID_MAX,
+	PFENG_DEVLINK_PARAM_ID_HIF_RING_LEN,
+	PFENG_DEVLINK_PARAM_ID_BMU2_BUF_CNT,
+	PFENG_DEVLINK_PARAM_ID_RX_COALESCE_USECS,
+	PFENG_DEVLINK_PARAM_ID_RTABLE_HASH_SIZE,
+	PFENG_DEVLINK_PARAM_ID_RTABLE_COLL_SIZE,
+};
+
+enum pfeng_devlink_resource_id {
+	PFENG_DEVLINK_RES_ID_RTABLE = 1,
+	PFENG_DEVLINK_RES_ID_L2_MAC,
+	PFENG_DEVLINK_RES_ID_FP,
+	PFENG_DEVLINK_RES_ID_TMU,
+	PFENG_DEVLINK_RES_ID_BMU2,
+};
+
+/* TMU physical interfaces with queues */
+static const pfe_ct_phy_if_id_t pfeng_devlink_tmu_phys[] = {
+	PFE_PHY_IF_ID_EMAC0, PFE_PHY_IF_ID_EMAC1, PFE_PHY_IF_ID_EMAC2,
+	PFE_PHY_IF_ID_HIF, PFE_PHY_IF_ID_HIF_NOCPY, PFE_PHY_IF_ID_UTIL
+};
+
+struct pfeng_devlink_event {
+	pfe_hm_src_t			src;
+	pfe_hm_evt_t			id;
+	pfe_hm_type_t			type;
+	unsigned long			stamp;
+};
+
+struct pfeng_devlink;
+
+struct pfeng_devlink_hr {
+	struct pfeng_devlink		*dl;
+	struct devlink_health_reporter	*reporter;
+	struct pfeng_devlink_event	history[PFENG_DEVLINK_HR_HISTORY];
+	u32				events;
+};
+
+/* devlink private data */
+struct pfeng_devlink {
+	struct pfeng_priv		*priv;
+	struct pfeng_devlink_hr		hr[PFENG_DEVLINK_HR_CNT];
+	/* HM events may come in atomic context, reporting is deferred */
+	spinlock_t			hm_lock;
+	DECLARE_KFIFO(hm_fifo, struct pfeng_devlink_event, PFENG_DEVLINK_HM_FIFO_LEN);
+	struct work_struct		hm_work;
+};
+
+/* HM callback carries no context, the PFE platform is a singleton anyway */
+static struct pfeng_devlink *pfeng_devlink_hm_ctx;
+
+static struct pfeng_priv *pfeng_devlink_to_priv(struct devlink *devlink)
+{
+	struct pfeng_devlink *dl = devlink_priv(devlink);
+
+	return dl->priv;
+}
+
+static const char *pfeng_devlink_evt_str(pfe_hm_evt_t id)
+{
+#ifdef PFE_CFG_HM_STRINGS_ENABLED
+	return pfe_hm_get_event_str(id);
+#else
+	return "PFE error";
+#endif /* PFE_CFG_HM_STRINGS_ENABLED */
+}
+
+static int pfeng_devlink_hm_to_hr(pfe_hm_src_t src, pfe_hm_evt_t id)
+{
+	switch (src) {
+	case HM_SRC_ECC:
+		return PFENG_DEVLINK_HR_ECC;
+	case HM_SRC_PARITY:
+		return PFENG_DEVLINK_HR_PARITY;
+	case HM_SRC_WDT:
+		return PFENG_DEVLINK_HR_WDT;
+	case HM_SRC_BUS:
+		return PFENG_DEVLINK_HR_BUS;
+	case HM_SRC_BMU:
+		return PFENG_DEVLINK_HR_BMU;
+	case HM_SRC_EMAC0:
+	case HM_SRC_EMAC1:
+	case HM_SRC_EMAC2:
+		if (id >= HM_EVT_EMAC_ECC_TX_FIFO_CORRECTABLE && id <= HM_EVT_EMAC_ECC_RX_FIFO_ADDRESS)
+			return PFENG_DEVLINK_HR_ECC;
+		if (id >= HM_EVT_EMAC_APP_TX_PARITY && id <= HM_EVT_EMAC_FSM_PARITY)
+			return PFENG_DEVLINK_HR_PARITY;
+		break;
+	case HM_SRC_FAIL_STOP:
+		switch (id) {
+		case HM_EVT_FAIL_STOP_ECC_MULTIBIT:
+			return PFENG_DEVLINK_HR_ECC;
+		case HM_EVT_FAIL_STOP_PARITY:
+			return PFENG_DEVLINK_HR_PARITY;
+		case HM_EVT_FAIL_STOP_WATCHDOG:
+			return PFENG_DEVLINK_HR_WDT;
+		case HM_EVT_FAIL_STOP_BUS:
+			return PFENG_DEVLINK_HR_BUS;
+		default:
+			break;
+		}
+		break;
+	default:
+		break;
+	}
+
+	return -1;
+}
+
+static void pfeng_devlink_hm_cb(pfe_hm_item_t *item)
+{
+	struct pfeng_devlink *dl = READ_ONCE(pfeng_devlink_hm_ctx);
+	struct pfeng_devlink_event evt;
+	unsigned long flags;
+
+	if (!dl || pfeng_devlink_hm_to_hr(item->src, item->id) < 0)
+		return;
+
+	evt.src = item->src;
+	evt.id = item->id;
+	evt.type = item->type;
+	evt.stamp = jiffies;
+
+	spin_lock_irqsave(&dl->hm_lock, flags);
+	/* Event is dropped if the reporting lags behind */
+	kfifo_put(&dl->hm_fifo, evt);
+	spin_unlock_irqrestore(&dl->hm_lock, flags);
+
+	schedule_work(&dl->hm_work);
+}
+
+static void pfeng_devlink_hm_work(struct work_struct *work)
+{
+	struct pfeng_devlink *dl = container_of(work, struct pfeng_devlink, hm_work);
+	struct pfeng_devlink_event evt;
+	struct pfeng_devlink_hr *hr;
+	unsigned long flags;
+	bool found;
+
+	while (true) {
+		spin_lock_irqsave(&dl->hm_lock, flags);
+		found = kfifo_get(&dl->hm_fifo, &evt);
+		if (found) {
+			hr = &dl->hr[pfeng_devlink_hm_to_hr(evt.src, evt.id)];
+			hr->history[hr->events % PFENG_DEVLINK_HR_HISTORY] = evt;
+			hr->events++;
+		}
+		spin_unlock_irqrestore(&dl->hm_lock, flags);
+
+		if (!found)
+			break;
+
+		/* Only errors and pool depletion are reported, the rest is kept in the history */
+		if ((evt.type == HM_ERROR || evt.id == HM_EVT_BMU_LOW_WATERMARK) && hr->reporter)
+			devlink_health_report(hr->reporter, pfeng_devlink_evt_str(evt.id), &evt);
+	}
+}
+
+static void pfeng_devlink_fmsg_event(struct devlink_fmsg *fmsg, const struct pfeng_devlink_event *evt)
+{
+	devlink_fmsg_obj_nest_start(fmsg);
+	devlink_fmsg_u32_pair_put(fmsg, "id", evt->id);
+	devlink_fmsg_u32_pair_put(fmsg, "src", evt->src);
+	devlink_fmsg_string_pair_put(fmsg, "type", evt->type == HM_ERROR ? "error" :
+				     evt->type == HM_WARNING ? "warning" : "info");
+	devlink_fmsg_string_pair_put(fmsg, "desc", pfeng_devlink_evt_str(evt->id));
+	devlink_fmsg_u32_pair_put(fmsg, "age_ms", jiffies_to_msecs(jiffies - evt->stamp));
+	devlink_fmsg_obj_nest_end(fmsg);
+}
+
+static int pfeng_devlink_hr_dump(struct devlink_health_reporter *reporter,
+				 struct devlink_fmsg *fmsg, void *priv_ctx,
+				 struct netlink_ext_ack *extack)
+{
+	struct pfeng_devlink_hr *hr = devlink_health_reporter_priv(reporter);
+	struct pfeng_devlink_event history[PFENG_DEVLINK_HR_HISTORY];
+	struct pfeng_devlink_event *evt = priv_ctx;
+	unsigned long flags;
+	u32 events, cnt, i;
+
+	spin_lock_irqsave(&hr->dl->hm_lock, flags);
+	memcpy(history, hr->history, sizeof(history));
+	events = hr->events;
+	spin_unlock_irqrestore(&hr->dl->hm_lock, flags);
+
+	if (evt) {
+		devlink_fmsg_pair_nest_start(fmsg, "event");
+		pfeng_devlink_fmsg_event(fmsg, evt);
+		devlink_fmsg_pair_nest_end(fmsg);
+	}
+
+	devlink_fmsg_u32_pair_put(fmsg, "events", events);
+
+	/* newest first */
+	cnt = min_t(u32, events, PFENG_DEVLINK_HR_HISTORY);
+	devlink_fmsg_arr_pair_nest_start(fmsg, "history");
+	for (i = 1; i <= cnt; i++)
+		pfeng_devlink_fmsg_event(fmsg, &history[(events - i) % PFENG_DEVLINK_HR_HISTORY]);
+	devlink_fmsg_arr_pair_nest_end(fmsg);
+
+	return 0;
+}
+
+static int pfeng_devlink_hr_recover(struct devlink_health_reporter *reporter,
+				    void *priv_ctx, struct netlink_ext_ack *extack)
+{
+	struct pfeng_devlink_hr *hr = devlink_health_reporter_priv(reporter);
+	struct pfeng_priv *priv = hr->dl->priv;
+	int ret;
+
+	HM_MSG_DEV_WARN(&priv->pdev->dev, "Restarting PFE on %s error\n", pfeng_devlink_hr_names[hr - hr->dl->hr]);
+
+	ret = pfeng_drv_pfe_restart(priv);
+	if (ret)
+		NL_SET_ERR_MSG_MOD(extack, "PFE restart failed");
+
+	return ret;
+}
+
+#define PFENG_DEVLINK_HR_OPS(_name)						\
+static const struct devlink_health_reporter_ops pfeng_devlink_hr_ops_##_name = {	\
+	.name = #_name,								\
+	.dump = pfeng_devlink_hr_dump,						\
+	.recover = pfeng_devlink_hr_recover,					\
+}
+
+PFENG_DEVLINK_HR_OPS(ecc);
+PFENG_DEVLINK_HR_OPS(parity);
+PFENG_DEVLINK_HR_OPS(watchdog);
+PFENG_DEVLINK_HR_OPS(bus);
+
+static int pfeng_devlink_hr_bmu_dump(struct devlink_health_reporter *reporter,
+				     struct devlink_fmsg *fmsg, void *priv_ctx,
+				     struct netlink_ext_ack *extack)
+{
+	struct pfeng_devlink_hr *hr = devlink_health_reporter_priv(reporter);
+	pfe_platform_t *platform = hr->dl->priv->pfe_platform;
+	pfe_bmu_occupancy_t occ;
+	u32 cnt, i;
+
+	pfeng_devlink_hr_dump(reporter, fmsg, priv_ctx, extack);
+
+	if (!platform || platform->bmu_count < 2 || !platform->bmu[1] ||
+	    pfe_bmu_get_occupancy(platform->bmu[1], &occ))
+		return 0;
+
+	devlink_fmsg_pair_nest_start(fmsg, "bmu2");
+	devlink_fmsg_obj_nest_start(fmsg);
+	devlink_fmsg_u32_pair_put(fmsg, "buffers", occ.buf_cnt);
+	devlink_fmsg_u32_pair_put(fmsg, "low_watermark", occ.low_wm);
+	devlink_fmsg_u32_pair_put(fmsg, "free_min", occ.free_min);
+	devlink_fmsg_u32_pair_put(fmsg, "used_max", occ.used_max);
+	devlink_fmsg_u32_pair_put(fmsg, "low_watermark_hits", occ.low_wm_cnt);
+	cnt = min_t(u32, occ.samples, PFE_BMU_OCC_HISTORY_LEN);
+	devlink_fmsg_arr_pair_nest_start(fmsg, "free");
+	for (i = 0; i < cnt; i++)
+		devlink_fmsg_u32_put(fmsg, occ.history[i].free_cnt);
+	devlink_fmsg_arr_pair_nest_end(fmsg);
+	devlink_fmsg_obj_nest_end(fmsg);
+	devlink_fmsg_pair_nest_end(fmsg);
+
+	return 0;
+}
+
+/* Pool depletion is not fixed by the restart, no recovery */
+static const struct devlink_health_reporter_ops pfeng_devlink_hr_ops_bmu = {
+	.name = "bmu",
+	.dump = pfeng_devlink_hr_bmu_dump,
+};
+
+static const struct devlink_health_reporter_ops *pfeng_devlink_hr_ops[PFENG_DEVLINK_HR_CNT] = {
+	[PFENG_DEVLINK_HR_ECC] = &pfeng_devlink_hr_ops_ecc,
+	[PFENG_DEVLINK_HR_PARITY] = &pfeng_devlink_hr_ops_parity,
+	[PFENG_DEVLINK_HR_WDT] = &pfeng_devlink_hr_ops_watchdog,
+	[PFENG_DEVLINK_HR_BUS] = &pfeng_devlink_hr_ops_bus,
+	[PFENG_DEVLINK_HR_BMU] = &pfeng_devlink_hr_ops_bmu,
+};
+
+static int pfeng_devlink_info_get(struct devlink *devlink, struct devlink_info_req *req,
+				  struct netlink_ext_ack *extack)
+{
+	struct pfeng_priv *priv = pfeng_devlink_to_priv(devlink);
+	pfe_ct_version_t fwver_class, fwver_util;
+	char buf[40];
+	int ret;
+
+#if LINUX_VERSION_CODE < KERNEL_VERSION(6,2,0)
+	ret = devlink_info_driver_name_put(req, PFENG_DRIVER_NAME);
+	if (ret)
+		return ret;
+#endif
+
+	ret = devlink_info_version_fixed_put(req, DEVLINK_INFO_VERSION_GENERIC_ASIC_ID,
+					     priv->on_g3 ? "s32g3" : "s32g2");
+	if (ret)
+		return ret;
+
+	ret = devlink_info_version_running_put(req, "driver", PFENG_DRIVER_VERSION);
+	if (ret)
+		return ret;
+
+	if (!priv->pfe_platform) {
+		NL_SET_ERR_MSG_MOD(extack, "PFE platform is not running");
+		return -ENODEV;
+	}
+
+	memset(&fwver_class, 0, sizeof(fwver_class));
+	memset(&fwver_util, 0, sizeof(fwver_util));
+	pfe_platform_get_fw_versions(priv->pfe_platform, &fwver_class,
+				     priv->pfe_cfg->enable_util ? &fwver_util : NULL);
+
+	scnprintf(buf, sizeof(buf), "%u.%u.%u", fwver_class.major, fwver_class.minor, fwver_class.patch);
+	ret = devlink_info_version_running_put(req, "fw.class", buf);
+	if (ret)
+		return ret;
+
+	scnprintf(buf, sizeof(buf), "%.32s", fwver_class.cthdr);
+	ret = devlink_info_version_running_put(req, "fw.class.api", buf);
+	if (ret)
+		return ret;
+
+	if (priv->pfe_cfg->enable_util) {
+		scnprintf(buf, sizeof(buf), "%u.%u.%u", fwver_util.major, fwver_util.minor, fwver_util.patch);
+		ret = devlink_info_version_running_put(req, "fw.util", buf);
+	}
+
+	return ret;
+}
+
+static void pfeng_devlink_params_apply(struct devlink *devlink)
+{
+	struct pfeng_priv *priv = pfeng_devlink_to_priv(devlink);
+	union devlink_param_value val;
+
+	if (!pfeng_devl_driverinit_value_get(devlink, PFENG_DEVLINK_PARAM_ID_RX_COALESCE_USECS, &val))
+		priv->rx_coalesce_usecs = val.vu32;
+	if (!pfeng_devl_driverinit_value_get(devlink, PFENG_DEVLINK_PARAM_ID_BMU2_BUF_CNT, &val))
+		priv->pfe_cfg->bmu2_buf_count = val.vu32;
+#if defined(PFE_CFG_RTABLE_ENABLE)
+	if (!pfeng_devl_driverinit_value_get(devlink, PFENG_DEVLINK_PARAM_ID_RTABLE_HASH_SIZE, &val))
+		priv->pfe_cfg->rtable_hash_size = val.vu32;
+	if (!pfeng_devl_driverinit_value_get(devlink, PFENG_DEVLINK_PARAM_ID_RTABLE_COLL_SIZE, &val))
+		priv->pfe_cfg->rtable_collision_size = val.vu32;
+#endif /* PFE_CFG_RTABLE_ENABLE */
+}
+
+static int pfeng_devlink_reload_down(struct devlink *devlink, bool netns_change,
+				     enum devlink_reload_action action,
+				     enum devlink_reload_limit limit,
+				     struct netlink_ext_ack *extack)
+{
+	struct pfeng_priv *priv = pfeng_devlink_to_priv(devlink);
+
+	if (netns_change) {
+		NL_SET_ERR_MSG_MOD(extack, "Namespace change is not supported");
+		return -EOPNOTSUPP;
+	}
+
+	return pfeng_drv_pfe_stop(priv);
+}
+
+static int pfeng_devlink_resources_register(struct pfeng_devlink *dl, struct devlink *devlink);
+static void pfeng_devlink_resources_unregister(struct devlink *devlink);
+
+static int pfeng_devlink_reload_up(struct devlink *devlink, enum devlink_reload_action action,
+				   enum devlink_reload_limit limit, u32 *actions_performed,
+				   struct netlink_ext_ack *extack)
+{
+	struct pfeng_devlink *dl = devlink_priv(devlink);
+	int ret;
+
+	*actions_performed = BIT(DEVLINK_RELOAD_ACTION_DRIVER_REINIT);
+
+	/* driverinit values take effect on the platform start */
+	pfeng_devlink_params_apply(devlink);
+
+	ret = pfeng_drv_pfe_start(dl->priv);
+	if (ret) {
+		NL_SET_ERR_MSG_MOD(extack, "PFE start failed");
+		return ret;
+	}
+
+	/* Table sizes may have changed */
+	pfeng_devlink_resources_unregister(devlink);
+	return pfeng_devlink_resources_register(dl, devlink);
+}
+
+static const struct devlink_ops pfeng_devlink_ops = {
+	.info_get = pfeng_devlink_info_get,
+	.reload_actions = BIT(DEVLINK_RELOAD_ACTION_DRIVER_REINIT),
+	.reload_down = pfeng_devlink_reload_down,
+	.reload_up = pfeng_devlink_reload_up,
+};
+
+static int pfeng_devlink_fixed_validate(u32 fixed, union devlink_param_value val,
+					struct netlink_ext_ack *extack)
+{
+	if (val.vu32 != fixed) {
+		NL_SET_ERR_MSG_MOD(extack, "Value is fixed by the build configuration");
+		return -EOPNOTSUPP;
+	}
+
+	return 0;
+}
+
+static int pfeng_devlink_ring_len_validate(struct devlink *devlink, u32 id,
+					   union devlink_param_value val,
+					   struct netlink_ext_ack *extack)
+{
+	return pfeng_devlink_fixed_validate(PFE_CFG_HIF_RING_LENGTH, val, extack);
+}
+
+static int pfeng_devlink_bmu2_validate(struct devlink *devlink, u32 id,
+				       union devlink_param_value val,
+				       struct netlink_ext_ack *extack)
+{
+	if (!is_power_of_2(val.vu32) || val.vu32 < PFENG_BMU2_BUF_CNT_MIN || val.vu32 > PFENG_BMU2_BUF_CNT_MAX) {
+		NL_SET_ERR_MSG_MOD(extack, "Buffer count has to be a power of 2 within the BMU limits");
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+static int pfeng_devlink_coalesce_validate(struct devlink *devlink, u32 id,
+					   union devlink_param_value val,
+					   struct netlink_ext_ack *extack)
+{
+	struct pfeng_priv *priv = pfeng_devlink_to_priv(devlink);
+	u64 cycles = (u64)val.vu32 * DIV_ROUND_UP(clk_get_rate(priv->clk_sys), USEC_PER_SEC);
+
+	/* The interrupt timer counts sys clock cycles in 32 bits */
+	if (!val.vu32 || cycles > U32_MAX) {
+		NL_SET_ERR_MSG_MOD(extack, "Value out of range");
+		return -ERANGE;
+	}
+
+	return 0;
+}
+
+#if defined(PFE_CFG_RTABLE_ENABLE)
+static int pfeng_devlink_rtable_validate(struct devlink *devlink, u32 id,
+					 union devlink_param_value val,
+					 struct netlink_ext_ack *extack)
+{
+	if (id == PFENG_DEVLINK_PARAM_ID_RTABLE_HASH_SIZE &&
+	    (!is_power_of_2(val.vu32) || val.vu32 > PFE_CFG_RT_HASH_ENTRIES_MAX_CNT)) {
+		NL_SET_ERR_MSG_MOD(extack, "Hash size has to be a power of 2 within the h/w limit");
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6,17,0)
+static int pfeng_devlink_rtable_get(struct devlink *devlink, u32 id,
+				    struct devlink_param_gset_ctx *ctx,
+				    struct netlink_ext_ack *extack)
+#else
+static int pfeng_devlink_rtable_get(struct devlink *devlink, u32 id,
+				    struct devlink_param_gset_ctx *ctx)
+#endif
+{
+	struct pfeng_priv *priv = pfeng_devlink_to_priv(devlink);
+
+	if (id == PFENG_DEVLINK_PARAM_ID_RTABLE_HASH_SIZE)
+		ctx->val.vu32 = priv->pfe_cfg->rtable_hash_size;
+	else
+		ctx->val.vu32 = priv->pfe_cfg->rtable_collision_size;
+
+	return 0;
+}
+
+/* Runtime change moves the routing table with all its entries, no reload needed */
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6,9,0)
+static int pfeng_devlink_rtable_set(struct devlink *devlink, u32 id,
+				    struct devlink_param_gset_ctx *ctx,
+				    struct netlink_ext_ack *extack)
+#else
+static int pfeng_devlink_rtable_set(struct devlink *devlink, u32 id,
+				    struct devlink_param_gset_ctx *ctx)
+#endif
+{
+	struct pfeng_priv *priv = pfeng_devlink_to_priv(devlink);
+	u32 hash_size = priv->pfe_cfg->rtable_hash_size;
+	u32 coll_size = priv->pfe_cfg->rtable_collision_size;
+	int ret;
+
+	if (!priv->pfe_platform || !priv->pfe_platform->rtable)
+		return -ENODEV;
+
+	if (id == PFENG_DEVLINK_PARAM_ID_RTABLE_HASH_SIZE)
+		hash_size = ctx->val.vu32;
+	else
+		coll_size = ctx->val.vu32;
+
+	ret = -pfe_platform_resize_rtable(priv->pfe_platform, hash_size, coll_size);
+	if (ret)
+		return ret;
+
+	priv->pfe_cfg->rtable_hash_size = hash_size;
+	priv->pfe_cfg->rtable_collision_size = coll_size;
+
+	/* Keep the new size across reload */
+	pfeng_devl_driverinit_value_set(devlink, id, ctx->val);
+
+	return 0;
+}
+#endif /* PFE_CFG_RTABLE_ENABLE */
+
+static const struct devlink_param pfeng_devlink_params[] = {
+	DEVLINK_PARAM_DRIVER(PFENG_DEVLINK_PARAM_ID_HIF_RING_LEN, "hif_ring_len",
+			     DEVLINK_PARAM_TYPE_U32, BIT(DEVLINK_PARAM_CMODE_DRIVERINIT),
+			     NULL, NULL, pfeng_devlink_ring_len_validate),
+	DEVLINK_PARAM_DRIVER(PFENG_DEVLINK_PARAM_ID_BMU2_BUF_CNT, "bmu2_buf_cnt",
+			     DEVLINK_PARAM_TYPE_U32, BIT(DEVLINK_PARAM_CMODE_DRIVERINIT),
+			     NULL, NULL, pfeng_devlink_bmu2_validate),
+	DEVLINK_PARAM_DRIVER(PFENG_DEVLINK_PARAM_ID_RX_COALESCE_USECS, "rx_coalesce_usecs",
+			     DEVLINK_PARAM_TYPE_U32, BIT(DEVLINK_PARAM_CMODE_DRIVERINIT),
+			     NULL, NULL, pfeng_devlink_coalesce_validate),
+#if defined(PFE_CFG_RTABLE_ENABLE)
+	DEVLINK_PARAM_DRIVER(PFENG_DEVLINK_PARAM_ID_RTABLE_HASH_SIZE, "rtable_hash_size",
+			     DEVLINK_PARAM_TYPE_U32,
+			     BIT(DEVLINK_PARAM_CMODE_DRIVERINIT) | BIT(DEVLINK_PARAM_CMODE_RUNTIME),
+			     pfeng_devlink_rtable_get, pfeng_devlink_rtable_set,
+			     pfeng_devlink_rtable_validate),
+	DEVLINK_PARAM_DRIVER(PFENG_DEVLINK_PARAM_ID_RTABLE_COLL_SIZE, "rtable_collision_size",
+			     DEVLINK_PARAM_TYPE_U32,
+			     BIT(DEVLINK_PARAM_CMODE_DRIVERINIT) | BIT(DEVLINK_PARAM_CMODE_RUNTIME),
+			     pfeng_devlink_rtable_get, pfeng_devlink_rtable_set,
+			     pfeng_devlink_rtable_validate),
+#endif /* PFE_CFG_RTABLE_ENABLE */
+};
+
+static void pfeng_devlink_params_init(struct pfeng_devlink *dl, struct devlink *devlink)
+{
+	union devlink_param_value val;
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6,3,0)
+	devl_lock(devlink);
+#endif
+	val.vu32 = PFE_CFG_HIF_RING_LENGTH;
+	pfeng_devl_driverinit_value_set(devlink, PFENG_DEVLINK_PARAM_ID_HIF_RING_LEN, val);
+	val.vu32 = dl->priv->pfe_cfg->bmu2_buf_count;
+	pfeng_devl_driverinit_value_set(devlink, PFENG_DEVLINK_PARAM_ID_BMU2_BUF_CNT, val);
+	val.vu32 = dl->priv->rx_coalesce_usecs;
+	pfeng_devl_driverinit_value_set(devlink, PFENG_DEVLINK_PARAM_ID_RX_COALESCE_USECS, val);
+#if defined(PFE_CFG_RTABLE_ENABLE)
+	val.vu32 = dl->priv->pfe_cfg->rtable_hash_size;
+	pfeng_devl_driverinit_value_set(devlink, PFENG_DEVLINK_PARAM_ID_RTABLE_HASH_SIZE, val);
+	val.vu32 = dl->priv->pfe_cfg->rtable_collision_size;
+	pfeng_devl_driverinit_value_set(devlink, PFENG_DEVLINK_PARAM_ID_RTABLE_COLL_SIZE, val);
+#endif /* PFE_CFG_RTABLE_ENABLE */
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6,3,0)
+	devl_unlock(devlink);
+#endif
+}
+
+#if defined(PFE_CFG_RTABLE_ENABLE)
+static u64 pfeng_devlink_rtable_occ_get(void *arg)
+{
+	struct pfeng_devlink *dl = arg;
+
+	if (!dl->priv->pfe_platform || !dl->priv->pfe_platform->rtable)
+		return 0;
+
+	return pfe_rtable_get_entry_count(dl->priv->pfe_platform->rtable);
+}
+#endif /* PFE_CFG_RTABLE_ENABLE */
+
+static u64 pfeng_devlink_l2_mac_occ_get(void *arg)
+{
+	struct pfeng_devlink *dl = arg;
+	pfe_l2br_table_iterator_t *iter;
+	pfe_l2br_table_entry_t *entry;
+	pfe_l2br_table_t *mactab;
+	u64 cnt = 0;
+	errno_t ret;
+
+	if (!dl->priv->pfe_platform || !dl->priv->pfe_platform->mactab)
+		return 0;
+	mactab = dl->priv->pfe_platform->mactab;
+
+	iter = pfe_l2br_iterator_create();
+	entry = pfe_l2br_table_entry_create(mactab);
+	if (iter && entry) {
+		ret = pfe_l2br_table_get_first(mactab, iter, L2BR_TABLE_CRIT_VALID, entry);
+		while (ret == EOK) {
+			cnt++;
+			ret = pfe_l2br_table_get_next(mactab, iter, entry);
+		}
+	}
+
+	if (entry)
+		pfe_l2br_table_entry_destroy(entry);
+	if (iter)
+		pfe_l2br_iterator_destroy(iter);
+
+	return cnt;
+}
+
+static u64 pfeng_devlink_fp_occ_get(void *arg)
+{
+	return pfe_fp_get_rules_count();
+}
+
+static u64 pfeng_devlink_tmu_occ(struct pfeng_devlink *dl, bool capacity)
+{
+	pfe_tmu_t *tmu;
+	u32 min, max, level;
+	u64 cnt = 0;
+	u8 q, q_cnt;
+	int i;
+
+	if (!dl->priv->pfe_platform || !dl->priv->pfe_platform->tmu)
+		return 0;
+	tmu = dl->priv->pfe_platform->tmu;
+
+	for (i = 0; i < ARRAY_SIZE(pfeng_devlink_tmu_phys); i++) {
+		q_cnt = pfe_tmu_queue_get_cnt(tmu, pfeng_devlink_tmu_phys[i]);
+		for (q = 0; q < q_cnt; q++) {
+			if (capacity) {
+				min = max = 0;
+				if (pfe_tmu_queue_get_mode(tmu, pfeng_devlink_tmu_phys[i], q, &min, &max) != TMU_Q_MODE_INVALID)
+					cnt += max;
+			} else if (pfe_tmu_queue_get_fill_level(tmu, pfeng_devlink_tmu_phys[i], q, &level) == EOK) {
+				cnt += level;
+			}
+		}
+	}
+
+	return cnt;
+}
+
+static u64 pfeng_devlink_tmu_occ_get(void *arg)
+{
+	return pfeng_devlink_tmu_occ(arg, false);
+}
+
+/* Last sample of the platform poller */
+static u64 pfeng_devlink_bmu2_occ_get(void *arg)
+{
+	struct pfeng_devlink *dl = arg;
+	pfe_platform_t *platform = dl->priv->pfe_platform;
+	pfe_bmu_occupancy_t occ;
+
+	if (!platform || platform->bmu_count < 2 || !platform->bmu[1] ||
+	    pfe_bmu_get_occupancy(platform->bmu[1], &occ))
+		return 0;
+
+	return occ.history[0].used_cnt;
+}
+
+static int pfeng_devlink_resource_add(struct pfeng_devlink *dl, struct devlink *devlink,
+				      const char *name, u64 size, u64 id,
+				      devlink_resource_occ_get_t *occ_get)
+{
+	struct devlink_resource_size_params params;
+	int ret;
+
+	devlink_resource_size_params_init(&params, size, size, 1, DEVLINK_RESOURCE_UNIT_ENTRY);
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6,3,0)
+	ret = devl_resource_register(devlink, name, size, id, DEVLINK_RESOURCE_ID_PARENT_TOP, &params);
+	if (!ret)
+		devl_resource_occ_get_register(devlink, id, occ_get, dl);
+#else
+	ret = devlink_resource_register(devlink, name, size, id, DEVLINK_RESOURCE_ID_PARENT_TOP, &params);
+	if (!ret)
+		devlink_resource_occ_get_register(devlink, id, occ_get, dl);
+#endif
+
+	return ret;
+}
+
+/* Has to be called with the instance lock held on kernels >= 6.3 */
+static int pfeng_devlink_resources_register(struct pfeng_devlink *dl, struct devlink *devlink)
+{
+	pfe_platform_t *platform = dl->priv->pfe_platform;
+	int ret = 0;
+
+	if (!platform)
+		return -ENODEV;
+
+#if defined(PFE_CFG_RTABLE_ENABLE)
+	if (platform->rtable) {
+		ret = pfeng_devlink_resource_add(dl, devlink, "rtable", pfe_rtable_get_size(platform->rtable),
+						 PFENG_DEVLINK_RES_ID_RTABLE, pfeng_devlink_rtable_occ_get);
+		if (ret)
+			return ret;
+	}
+#endif /* PFE_CFG_RTABLE_ENABLE */
+
+	if (platform->mactab) {
+		ret = pfeng_devlink_resource_add(dl, devlink, "l2_mac", pfe_l2br_table_get_size(platform->mactab),
+						 PFENG_DEVLINK_RES_ID_L2_MAC, pfeng_devlink_l2_mac_occ_get);
+		if (ret)
+			return ret;
+	}
+
+	/* Flexible parser tables are limited by the classifier DMEM heap only */
+	ret = pfeng_devlink_resource_add(dl, devlink, "fp_rules", U32_MAX,
+					 PFENG_DEVLINK_RES_ID_FP, pfeng_devlink_fp_occ_get);
+	if (ret)
+		return ret;
+
+	if (platform->bmu_count > 1 && platform->bmu[1]) {
+		ret = pfeng_devlink_resource_add(dl, devlink, "bmu2_buffers", dl->priv->pfe_cfg->bmu2_buf_count,
+						 PFENG_DEVLINK_RES_ID_BMU2, pfeng_devlink_bmu2_occ_get);
+		if (ret)
+			return ret;
+	}
+
+	return pfeng_devlink_resource_add(dl, devlink, "tmu_queues", pfeng_devlink_tmu_occ(dl, true),
+					  PFENG_DEVLINK_RES_ID_TMU, pfeng_devlink_tmu_occ_get);
+}
+
+static void pfeng_devlink_resources_unregister(struct devlink *devlink)
+{
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6,3,0)
+	devl_resources_unregister(devlink);
+#elif LINUX_VERSION_CODE >= KERNEL_VERSION(5,17,0)
+	devlink_resources_unregister(devlink);
+#else
+	devlink_resources_unregister(devlink, NULL);
+#endif
+}
+
+static void pfeng_devlink_hr_destroy(struct pfeng_devlink *dl)
+{
+	int i;
+
+	for (i = 0; i < PFENG_DEVLINK_HR_CNT; i++) {
+		if (dl->hr[i].reporter)
+			devlink_health_reporter_destroy(dl->hr[i].reporter);
+		dl->hr[i].reporter = NULL;
+	}
+}
+
+static int pfeng_devlink_hr_create(struct pfeng_devlink *dl, struct devlink *devlink)
+{
+	struct devlink_health_reporter *reporter;
+	int i;
+
+	for (i = 0; i < PFENG_DEVLINK_HR_CNT; i++) {
+		dl->hr[i].dl = dl;
+		reporter = devlink_health_reporter_create(devlink, pfeng_devlink_hr_ops[i],
+							  PFENG_DEVLINK_HR_GRACE_MS, &dl->hr[i]);
+		if (IS_ERR(reporter)) {
+			HM_MSG_DEV_ERR(&dl->priv->pdev->dev, "Failed to create %s health reporter\n",
+				       pfeng_devlink_hr_names[i]);
+			pfeng_devlink_hr_destroy(dl);
+			return PTR_ERR(reporter);
+		}
+		dl->hr[i].reporter = reporter;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief	Start forwarding of the HM events to the health reporters
+ * @details	HM callbacks are dropped on every platform init, so this has to be
+ *		called whenever the platform is started.
+ */
+void pfeng_devlink_hm_attach(struct pfeng_priv *priv)
+{
+	if (!priv->devlink)
+		return;
+
+	WRITE_ONCE(pfeng_devlink_hm_ctx, devlink_priv(priv->devlink));
+	if (!pfe_hm_register_event_cb(pfeng_devlink_hm_cb))
+		HM_MSG_DEV_WARN(&priv->pdev->dev, "HM events are not reported to devlink\n");
+}
+
+void pfeng_devlink_hm_detach(struct pfeng_priv *priv)
+{
+	if (!priv->devlink)
+		return;
+
+	pfe_hm_unregister_event_cb(pfeng_devlink_hm_cb);
+	WRITE_ONCE(pfeng_devlink_hm_ctx, NULL);
+}
+
+int pfeng_devlink_create(struct pfeng_priv *priv)
+{
+	struct device *dev = &priv->pdev->dev;
+	struct pfeng_devlink *dl;
+	struct devlink *devlink;
+	int ret;
+
+	devlink = devlink_alloc(&pfeng_devlink_ops, sizeof(*dl), dev);
+	if (!devlink)
+		return -ENOMEM;
+
+	dl = devlink_priv(devlink);
+	dl->priv = priv;
+	spin_lock_init(&dl->hm_lock);
+	INIT_KFIFO(dl->hm_fifo);
+	INIT_WORK(&dl->hm_work, pfeng_devlink_hm_work);
+
+	ret = devlink_params_register(devlink, pfeng_devlink_params, ARRAY_SIZE(pfeng_devlink_params));
+	if (ret) {
+		HM_MSG_DEV_ERR(dev, "Failed to register devlink params: %d\n", ret);
+		goto err_params;
+	}
+	pfeng_devlink_params_init(dl, devlink);
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6,3,0)
+	devl_lock(devlink);
+	ret = pfeng_devlink_resources_register(dl, devlink);
+	devl_unlock(devlink);
+#else
+	ret = pfeng_devlink_resources_register(dl, devlink);
+#endif
+	if (ret)
+		HM_MSG_DEV_WARN(dev, "Failed to register devlink resources: %d\n", ret);
+
+	ret = pfeng_devlink_hr_create(dl, devlink);
+	if (ret)
+		goto err_hr;
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5,17,0) && LINUX_VERSION_CODE < KERNEL_VERSION(6,3,0)
+	devlink_set_features(devlink, DEVLINK_F_RELOAD);
+#endif
+
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(5,16,0)
+	devlink_register(devlink);
+#else
+	ret = devlink_register(devlink);
+	if (ret)
+		goto err_register;
+	devlink_reload_enable(devlink);
+#endif
+
+	priv->devlink = devlink;
+	pfeng_devlink_hm_attach(priv);
+
+	HM_MSG_DEV_INFO(dev, "devlink registered\n");
+
+	return 0;
+
+#if LINUX_VERSION_CODE < KERNEL_VERSION(5,16,0)
+err_register:
+	pfeng_devlink_hr_destroy(dl);
+#endif
+err_hr:
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6,3,0)
+	devl_lock(devlink);
+	pfeng_devlink_resources_unregister(devlink);
+	devl_unlock(devlink);
+#else
+	pfeng_devlink_resources_unregister(devlink);
+#endif
+	devlink_params_unregister(devlink, pfeng_devlink_params, ARRAY_SIZE(pfeng_devlink_params));
+err_params:
+	devlink_free(devlink);
+
+	return ret;
+}
+
+void pfeng_devlink_remove(struct pfeng_priv *priv)
+{
+	struct devlink *devlink = priv->devlink;
+	struct pfeng_devlink *dl;
+
+	if (!devlink)
+		return;
+
+	dl = devlink_priv(devlink);
+
+	/* No HM callback runs after the detach, the work can't be scheduled again */
+	pfeng_devlink_hm_detach(priv);
+	cancel_work_sync(&dl->hm_work);
+
+#if LINUX_VERSION_CODE < KERNEL_VERSION(5,16,0)
+	devlink_reload_disable(devlink);
+#endif
+	devlink_unregister(devlink);
+	pfeng_devlink_hr_destroy(dl);
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6,3,0)
+	devl_lock(devlink);
+	pfeng_devlink_resources_unregister(devlink);
+	devl_unlock(devlink);
+#else
+	pfeng_devlink_resources_unregister(devlink);
+#endif
+	devlink_params_unregister(devlink, pfeng_devlink_params, ARRAY_SIZE(pfeng_devlink_params));
+	priv->devlink = NULL;
+	devlink_free(devlink);
+}
+
+#else /* CONFIG_NET_DEVLINK */
+
+void pfeng_devlink_hm_attach(struct pfeng_priv *priv)
+{
+	/* NOP */
+}
+
+void pfeng_devlink_hm_detach(struct pfeng_priv *priv)
+{
+	/* NOP */
+}
+
+int pfeng_devlink_create(struct pfeng_priv *priv)
+{
+	return 0;
+}
+
+void pfeng_devlink_remove(struct pfeng_priv *priv)
+{
+	/* NOP */
+}
+
+#endif /* CONFIG_NET_DEVLINK */
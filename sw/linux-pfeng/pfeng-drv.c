@@ -128,6 +128,10 @@ static bool g3_rtable_in_lmem = true;
 module_param(g3_rtable_in_lmem , bool, 0644);
 MODULE_PARM_DESC(g3_rtable_in_lmem , "\t Allocate PFE's Routing Table in local memory on S32G3 (default: true)");
 
+static uint bmu2_buf_cnt = PFE_CFG_BMU2_BUF_COUNT;
+module_param(bmu2_buf_cnt, uint, 0444);
+MODULE_PARM_DESC(bmu2_buf_cnt, "\t Number of BMU2 buffers, power of 2 within " __stringify(PFENG_BMU2_BUF_CNT_MIN) "-" __stringify(PFENG_BMU2_BUF_CNT_MAX) " (default: " __stringify(PFE_CFG_BMU2_BUF_COUNT) ")");
+
 static int lltx_res_tmu_q_id = 255;
 module_param(lltx_res_tmu_q_id, int, 0644);
 MODULE_PARM_DESC(lltx_res_tmu_q_id, "\t Reserved TMU queue ID for Host lossless Tx (LLTX), range: 0-7; use 255 to disable LLTX (default: 255)");
@@ -230,6 +234,7 @@ static struct pfeng_priv *pfeng_drv_alloc(struct platform_device *pdev)
 
 	INIT_LIST_HEAD(&priv->netif_cfg_list);
 	INIT_LIST_HEAD(&priv->netif_list);
+	mutex_init(&priv->pfe_lock);
 
 	/* set EMAC interface mode to invalid value */
 	priv->emac[0].intf_mode = -1;
@@ -239,6 +244,7 @@ static struct pfeng_priv *pfeng_drv_alloc(struct platform_device *pdev)
 	/* cfg defaults */
 	priv->msg_enable = default_msg_level;
 	priv->msg_verbosity = msg_verbosity;
+	priv->rx_coalesce_usecs = PFENG_INT_TIMER_DEFAULT;
 
 	/*
 	 * Default size of routing table. Symbols PFE_CFG_RT_HASH_SIZE, PFE_CFG_RT_COLLISION_SIZE
@@ -333,9 +339,18 @@ static int pfeng_drv_remove(struct platform_device *pdev)
 	hal_ip_ready_set(false);
 #endif /* PFE_CFG_MULTI_INSTANCE_SUPPORT */
 
+	/* Remove devlink instance */
+	pfeng_devlink_remove(priv);
+
 	/* Remove debugfs directory */
 	pfeng_debugfs_remove(priv);
 
+	/* Remove bridge offload */
+	pfeng_switchdev_remove(priv);
+
+	/* Remove TC/flowtable offload */
+	pfeng_tc_remove(priv);
+
 	/* Remove netifs */
 	pfeng_netif_remove(priv);
 
@@ -518,6 +533,13 @@ static int pfeng_drv_probe(struct platform_device *pdev)
 	if (l2br_vlan_id != 1)
 		priv->pfe_cfg->vlan_id = l2br_vlan_id;
 
+	/* BMU2 pool size */
+	if (!is_power_of_2(bmu2_buf_cnt) || bmu2_buf_cnt < PFENG_BMU2_BUF_CNT_MIN || bmu2_buf_cnt > PFENG_BMU2_BUF_CNT_MAX) {
+		HM_MSG_DEV_ERR(dev, "Invalid BMU2 buffer count, used %u\n", PFE_CFG_BMU2_BUF_COUNT);
+		bmu2_buf_cnt = PFE_CFG_BMU2_BUF_COUNT;
+	}
+	priv->pfe_cfg->bmu2_buf_count = bmu2_buf_cnt;
+
 	/* L2bridge vlan stats size */
 	if (l2br_vlan_stats_size < 2 || l2br_vlan_stats_size > 128) {
 		HM_MSG_DEV_ERR(dev, "Invalid vlan stats size\n");
@@ -777,6 +799,21 @@ static int pfeng_drv_probe(struct platform_device *pdev)
 	if (ret)
 		goto err_drv;
 
+	/* TC/flowtable offload */
+	ret = pfeng_tc_create(priv);
+	if (ret)
+		HM_MSG_DEV_WARN(dev, "TC offload not available: %d\n", ret);
+
+	/* Offload Linux bridges to the PFE L2 bridge */
+	ret = pfeng_switchdev_create(priv);
+	if (ret)
+		HM_MSG_DEV_WARN(dev, "Bridge offload not available: %d\n", ret);
+
+	/* Device info, parameters and health reporting */
+	ret = pfeng_devlink_create(priv);
+	if (ret)
+		HM_MSG_DEV_WARN(dev, "devlink not available: %d\n", ret);
+
 #if LINUX_VERSION_CODE >= KERNEL_VERSION(5,8,0)
 	dev_pm_set_driver_flags(dev, DPM_FLAG_NO_DIRECT_COMPLETE);
 #else
@@ -800,9 +837,9 @@ err_drv:
  * @dev: device pointer
  * Description: this function is invoked when suspend the driver and it direcly
  * call the main suspend function and then, if required, on some platform, it
- * can call an exit helper.
+ * can call an exit helper. Has to be called with priv->pfe_lock held.
  */
-static int pfeng_drv_pm_suspend(struct device *dev)
+static int __pfeng_drv_pm_suspend(struct device *dev)
 {
 	struct pfeng_priv *priv = dev_get_drvdata(dev);
 
@@ -816,6 +853,12 @@ static int pfeng_drv_pm_suspend(struct device *dev)
 
 	pfeng_debugfs_remove(priv);
 
+	/* Offloaded flows are restored into the new routing table on resume */
+	pfeng_tc_suspend(priv);
+
+	/* Learned FDB entries are lost with the MAC table */
+	pfeng_switchdev_suspend(priv);
+
 	/* MDIO buses */
 	pfeng_mdio_suspend(priv);
 
@@ -825,6 +868,9 @@ static int pfeng_drv_pm_suspend(struct device *dev)
 	/* HIFs stop */
 	pfeng_hif_remove(priv);
 
+	/* HM events of the stopped platform are not reported */
+	pfeng_devlink_hm_detach(priv);
+
 	/* PFE platform remove */
 	if (priv->pfe_platform) {
 		if (pfe_platform_remove() != EOK)
@@ -856,9 +902,9 @@ static int pfeng_drv_pm_suspend(struct device *dev)
  * @dev: device pointer
  * Description: this function is invoked when resume the driver before calling
  * the main resume function, on some platforms, it can call own init helper
- * if required.
+ * if required. Has to be called with priv->pfe_lock held.
  */
-static int pfeng_drv_pm_resume(struct device *dev)
+static int __pfeng_drv_pm_resume(struct device *dev)
 {
 	struct pfeng_priv *priv = dev_get_drvdata(dev);
 	int ret;
@@ -937,6 +983,9 @@ static int pfeng_drv_pm_resume(struct device *dev)
 		goto err_pfe_get;
 	}
 
+	/* Platform init dropped the HM callbacks */
+	pfeng_devlink_hm_attach(priv);
+
 #ifdef PFE_CFG_MULTI_INSTANCE_SUPPORT
 	hal_ip_ready_set(true);
 #endif /* PFE_CFG_MULTI_INSTANCE_SUPPORT */
@@ -975,6 +1024,11 @@ static int pfeng_drv_pm_resume(struct device *dev)
 	if (ret)
 		goto err_drv;
 
+	/* Offloaded flows and flower rules need the resumed EMAC interfaces */
+	pfeng_tc_resume(priv);
+
+	pfeng_switchdev_resume(priv);
+
 	priv->in_suspend = false;
 
 	return 0;
@@ -986,6 +1040,94 @@ err_pfe_init:
 	return ret;
 }
 
+static int pfeng_drv_pm_suspend(struct device *dev)
+{
+	struct pfeng_priv *priv = dev_get_drvdata(dev);
+	int ret;
+
+	mutex_lock(&priv->pfe_lock);
+	ret = __pfeng_drv_pm_suspend(dev);
+	mutex_unlock(&priv->pfe_lock);
+
+	return ret;
+}
+
+static int pfeng_drv_pm_resume(struct device *dev)
+{
+	struct pfeng_priv *priv = dev_get_drvdata(dev);
+	int ret;
+
+	mutex_lock(&priv->pfe_lock);
+	ret = __pfeng_drv_pm_resume(dev);
+	mutex_unlock(&priv->pfe_lock);
+
+	return ret;
+}
+
+/**
+ * pfeng_drv_pfe_stop
+ * @priv: driver private data
+ * Description: stops the PFE the same way as the system suspend does. Used by
+ * the devlink reload; has to be called without rtnl lock.
+ */
+int pfeng_drv_pfe_stop(struct pfeng_priv *priv)
+{
+	int ret;
+
+	mutex_lock(&priv->pfe_lock);
+	if (priv->in_suspend)
+		ret = -EBUSY;
+	else
+		ret = __pfeng_drv_pm_suspend(&priv->pdev->dev);
+	mutex_unlock(&priv->pfe_lock);
+
+	return ret;
+}
+
+/**
+ * pfeng_drv_pfe_start
+ * @priv: driver private data
+ * Description: starts the PFE stopped by pfeng_drv_pfe_stop() with the current
+ * platform configuration.
+ */
+int pfeng_drv_pfe_start(struct pfeng_priv *priv)
+{
+	int ret;
+
+	mutex_lock(&priv->pfe_lock);
+	if (!priv->in_suspend)
+		ret = -EBUSY;
+	else
+		ret = __pfeng_drv_pm_resume(&priv->pdev->dev);
+	mutex_unlock(&priv->pfe_lock);
+
+	return ret;
+}
+
+/**
+ * pfeng_drv_pfe_restart
+ * @priv: driver private data
+ * Description: stops and starts the running PFE at once. Used by the health
+ * recovery; has to be called without rtnl lock.
+ */
+int pfeng_drv_pfe_restart(struct pfeng_priv *priv)
+{
+	int ret;
+
+	mutex_lock(&priv->pfe_lock);
+	if (priv->in_suspend) {
+		/* Stopped by the devlink reload or system suspend */
+		ret = -EBUSY;
+	} else {
+		ret = __pfeng_drv_pm_suspend(&priv->pdev->dev);
+		if (!ret)
+			ret = __pfeng_drv_pm_resume(&priv->pdev->dev);
+	}
+	mutex_unlock(&priv->pfe_lock);
+
+	return ret;
+}
+
 SIMPLE_DEV_PM_OPS(pfeng_drv_pm_ops,
 			pfeng_drv_pm_suspend,
 			pfeng_drv_pm_resume);
@@ -1022,4 +1164,26 @@ static struct platform_driver pfeng_platform_driver = {
 	.shutdown = pfeng_drv_shutdown,
 };
 
-module_platform_driver(pfeng_platform_driver);
+static int __init pfeng_drv_init(void)
+{
+	int ret;
+
+	/* Routing table entries can outlive the platform, keep their cache module-wide.
+	 * Entries are allocated from the heap if the cache is not available. */
+	(void)pfe_rtable_entry_slab_init();
+
+	ret = platform_driver_register(&pfeng_platform_driver);
+	if (ret)
+		pfe_rtable_entry_slab_fini();
+
+	return ret;
+}
+
+static void __exit pfeng_drv_exit(void)
+{
+	platform_driver_unregister(&pfeng_platform_driver);
+	pfe_rtable_entry_slab_fini();
+}
+
+module_init(pfeng_drv_init);
+module_exit(pfeng_drv_exit);
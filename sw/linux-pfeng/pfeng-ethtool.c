@@ -12,6 +12,16 @@
 #include <linux/ethtool.h>
 #include <linux/phylink.h>
 
+#ifdef PFE_CFG_PFE_MASTER
+#define PFENG_RXNFC_MAX_RULES	32
+
+/* RX classification rule, kept to survive the platform re-creation */
+struct pfeng_rxnfc_rule {
+	struct list_head		node;
+	struct ethtool_rx_flow_spec	fs;
+};
+#endif
+
 static void pfeng_ethtool_getdrvinfo(struct net_device *netdev, struct ethtool_drvinfo *info)
 {
 #ifdef PFE_CFG_PFE_MASTER
@@ -33,6 +43,88 @@ static void pfeng_ethtool_getdrvinfo(struct net_device *netdev, struct ethtool_d
 #endif
 }
 
+static const char pfeng_priv_flags_strings[PFENG_PRIV_FLAGS_CNT][ETH_GSTRING_LEN] = {
+	[PFENG_PRIV_FLAG_RX_VLAN_ERRATUM] = "rx-vlan-erratum",
+	[PFENG_PRIV_FLAG_TMU_PRECHECK] = "tx-tmu-precheck",
+	[PFENG_PRIV_FLAG_CSUM_LEN_LIMIT] = "tx-csum-len-limit",
+	[PFENG_PRIV_FLAG_RX_HWTS] = "rx-hwts",
+	[PFENG_PRIV_FLAG_TX_ETS] = "tx-ets",
+};
+
+/* Order follows struct pfeng_bman_rx_stats */
+static const char pfeng_stats_strings[][ETH_GSTRING_LEN] = {
+	"rx_page_alloc_fail",
+	"rx_page_reserve_used",
+	"rx_deferred_refill",
+	"rx_ring_starved",
+};
+
+static int pfeng_ethtool_get_sset_count(struct net_device *netdev, int sset)
+{
+	switch (sset) {
+	case ETH_SS_STATS:
+		return ARRAY_SIZE(pfeng_stats_strings);
+	case ETH_SS_PRIV_FLAGS:
+		return PFENG_PRIV_FLAGS_CNT;
+	default:
+		return -EOPNOTSUPP;
+	}
+}
+
+static void pfeng_ethtool_get_strings(struct net_device *netdev, u32 sset, u8 *data)
+{
+	switch (sset) {
+	case ETH_SS_STATS:
+		memcpy(data, pfeng_stats_strings, sizeof(pfeng_stats_strings));
+		break;
+	case ETH_SS_PRIV_FLAGS:
+		memcpy(data, pfeng_priv_flags_strings, sizeof(pfeng_priv_flags_strings));
+		break;
+	default:
+		break;
+	}
+}
+
+static void pfeng_ethtool_get_stats(struct net_device *netdev, struct ethtool_stats *stats, u64 *data)
+{
+	struct pfeng_netif *netif = netdev_priv(netdev);
+	unsigned long hifmap = netif->cfg->hifmap;
+	struct pfeng_bman_rx_stats rx_stats = { 0 };
+	int idx;
+
+	BUILD_BUG_ON(sizeof(rx_stats) != sizeof(pfeng_stats_strings) / ETH_GSTRING_LEN * sizeof(u64));
+
+	/* Channels shared by several netifs are reported by each of them */
+	for_each_set_bit(idx, &hifmap, PFENG_PFE_HIF_CHANNELS)
+		pfeng_bman_rx_stats_add(&netif->priv->hif_chnl[idx], &rx_stats);
+
+	memcpy(data, &rx_stats, sizeof(rx_stats));
+}
+
+static u32 pfeng_ethtool_get_priv_flags(struct net_device *netdev)
+{
+	struct pfeng_netif *netif = netdev_priv(netdev);
+
+	return READ_ONCE(netif->priv_flags);
+}
+
+static int pfeng_ethtool_set_priv_flags(struct net_device *netdev, u32 flags)
+{
+	struct pfeng_netif *netif = netdev_priv(netdev);
+	u32 changed = flags ^ netif->priv_flags;
+
+	if (flags & ~PFENG_PRIV_FLAGS_DEFAULT)
+		return -EINVAL;
+
+	/* Flags are sampled per frame by the datapath, no reconfiguration needed */
+	WRITE_ONCE(netif->priv_flags, flags);
+
+	if (changed)
+		HM_MSG_NETDEV_DBG(netdev, "private flags changed to 0x%x\n", flags);
+
+	return 0;
+}
+
 static int pfeng_ethtool_get_ts_info(struct net_device *netdev, struct ethtool_ts_info *info)
 {
 	struct pfeng_netif *netif = netdev_priv(netdev);
@@ -180,6 +272,236 @@ static int pfeng_set_coalesce(struct net_device *netdev, struct ethtool_coalesce
 	return __pfeng_set_coalesce(netdev, ec);
 }
 
+static struct pfeng_rxnfc_rule *pfeng_rxnfc_find(struct pfeng_netif *netif, u32 location)
+{
+	struct pfeng_rxnfc_rule *rule;
+
+	list_for_each_entry(rule, &netif->rxnfc_rules, node) {
+		if (rule->fs.location == location)
+			return rule;
+	}
+
+	return NULL;
+}
+
+/* Rule is offloaded as a classifier logif, its address serves as the cookie.
+ * The classifier matches the most recently added logif first, so the rules,
+ * kept sorted by location, are programmed from the highest location down.
+ */
+static int pfeng_rxnfc_program(struct pfeng_netif *netif, struct pfeng_rxnfc_rule *rule)
+{
+	struct ethtool_rx_flow_spec_input input = {
+		.fs = &rule->fs,
+	};
+	struct ethtool_rx_flow_rule *flow;
+	int ret;
+
+	flow = ethtool_rx_flow_rule_create(&input);
+	if (IS_ERR(flow))
+		return PTR_ERR(flow);
+
+	ret = pfeng_tc_cls_rule_add(netif, (unsigned long)rule, flow->rule, NULL);
+	ethtool_rx_flow_rule_destroy(flow);
+
+	return ret;
+}
+
+/* Re-add the rules preceding the given one to keep them matched first */
+static void pfeng_rxnfc_reprogram_before(struct pfeng_netif *netif, struct pfeng_rxnfc_rule *rule)
+{
+	list_for_each_entry_continue_reverse(rule, &netif->rxnfc_rules, node) {
+		pfeng_tc_cls_rule_del(netif, (unsigned long)rule);
+		if (pfeng_rxnfc_program(netif, rule))
+			HM_MSG_NETDEV_WARN(netif->netdev, "RX classification rule %u not updated\n", rule->fs.location);
+	}
+}
+
+static int pfeng_rxnfc_ins(struct pfeng_netif *netif, struct ethtool_rx_flow_spec *fs)
+{
+	struct pfeng_rxnfc_rule *rule, *old, *pos;
+	int ret;
+
+	if (fs->location >= PFENG_RXNFC_MAX_RULES)
+		return -EINVAL;
+
+	if (fs->ring_cookie != RX_CLS_FLOW_DISC) {
+		if (ethtool_get_flow_spec_ring_vf(fs->ring_cookie))
+			return -EOPNOTSUPP;
+		if (ethtool_get_flow_spec_ring(fs->ring_cookie) >= netif->cfg->hifs)
+			return -EINVAL;
+	}
+
+	old = pfeng_rxnfc_find(netif, fs->location);
+	if (!old && netif->rxnfc_cnt >= PFENG_RXNFC_MAX_RULES)
+		return -ENOSPC;
+
+	rule = kzalloc(sizeof(*rule), GFP_KERNEL);
+	if (!rule)
+		return -ENOMEM;
+	rule->fs = *fs;
+
+	ret = pfeng_rxnfc_program(netif, rule);
+	if (ret) {
+		HM_MSG_NETDEV_ERR(netif->netdev, "RX classification rule %u not offloaded: %d\n", fs->location, ret);
+		kfree(rule);
+		return ret;
+	}
+
+	/* Replace the rule at the same location */
+	if (old) {
+		pfeng_tc_cls_rule_del(netif, (unsigned long)old);
+		list_del(&old->node);
+		kfree(old);
+		netif->rxnfc_cnt--;
+	}
+
+	/* Keep the list sorted by location */
+	list_for_each_entry(pos, &netif->rxnfc_rules, node) {
+		if (pos->fs.location > rule->fs.location)
+			break;
+	}
+	list_add_tail(&rule->node, &pos->node);
+	netif->rxnfc_cnt++;
+
+	/* The new rule has been matched first, rules of lower location have priority */
+	pfeng_rxnfc_reprogram_before(netif, rule);
+
+	return 0;
+}
+
+static int pfeng_rxnfc_del(struct pfeng_netif *netif, u32 location)
+{
+	struct pfeng_rxnfc_rule *rule;
+
+	rule = pfeng_rxnfc_find(netif, location);
+	if (!rule)
+		return -ENOENT;
+
+	pfeng_tc_cls_rule_del(netif, (unsigned long)rule);
+	list_del(&rule->node);
+	kfree(rule);
+	netif->rxnfc_cnt--;
+
+	return 0;
+}
+
+static int pfeng_ethtool_get_rxnfc(struct net_device *netdev, struct ethtool_rxnfc *cmd, u32 *rule_locs)
+{
+	struct pfeng_netif *netif = netdev_priv(netdev);
+	struct pfeng_rxnfc_rule *rule;
+	u32 cnt = 0;
+
+	switch (cmd->cmd) {
+	case ETHTOOL_GRXRINGS:
+		cmd->data = netif->cfg->hifs;
+		return 0;
+	case ETHTOOL_GRXCLSRLCNT:
+		cmd->rule_cnt = netif->rxnfc_cnt;
+		cmd->data = PFENG_RXNFC_MAX_RULES;
+		return 0;
+	case ETHTOOL_GRXCLSRULE:
+		rule = pfeng_rxnfc_find(netif, cmd->fs.location);
+		if (!rule)
+			return -ENOENT;
+		cmd->fs = rule->fs;
+		return 0;
+	case ETHTOOL_GRXCLSRLALL:
+		list_for_each_entry(rule, &netif->rxnfc_rules, node) {
+			if (cnt == cmd->rule_cnt)
+				return -EMSGSIZE;
+			rule_locs[cnt++] = rule->fs.location;
+		}
+		cmd->rule_cnt = cnt;
+		cmd->data = PFENG_RXNFC_MAX_RULES;
+		return 0;
+	default:
+		return -EOPNOTSUPP;
+	}
+}
+
+static int pfeng_ethtool_set_rxnfc(struct net_device *netdev, struct ethtool_rxnfc *cmd)
+{
+	struct pfeng_netif *netif = netdev_priv(netdev);
+
+	switch (cmd->cmd) {
+	case ETHTOOL_SRXCLSRLINS:
+		return pfeng_rxnfc_ins(netif, &cmd->fs);
+	case ETHTOOL_SRXCLSRLDEL:
+		return pfeng_rxnfc_del(netif, cmd->fs.location);
+	default:
+		return -EOPNOTSUPP;
+	}
+}
+
+/* HIF channels managed by the driver which can serve the netif */
+static u32 pfeng_ethtool_avail_hifmap(struct pfeng_netif *netif)
+{
+	struct pfeng_priv *priv = netif->priv;
+	u32 map = netif->cfg->hifmap;
+	int i;
+
+	for (i = 0; i < PFENG_PFE_HIF_CHANNELS; i++) {
+		if ((priv->pfe_cfg->hif_chnls_mask & (1 << i)) && !priv->hif_chnl[i].ihc)
+			map |= 1 << i;
+	}
+
+	return map;
+}
+
+static void pfeng_ethtool_get_channels(struct net_device *netdev, struct ethtool_channels *ch)
+{
+	struct pfeng_netif *netif = netdev_priv(netdev);
+
+	/* Each HIF channel provides one RX and one TX ring */
+	ch->max_combined = hweight32(pfeng_ethtool_avail_hifmap(netif));
+	ch->combined_count = netif->cfg->hifs;
+}
+
+static int pfeng_ethtool_set_channels(struct net_device *netdev, struct ethtool_channels *ch)
+{
+	struct pfeng_netif *netif = netdev_priv(netdev);
+	u32 avail = pfeng_ethtool_avail_hifmap(netif);
+	u32 hifmap = netif->cfg->hifmap;
+	struct pfeng_rxnfc_rule *rule;
+	int ret;
+
+	if (!ch->combined_count || ch->rx_count || ch->tx_count || ch->other_count)
+		return -EINVAL;
+
+	if (ch->combined_count > hweight32(avail))
+		return -EINVAL;
+
+	/* Queues steered to by RX classification rules have to stay */
+	list_for_each_entry(rule, &netif->rxnfc_rules, node) {
+		if (rule->fs.ring_cookie == RX_CLS_FLOW_DISC)
+			continue;
+		if (ethtool_get_flow_spec_ring(rule->fs.ring_cookie) >= ch->combined_count) {
+			HM_MSG_NETDEV_ERR(netdev, "RX classification rule %u uses queue %llu\n",
+					  rule->fs.location, ethtool_get_flow_spec_ring(rule->fs.ring_cookie));
+			return -EINVAL;
+		}
+	}
+
+	/* Shrink from the highest channel, grow by the lowest free one */
+	while (hweight32(hifmap) > ch->combined_count)
+		hifmap &= ~(1U << (fls(hifmap) - 1));
+	while (hweight32(hifmap) < ch->combined_count)
+		hifmap |= 1U << (ffs(avail & ~hifmap) - 1);
+
+	ret = pfeng_netif_set_hifmap(netif, hifmap);
+	if (ret)
+		return ret;
+
+	/* Rx queue to HIF channel mapping has changed */
+	list_for_each_entry_reverse(rule, &netif->rxnfc_rules, node) {
+		pfeng_tc_cls_rule_del(netif, (unsigned long)rule);
+		if (pfeng_rxnfc_program(netif, rule))
+			HM_MSG_NETDEV_WARN(netdev, "RX classification rule %u not updated\n", rule->fs.location);
+	}
+
+	return 0;
+}
+
 static int pfeng_ethtool_begin(struct net_device *netdev)
 {
 	struct pfeng_netif *netif = netdev_priv(netdev);
@@ -208,11 +530,20 @@ static const struct ethtool_ops pfeng_ethtool_ops = {
 	.set_link_ksettings = pfeng_ethtool_set_link_ksettings,
 	.get_coalesce = pfeng_get_coalesce,
 	.set_coalesce = pfeng_set_coalesce,
+	.get_rxnfc = pfeng_ethtool_get_rxnfc,
+	.set_rxnfc = pfeng_ethtool_set_rxnfc,
+	.get_channels = pfeng_ethtool_get_channels,
+	.set_channels = pfeng_ethtool_set_channels,
 	.begin = pfeng_ethtool_begin,
 	.complete = pfeng_ethtool_complete,
 #endif
 	.get_drvinfo = pfeng_ethtool_getdrvinfo,
 	.get_ts_info = pfeng_ethtool_get_ts_info,
+	.get_sset_count = pfeng_ethtool_get_sset_count,
+	.get_strings = pfeng_ethtool_get_strings,
+	.get_ethtool_stats = pfeng_ethtool_get_stats,
+	.get_priv_flags = pfeng_ethtool_get_priv_flags,
+	.set_priv_flags = pfeng_ethtool_set_priv_flags,
 };
 
 void pfeng_ethtool_init(struct net_device *netdev)
@@ -240,6 +571,7 @@ int pfeng_ethtool_params_restore(struct pfeng_netif *netif) {
 	struct pfeng_hif_chnl *chnl;
 	struct ethtool_coalesce ec;
 	struct ethtool_pauseparam epp;
+	struct pfeng_rxnfc_rule *rule;
 	int ret, idx = ffs(netif->cfg->hifmap) - 1;
 
 	/* Coalesce */
@@ -259,8 +591,27 @@ int pfeng_ethtool_params_restore(struct pfeng_netif *netif) {
 	if (ret)
 		HM_MSG_NETDEV_WARN(netdev, "Pause not restored\n");
 
+	/* RX classification rules */
+	list_for_each_entry_reverse(rule, &netif->rxnfc_rules, node) {
+		ret = pfeng_rxnfc_program(netif, rule);
+		if (ret)
+			HM_MSG_NETDEV_WARN(netdev, "RX classification rule %u not restored\n", rule->fs.location);
+	}
+
 	return 0;
 }
+
+void pfeng_ethtool_rxnfc_release(struct pfeng_netif *netif)
+{
+	struct pfeng_rxnfc_rule *rule, *tmp;
+
+	list_for_each_entry_safe(rule, tmp, &netif->rxnfc_rules, node) {
+		pfeng_tc_cls_rule_del(netif, (unsigned long)rule);
+		list_del(&rule->node);
+		kfree(rule);
+	}
+	netif->rxnfc_cnt = 0;
+}
 #else
 int pfeng_ethtool_params_save(struct pfeng_netif *netif) {
 	return 0;
@@ -269,4 +620,9 @@ int pfeng_ethtool_params_save(struct pfeng_netif *netif) {
 int pfeng_ethtool_params_restore(struct pfeng_netif *netif) {
 	return 0;
 }
+
+void pfeng_ethtool_rxnfc_release(struct pfeng_netif *netif)
+{
+	/* NOP */
+}
 #endif
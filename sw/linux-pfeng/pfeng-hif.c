@@ -333,7 +333,8 @@ static int pfeng_hif_chnl_rx(struct pfeng_hif_chnl *chnl, int limit)
 			vlan_tag = hif_hdr->rx_timestamp_s;
 		}
 
-		if (likely(hif_hdr->flags & HIF_RX_TS)) {
+		if (likely(hif_hdr->flags & HIF_RX_TS) &&
+		    likely(pfeng_netif_priv_flag(netif, PFENG_PRIV_FLAG_RX_HWTS))) {
 			u32 rx_timestamp_s = hif_hdr->rx_timestamp_s;
 
 			if (unlikely(vlan_tag)) {
@@ -369,13 +370,21 @@ static int pfeng_hif_chnl_rx(struct pfeng_hif_chnl *chnl, int limit)
 			skb->csum_level = 0;
 		}
 
+#if defined(PFE_CFG_PFE_MASTER) && IS_ENABLED(CONFIG_NET_SWITCHDEV)
+		/* Frame was already switched by the PFE L2 bridge */
+		if (unlikely(netif->brport_dev))
+			skb->offload_fwd_mark = 1;
+#endif /* PFE_CFG_PFE_MASTER && CONFIG_NET_SWITCHDEV */
+
 		/* Skip HIF header */
 		skb_pull(skb, PFENG_RX_PKT_HEADER_SIZE);
 
 		if (unlikely(vlan_tag)) {
+			/* the TS word is always skipped, the tag is restored only if enabled */
 			skb_pull(skb, VLAN_HLEN);
 			/* vlan_tag is in big endian format */
-			__vlan_hwaccel_put_tag(skb, vlan_tag & 0xffff, be16_to_cpu(vlan_tag >> 16));
+			if (likely(pfeng_netif_priv_flag(netif, PFENG_PRIV_FLAG_RX_VLAN_ERRATUM)))
+				__vlan_hwaccel_put_tag(skb, vlan_tag & 0xffff, be16_to_cpu(vlan_tag >> 16));
 		}
 
 		/* Pass to upper layer */
@@ -555,8 +564,8 @@ static int pfeng_hif_chnl_drv_create(struct pfeng_priv *priv, u32 idx)
 	chnl->dev = dev;
 	chnl->idx = idx;
 
-	if (unlikely(chnl->refcount))
-		spin_lock_init(&chnl->lock_tx);
+	/* Channel can become shared at runtime (ethtool -L) */
+	spin_lock_init(&chnl->lock_tx);
 
 	/* Register HIF channel RX/TX callback */
 	pfe_hif_chnl_set_event_cbk(chnl->priv, HIF_CHNL_EVT_RX_IRQ | HIF_CHNL_EVT_TX_IRQ,
@@ -594,7 +603,7 @@ static int pfeng_hif_chnl_drv_create(struct pfeng_priv *priv, u32 idx)
 	init_dummy_netdev(&chnl->dummy_netdev);
 
 	/* init interrupt coalescing */
-	pfeng_hif_chnl_set_coalesce(chnl, priv->clk_sys, PFENG_INT_TIMER_DEFAULT, 0);
+	pfeng_hif_chnl_set_coalesce(chnl, priv->clk_sys, priv->rx_coalesce_usecs, 0);
 
 	chnl->status = PFENG_HIF_STATUS_ENABLED;
 	netif_napi_add(&chnl->dummy_netdev, &chnl->napi, pfeng_hif_chnl_poll, NAPI_POLL_WEIGHT);
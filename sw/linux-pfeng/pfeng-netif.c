@@ -411,6 +411,7 @@ static netdev_tx_t pfeng_netif_logif_xmit(struct sk_buff *skb, struct net_device
 	}
 
 	if (likely(pfeng_tmu_lltx_enabled(&netif->tmu_q_cfg)) &&
+	    likely(pfeng_netif_priv_flag(netif, PFENG_PRIV_FLAG_TMU_PRECHECK)) &&
 		   !pfeng_tmu_can_tx(netif->tmu, &netif->tmu_q_cfg, &netif->tmu_q)) {
 		set_bit(PFENG_TMU_FULL, &netif->tx_queue_status);
 		smp_wmb();
@@ -455,12 +456,14 @@ static netdev_tx_t pfeng_netif_logif_xmit(struct sk_buff *skb, struct net_device
 	}
 
 	if (likely(skb->ip_summed == CHECKSUM_PARTIAL)) {
-		if (likely(skb->csum_offset == offsetof(struct udphdr, check) &&
-			   pktlen <= PFENG_CSUM_OFF_PKT_LIMIT)) {
+		/* Offload limit can be lifted at runtime via ethtool private flag */
+		bool csum_ok = pktlen <= PFENG_CSUM_OFF_PKT_LIMIT ||
+			       !pfeng_netif_priv_flag(netif, PFENG_PRIV_FLAG_CSUM_LEN_LIMIT);
+
+		if (likely(skb->csum_offset == offsetof(struct udphdr, check) && csum_ok)) {
 			tx_hdr->flags |= HIF_TX_UDP_CSUM;
 		}
-		else if (likely(skb->csum_offset == offsetof(struct tcphdr, check) &&
-				pktlen <= PFENG_CSUM_OFF_PKT_LIMIT)) {
+		else if (likely(skb->csum_offset == offsetof(struct tcphdr, check) && csum_ok)) {
 			tx_hdr->flags |= HIF_TX_TCP_CSUM;
 		} else {
 			skb_checksum_help(skb);
@@ -469,7 +472,8 @@ static netdev_tx_t pfeng_netif_logif_xmit(struct sk_buff *skb, struct net_device
 
 	/* HW timestamping */
 	if (unlikely((skb_shinfo(skb)->tx_flags & SKBTX_HW_TSTAMP) &&
-		    (netif->tshw_cfg.tx_type == HWTSTAMP_TX_ON))) {
+		    (netif->tshw_cfg.tx_type == HWTSTAMP_TX_ON) &&
+		    pfeng_netif_priv_flag(netif, PFENG_PRIV_FLAG_TX_ETS))) {
 		int ref_num = pfeng_hwts_store_tx_ref(netif, skb);
 
 		if(likely(-ENOMEM != ref_num)) {
@@ -903,8 +907,17 @@ static const struct net_device_ops pfeng_netdev_ops = {
 	.ndo_set_rx_mode	= pfeng_netif_set_rx_mode,
 	.ndo_fix_features	= pfeng_netif_fix_features,
 	.ndo_tx_timeout		= pfeng_netif_tx_timeout,
+#ifdef PFE_CFG_PFE_MASTER
+	.ndo_get_port_parent_id	= pfeng_switchdev_get_port_parent_id,
+	.ndo_setup_tc		= pfeng_tc_setup,
+#endif /* PFE_CFG_PFE_MASTER */
 };
 
+bool pfeng_netif_is_pfeng(const struct net_device *netdev)
+{
+	return netdev->netdev_ops == &pfeng_netdev_ops;
+}
+
 static void pfeng_netif_detach_hifs(struct pfeng_netif *netif)
 {
 	struct net_device *netdev = netif->netdev;
@@ -957,6 +970,22 @@ err:
 	return ret;
 }
 
+/* Release the HIF channel logif once the last netif unlinks from it */
+static void pfeng_netif_unlink_hif_chnl(struct pfeng_netif *netif, struct pfeng_hif_chnl *chnl)
+{
+	pfe_log_if_t *logif = chnl->logif_hif;
+
+	if (logif && refcount_dec_and_test(&chnl->logif_hif_count)) {
+		pfe_log_if_disable(logif);
+		if (EOK != pfe_platform_unregister_log_if(netif->priv->pfe_platform, logif))
+			HM_MSG_NETDEV_WARN(netif->netdev, "Can't unregister HIF Logif\n");
+		else
+			pfe_log_if_destroy(logif);
+
+		chnl->logif_hif = NULL;
+	}
+}
+
 static void pfeng_netif_logif_remove(struct pfeng_netif *netif)
 {
 	pfe_log_if_t *logif;
@@ -1000,16 +1029,7 @@ static void pfeng_netif_logif_remove(struct pfeng_netif *netif)
 		if (!(netif->cfg->hifmap & (1 << i)))
 			continue;
 
-		logif = chnl->logif_hif;
-		if (logif && refcount_dec_and_test(&chnl->logif_hif_count)) {
-			pfe_log_if_disable(logif);
-			if (EOK != pfe_platform_unregister_log_if(netif->priv->pfe_platform, logif))
-				HM_MSG_NETDEV_WARN(netif->netdev, "Can't unregister HIF Logif\n");
-			else
-				pfe_log_if_destroy(logif);
-
-			chnl->logif_hif = NULL;
-		}
+		pfeng_netif_unlink_hif_chnl(netif, chnl);
 	}
 
 	HM_MSG_NETDEV_INFO(netif->netdev, "unregisted\n");
@@ -1026,9 +1046,92 @@ static void pfeng_netif_logif_remove(struct pfeng_netif *netif)
 	/* Detach netif from HIF(s) */
 	pfeng_netif_detach_hifs(netif);
 
+	pfeng_ethtool_rxnfc_release(netif);
+
 	free_netdev(netif->netdev);
 }
 
+/**
+ * @brief	Link the HIF channel physical and logical interfaces to the netif
+ * @param[in]	netif Net interface instance
+ * @param[in]	chnl HIF channel
+ * @return	0 OK
+ */
+static int pfeng_netif_link_hif_chnl(struct pfeng_netif *netif, struct pfeng_hif_chnl *chnl)
+{
+	struct net_device *netdev = netif->netdev;
+	struct pfeng_priv *priv = netif->priv;
+	struct pfeng_emac *emac = pfeng_netif_get_emac(netif);
+	char hifname[16];
+	int ret;
+
+	if (!chnl->phyif_hif) {
+		chnl->phyif_hif = pfe_platform_get_phy_if_by_id(priv->pfe_platform, pfeng_hif_ids[chnl->idx]);
+		if (!chnl->phyif_hif) {
+			HM_MSG_NETDEV_ERR(netdev, "Could not get HIF%u physical interface\n", chnl->idx);
+			return -EINVAL;
+		}
+	}
+
+	if (netif->cfg->hifs > 1) {
+#ifdef PFE_CFG_PFE_MASTER
+		/* Enable loadbalance for multi-HIF config */
+		ret = pfe_phy_if_loadbalance_enable(chnl->phyif_hif);
+		if (EOK != ret) {
+			HM_MSG_NETDEV_ERR(netdev, "Can't set loadbalancing mode to HIF%u\n", chnl->idx);
+			return -EINVAL;
+		} else
+			HM_MSG_NETDEV_INFO(netdev, "add HIF%u loadbalance\n", chnl->idx);
+#else
+		HM_MSG_NETDEV_WARN(netdev, "Can't set loadbalancing mode to HIF%u on SLAVE instance\n", chnl->idx);
+#endif
+	}
+
+	ret = pfe_phy_if_enable(chnl->phyif_hif);
+	if (EOK != ret) {
+		HM_MSG_NETDEV_ERR(netdev, "Can't enable HIF%u\n", chnl->idx);
+		return -EINVAL;
+	}
+	HM_MSG_NETDEV_INFO(netdev, "Enable HIF%u\n", chnl->idx);
+
+	if (!chnl->logif_hif) {
+		scnprintf(hifname, sizeof(hifname) - 1, "%s-logif", pfe_phy_if_get_name(chnl->phyif_hif));
+		chnl->logif_hif = pfe_log_if_create(chnl->phyif_hif, hifname);
+		if (!chnl->logif_hif) {
+			HM_MSG_NETDEV_ERR(netdev, "HIF Logif can't be created: %s\n", hifname);
+			return -EINVAL;
+		}
+
+		ret = pfe_platform_register_log_if(priv->pfe_platform, chnl->logif_hif);
+		if (ret) {
+			HM_MSG_NETDEV_ERR(netdev, "Can't register HIF Logif\n");
+			return -EINVAL;
+		}
+		refcount_set(&chnl->logif_hif_count, 1);
+		HM_MSG_NETDEV_DBG(netdev, "HIF Logif created: %s @%px\n", hifname, chnl->logif_hif);
+	} else {
+		refcount_inc(&chnl->logif_hif_count);
+		HM_MSG_NETDEV_DBG(netdev, "HIF Logif reused: %s @%px\n", hifname, chnl->logif_hif);
+	}
+
+	if (emac) {
+		if (pfeng_netif_is_aux(netif)) {
+			/* Make sure that HIF ingress traffic will be forwarded to respective EMAC */
+#ifdef PFE_CFG_PFE_MASTER
+			ret = pfe_log_if_set_egress_ifs(chnl->logif_hif, 1 << pfeng_emac_ids[netif->cfg->phyif_id]);
+#else
+			ret = pfe_log_if_add_egress_if(chnl->logif_hif, pfe_platform_get_phy_if_by_id(priv->pfe_platform, pfeng_emac_ids[netif->cfg->phyif_id]));
+#endif
+			if (EOK != ret) {
+				HM_MSG_NETDEV_ERR(netdev, "Can't set HIF egress interface\n");
+				return -EINVAL;
+			}
+		}
+	}
+
+	return 0;
+}
+
 /**
  * @brief	Fetch necessary PFE Platform interfaces
  * @param[in]	netif Net interface instance
@@ -1100,74 +1203,11 @@ static int pfeng_netif_control_platform_ifs(struct pfeng_netif *netif)
 
 	/* Prefetch linked HIF(s) */
 	pfeng_netif_for_each_chnl(netif, i, chnl) {
-		char hifname[16];
-
 		if (!(netif->cfg->hifmap & (1 << i)))
 			continue;
 
-		if (!chnl->phyif_hif) {
-			chnl->phyif_hif = pfe_platform_get_phy_if_by_id(priv->pfe_platform, pfeng_hif_ids[i]);
-			if (!chnl->phyif_hif) {
-				HM_MSG_NETDEV_ERR(netdev, "Could not get HIF%u physical interface\n", i);
-				goto err;
-			}
-		}
-
-		if (netif->cfg->hifs > 1) {
-#ifdef PFE_CFG_PFE_MASTER
-			/* Enable loadbalance for multi-HIF config */
-			ret = pfe_phy_if_loadbalance_enable(chnl->phyif_hif);
-			if (EOK != ret) {
-				HM_MSG_NETDEV_ERR(netdev, "Can't set loadbalancing mode to HIF%u\n", i);
-				goto err;
-			} else
-				HM_MSG_NETDEV_INFO(netdev, "add HIF%u loadbalance\n", i);
-#else
-			HM_MSG_NETDEV_WARN(netdev, "Can't set loadbalancing mode to HIF%u on SLAVE instance\n", i);
-#endif
-		}
-
-		ret = pfe_phy_if_enable(chnl->phyif_hif);
-		if (EOK != ret) {
-			HM_MSG_NETDEV_ERR(netdev, "Can't enable HIF%u\n", i);
+		if (pfeng_netif_link_hif_chnl(netif, chnl))
 			goto err;
-		}
-		HM_MSG_NETDEV_INFO(netdev, "Enable HIF%u\n", i);
-
-		if (!chnl->logif_hif) {
-			scnprintf(hifname, sizeof(hifname) - 1, "%s-logif", pfe_phy_if_get_name(chnl->phyif_hif));
-			chnl->logif_hif = pfe_log_if_create(chnl->phyif_hif, hifname);
-			if (!chnl->logif_hif) {
-				HM_MSG_NETDEV_ERR(netdev, "HIF Logif can't be created: %s\n", hifname);
-				goto err;
-			}
-
-			ret = pfe_platform_register_log_if(priv->pfe_platform, chnl->logif_hif);
-			if (ret) {
-				HM_MSG_NETDEV_ERR(netdev, "Can't register HIF Logif\n");
-				goto err;
-			}
-			refcount_set(&chnl->logif_hif_count, 1);
-			HM_MSG_NETDEV_DBG(netdev, "HIF Logif created: %s @%px\n", hifname, chnl->logif_hif);
-		} else {
-			refcount_inc(&chnl->logif_hif_count);
-			HM_MSG_NETDEV_DBG(netdev, "HIF Logif reused: %s @%px\n", hifname, chnl->logif_hif);
-		}
-
-		if (emac) {
-			if (pfeng_netif_is_aux(netif)) {
-				/* Make sure that HIF ingress traffic will be forwarded to respective EMAC */
-#ifdef PFE_CFG_PFE_MASTER
-				ret = pfe_log_if_set_egress_ifs(chnl->logif_hif, 1 << pfeng_emac_ids[netif->cfg->phyif_id]);
-#else
-				ret = pfe_log_if_add_egress_if(chnl->logif_hif, pfe_platform_get_phy_if_by_id(priv->pfe_platform, pfeng_emac_ids[netif->cfg->phyif_id]));
-#endif
-				if (EOK != ret) {
-					HM_MSG_NETDEV_ERR(netdev, "Can't set HIF egress interface\n");
-					goto err;
-				}
-			}
-		}
 	}
 
 #ifdef PFE_CFG_PFE_SLAVE
@@ -1468,6 +1508,10 @@ static struct pfeng_netif *pfeng_netif_logif_create(struct pfeng_priv *priv, str
 	netif->priv = priv;
 	netif->cfg = netif_cfg;
 	netif->phylink = NULL;
+	netif->priv_flags = PFENG_PRIV_FLAGS_DEFAULT;
+#ifdef PFE_CFG_PFE_MASTER
+	INIT_LIST_HEAD(&netif->rxnfc_rules);
+#endif /* PFE_CFG_PFE_MASTER */
 
 	/* Set up explicit device name based on platform names */
 	strlcpy(netdev->name, netif_cfg->name, IFNAMSIZ);
@@ -1504,6 +1548,11 @@ static struct pfeng_netif *pfeng_netif_logif_create(struct pfeng_priv *priv, str
 		netdev->hw_features |= NETIF_F_IP_CSUM | NETIF_F_IPV6_CSUM | NETIF_F_RXCSUM;
 	}
 	netdev->hw_features |= NETIF_F_SG;
+#ifdef PFE_CFG_PFE_MASTER
+	/* tc flower and ntuple rules are offloaded into the EMAC classifier */
+	if (pfeng_netif_cfg_has_emac(netif->cfg))
+		netdev->hw_features |= NETIF_F_HW_TC | NETIF_F_NTUPLE;
+#endif
 	netdev->features = netdev->hw_features;
 #ifdef PFE_CFG_PFE_MASTER
 	netdev->priv_flags |= IFF_UNICAST_FLT;
@@ -1557,6 +1606,168 @@ err_netdev_reg:
 	return NULL;
 }
 
+#ifdef PFE_CFG_PFE_MASTER
+/* (Un)subscribe the netif to HIF channel possibly shared with other netifs */
+static void pfeng_netif_chnl_subscribe(struct pfeng_netif *netif, struct pfeng_hif_chnl *chnl, bool subscribe)
+{
+	struct pfeng_netif *users[PFENG_NETIFS_CNT];
+	int i, n = 0;
+
+	for (i = 0; i < PFENG_NETIFS_CNT; i++) {
+		if (chnl->netifs[i] && chnl->netifs[i] != netif)
+			users[n++] = chnl->netifs[i];
+	}
+
+	/* Sharing state guarding the TX lock can't change under a running xmit */
+	for (i = 0; i < n; i++)
+		netif_tx_disable(users[i]->netdev);
+
+	if (subscribe) {
+		chnl->netifs[netif->cfg->phyif_id] = netif;
+		if (n)
+			chnl->refcount++;
+		HM_MSG_NETDEV_INFO(netif->netdev, "Subscribe to HIF%u\n", chnl->idx);
+	} else {
+		chnl->netifs[netif->cfg->phyif_id] = NULL;
+		if (n)
+			chnl->refcount--;
+		HM_MSG_NETDEV_INFO(netif->netdev, "Unsubscribe from HIF%u\n", chnl->idx);
+	}
+
+	for (i = 0; i < n; i++) {
+		if (netif_running(users[i]->netdev))
+			netif_tx_wake_all_queues(users[i]->netdev);
+	}
+}
+
+/* Frames egressing to PFE_PHY_IF_ID_HIF are spread among loadbalancing HIFs */
+static void pfeng_netif_update_loadbalance(struct pfeng_netif *netif, u32 chnls)
+{
+	struct pfeng_priv *priv = netif->priv;
+	struct pfeng_hif_chnl *chnl;
+	struct pfeng_netif *user;
+	bool lb;
+	int i;
+
+	pfeng_netif_for_each_chnl(netif, i, chnl) {
+		if (!(chnls & (1 << i)) || !chnl->phyif_hif)
+			continue;
+
+		lb = false;
+		list_for_each_entry(user, &priv->netif_list, lnode) {
+			if (user->cfg->hifs > 1 && (user->cfg->hifmap & (1 << i)))
+				lb = true;
+		}
+
+		if (lb)
+			pfe_phy_if_loadbalance_enable(chnl->phyif_hif);
+		else
+			pfe_phy_if_loadbalance_disable(chnl->phyif_hif);
+	}
+}
+
+/**
+ * @brief	Change the set of HIF channels serving the netif
+ * @details	Channels are limited to the ones instantiated by the platform
+ *		(union of the DT configured maps). New channels are linked and
+ *		started before the EMAC logif egress is switched to them, the
+ *		removed ones are released afterwards. Must be called under rtnl.
+ * @param[in]	netif Net interface instance
+ * @param[in]	hifmap New bitmap of the HIF channels
+ * @return	0 OK
+ */
+int pfeng_netif_set_hifmap(struct pfeng_netif *netif, u32 hifmap)
+{
+	struct net_device *netdev = netif->netdev;
+	struct pfeng_priv *priv = netif->priv;
+	pfe_log_if_t *logif_emac = pfeng_netif_get_emac_logif(netif);
+	u32 old_hifmap = netif->cfg->hifmap;
+	u8 old_hifs = netif->cfg->hifs;
+	struct pfeng_hif_chnl *chnl;
+	u32 linked = 0, egress;
+	int ret = 0, i;
+
+	if (!logif_emac || pfeng_netif_is_aux(netif))
+		return -EOPNOTSUPP;
+
+	if (hifmap == old_hifmap)
+		return 0;
+
+	if (!hifmap || (hifmap & ~(u32)priv->pfe_cfg->hif_chnls_mask))
+		return -EINVAL;
+
+	/* TX channel is derived from the hifmap */
+	netif_tx_disable(netdev);
+
+	netif->cfg->hifmap = hifmap;
+	netif->cfg->hifs = hweight32(hifmap);
+
+	/* Bring up the new channels before the classifier starts to use them */
+	pfeng_netif_for_each_chnl(netif, i, chnl) {
+		if (!(hifmap & ~old_hifmap & (1 << i)))
+			continue;
+
+		if (chnl->status < PFENG_HIF_STATUS_ENABLED || chnl->ihc) {
+			HM_MSG_NETDEV_ERR(netdev, "HIF%u is not available\n", i);
+			ret = -EINVAL;
+			goto err;
+		}
+
+		ret = pfeng_netif_link_hif_chnl(netif, chnl);
+		if (ret)
+			goto err;
+		linked |= 1 << i;
+
+		pfeng_netif_chnl_subscribe(netif, chnl, true);
+		if (netif_running(netdev) && chnl->status == PFENG_HIF_STATUS_ENABLED)
+			pfeng_hif_chnl_start(chnl);
+	}
+
+	pfeng_netif_update_loadbalance(netif, hifmap | old_hifmap);
+
+	if (netif->cfg->hifs > 1)
+		egress = 1 << PFE_PHY_IF_ID_HIF;
+	else
+		egress = 1 << pfeng_hif_ids[ffs(hifmap) - 1];
+	ret = -pfe_log_if_set_egress_ifs(logif_emac, egress);
+	if (ret) {
+		HM_MSG_NETDEV_ERR(netdev, "Can't set EMAC egress interface\n");
+		goto err;
+	}
+
+	/* Release the channels no more used for the netif ingress */
+	pfeng_netif_for_each_chnl(netif, i, chnl) {
+		if (!(old_hifmap & ~hifmap & (1 << i)))
+			continue;
+
+		pfeng_netif_chnl_subscribe(netif, chnl, false);
+		pfeng_netif_unlink_hif_chnl(netif, chnl);
+	}
+
+	netif_set_real_num_rx_queues(netdev, netif->cfg->hifs);
+	HM_MSG_NETDEV_INFO(netdev, "HIFs: count %d map %02x\n", netif->cfg->hifs, netif->cfg->hifmap);
+
+	goto out;
+
+err:
+	pfeng_netif_for_each_chnl(netif, i, chnl) {
+		if (!(linked & (1 << i)))
+			continue;
+
+		pfeng_netif_chnl_subscribe(netif, chnl, false);
+		pfeng_netif_unlink_hif_chnl(netif, chnl);
+	}
+	netif->cfg->hifmap = old_hifmap;
+	netif->cfg->hifs = old_hifs;
+	pfeng_netif_update_loadbalance(netif, hifmap | old_hifmap);
+out:
+	if (netif_running(netdev))
+		netif_tx_wake_all_queues(netdev);
+
+	return ret;
+}
+#endif /* PFE_CFG_PFE_MASTER */
+
 void pfeng_netif_remove(struct pfeng_priv *priv)
 {
 	struct pfeng_netif *netif, *tmp;
@@ -113,6 +113,7 @@ static struct pfeng_priv *pfeng_drv_alloc(struct platform_device *pdev)
 	/* cfg defaults */
 	priv->msg_enable = default_msg_level;
 	priv->msg_verbosity = msg_verbosity;
+	priv->rx_coalesce_usecs = PFENG_INT_TIMER_DEFAULT;
 
 	priv->ihc_wq = create_singlethread_workqueue("pfeng-ihc-slave");
 	if (!priv->ihc_wq) {
@@ -0,0 +1,786 @@
+/*
+ * Copyright 2023 NXP
+ *
+ * SPDX-License-Identifier: GPL-2.0
+ *
+ */
+
+#include <linux/netdevice.h>
+#include <linux/rtnetlink.h>
+#include <linux/if_bridge.h>
+#include <linux/hashtable.h>
+#include <linux/jhash.h>
+#include <linux/workqueue.h>
+#include <net/switchdev.h>
+
+#include "pfe_cfg.h"
+#include "oal.h"
+#include "pfe_platform.h"
+#include "pfeng.h"
+
+#if IS_ENABLED(CONFIG_NET_SWITCHDEV) && (LINUX_VERSION_CODE >= KERNEL_VERSION(5,15,0))
+
+#define PFENG_SWITCHDEV_LEARNED_BITS	8
+
+/* FDB entry learned by the PFE and reported to the Linux bridge */
+struct pfeng_switchdev_learned {
+	struct hlist_node		hnode;
+	struct net_device		*netdev;
+	u8				addr[ETH_ALEN];
+	u16				vlan;
+	u16				vid;
+};
+
+/* Deferred MAC table change (reported with the MAC table locks held) */
+struct pfeng_switchdev_learn_work {
+	struct work_struct		work;
+	struct pfeng_switchdev		*sw;
+	pfe_l2br_table_event_t		event;
+	u8				addr[ETH_ALEN];
+	u16				vlan;
+	u32				forward_list;
+	bool				is_static;
+};
+
+/* Deferred FDB event (switchdev FDB notifications come in atomic context) */
+struct pfeng_switchdev_fdb_work {
+	struct work_struct		work;
+	struct pfeng_switchdev		*sw;
+	struct net_device		*netdev;
+	unsigned long			event;
+	u8				addr[ETH_ALEN];
+	u16				vid;
+};
+
+struct pfeng_switchdev {
+	struct pfeng_priv		*priv;
+	struct workqueue_struct		*wq;
+	struct notifier_block		netdev_nb;
+	struct notifier_block		switchdev_nb;
+	struct notifier_block		switchdev_blocking_nb;
+	pfe_l2br_table_t		*mactab;
+	DECLARE_HASHTABLE(learned, PFENG_SWITCHDEV_LEARNED_BITS);
+	unsigned int			bridged_cnt;
+};
+
+/* Safe in atomic context, the netif list is not walked */
+static struct pfeng_netif *pfeng_switchdev_find_netif(struct pfeng_priv *priv, const struct net_device *netdev)
+{
+	struct pfeng_netif *netif;
+
+	if (!netdev || !pfeng_netif_is_pfeng(netdev))
+		return NULL;
+
+	netif = netdev_priv(netdev);
+	if (netif->priv != priv)
+		return NULL;
+
+	return netif;
+}
+
+static struct pfeng_netif *pfeng_switchdev_find_netif_by_phyif_id(struct pfeng_priv *priv, u32 phyif_id)
+{
+	struct pfeng_netif *netif;
+
+	list_for_each_entry(netif, &priv->netif_list, lnode) {
+		if (netif->brport_dev && netif->cfg->phyif_id == phyif_id)
+			return netif;
+	}
+
+	return NULL;
+}
+
+/* Translate bridge VID into PFE bridge domain VLAN (VID 0 means untagged = default domain) */
+static u16 pfeng_switchdev_vid_to_vlan(struct pfeng_priv *priv, u16 vid)
+{
+	pfe_l2br_domain_t *domain;
+	u16 vlan = vid;
+
+	if (!vid) {
+		domain = pfe_l2br_get_default_domain(priv->pfe_platform->l2_bridge);
+		if (!domain || pfe_l2br_domain_get_vlan(domain, &vlan) != EOK)
+			vlan = 1;
+	}
+
+	return vlan;
+}
+
+static u16 pfeng_switchdev_vlan_to_vid(struct pfeng_netif *netif, u16 vlan)
+{
+	/* VLAN unaware bridge knows the entries as untagged */
+	if (!br_vlan_enabled(netif->brport_dev))
+		return 0;
+
+	return vlan;
+}
+
+static bool pfeng_switchdev_port_dev_check(const struct net_device *netdev)
+{
+	struct pfeng_netif *netif;
+
+	if (!netdev || netdev->reg_state == NETREG_UNINITIALIZED)
+		return false;
+
+	if (!pfeng_netif_is_pfeng(netdev))
+		return false;
+
+	netif = netdev_priv(netdev);
+	return netif->brport_dev && pfeng_netif_get_emac_phyif(netif);
+}
+
+/* FDB */
+
+static int pfeng_switchdev_fdb_add(struct pfeng_netif *netif, const u8 *addr, u16 vid)
+{
+	struct pfeng_priv *priv = netif->priv;
+	pfe_l2br_t *bridge = priv->pfe_platform->l2_bridge;
+	pfe_phy_if_t *phyif = pfeng_netif_get_emac_phyif(netif);
+	pfe_l2br_static_entry_t *entry;
+	u16 vlan = pfeng_switchdev_vid_to_vlan(priv, vid);
+	u32 fw_list;
+	errno_t ret;
+
+	if (!phyif)
+		return -ENODEV;
+
+	fw_list = 1U << pfe_phy_if_get_id(phyif);
+
+	entry = pfe_l2br_static_entry_get_first(bridge, L2SENT_CRIT_BY_MAC_VLAN, (void *)(addr_t)vlan, (void *)addr);
+	if (entry)
+		ret = pfe_l2br_static_entry_replace_fw_list(bridge, entry, fw_list);
+	else
+		ret = pfe_l2br_static_entry_create(bridge, vlan, addr, fw_list);
+
+	return -ret;
+}
+
+static int pfeng_switchdev_fdb_del(struct pfeng_netif *netif, const u8 *addr, u16 vid)
+{
+	struct pfeng_priv *priv = netif->priv;
+	pfe_l2br_t *bridge = priv->pfe_platform->l2_bridge;
+	pfe_l2br_static_entry_t *entry;
+	u16 vlan = pfeng_switchdev_vid_to_vlan(priv, vid);
+
+	entry = pfe_l2br_static_entry_get_first(bridge, L2SENT_CRIT_BY_MAC_VLAN, (void *)(addr_t)vlan, (void *)addr);
+	if (!entry)
+		return -ENOENT;
+
+	return -pfe_l2br_static_entry_destroy(bridge, entry);
+}
+
+static void pfeng_switchdev_fdb_offloaded(struct net_device *netdev, const u8 *addr, u16 vid)
+{
+	struct switchdev_notifier_fdb_info info = { 0 };
+
+	info.addr = addr;
+	info.vid = vid;
+	info.offloaded = true;
+	call_switchdev_notifiers(SWITCHDEV_FDB_OFFLOADED, netdev, &info.info, NULL);
+}
+
+static void pfeng_switchdev_fdb_work_handler(struct work_struct *work)
+{
+	struct pfeng_switchdev_fdb_work *fdb_work = container_of(work, struct pfeng_switchdev_fdb_work, work);
+	struct pfeng_priv *priv = fdb_work->sw->priv;
+	struct pfeng_netif *netif;
+	int ret = 0;
+
+	rtnl_lock();
+
+	netif = pfeng_switchdev_find_netif(priv, fdb_work->netdev);
+	if (!netif || !netif->brport_dev || priv->in_suspend)
+		goto out;
+
+	switch (fdb_work->event) {
+	case SWITCHDEV_FDB_ADD_TO_DEVICE:
+		ret = pfeng_switchdev_fdb_add(netif, fdb_work->addr, fdb_work->vid);
+		if (!ret)
+			pfeng_switchdev_fdb_offloaded(netif->netdev, fdb_work->addr, fdb_work->vid);
+		break;
+	case SWITCHDEV_FDB_DEL_TO_DEVICE:
+		ret = pfeng_switchdev_fdb_del(netif, fdb_work->addr, fdb_work->vid);
+		break;
+	}
+
+	if (ret && ret != -ENOENT)
+		HM_MSG_NETDEV_WARN(netif->netdev, "FDB %pM vid %u offload failed: %d\n",
+				   fdb_work->addr, fdb_work->vid, ret);
+
+out:
+	rtnl_unlock();
+	dev_put(fdb_work->netdev);
+	kfree(fdb_work);
+}
+
+static int pfeng_switchdev_event(struct notifier_block *nb, unsigned long event, void *ptr)
+{
+	struct pfeng_switchdev *sw = container_of(nb, struct pfeng_switchdev, switchdev_nb);
+	struct net_device *netdev = switchdev_notifier_info_to_dev(ptr);
+	struct switchdev_notifier_fdb_info *fdb_info;
+	struct pfeng_switchdev_fdb_work *fdb_work;
+
+	switch (event) {
+	case SWITCHDEV_FDB_ADD_TO_DEVICE:
+	case SWITCHDEV_FDB_DEL_TO_DEVICE:
+		if (!pfeng_switchdev_find_netif(sw->priv, netdev))
+			return NOTIFY_DONE;
+
+		fdb_info = container_of(ptr, struct switchdev_notifier_fdb_info, info);
+		if (!fdb_info->added_by_user || fdb_info->is_local)
+			return NOTIFY_DONE;
+
+		fdb_work = kzalloc(sizeof(*fdb_work), GFP_ATOMIC);
+		if (!fdb_work)
+			return NOTIFY_BAD;
+
+		INIT_WORK(&fdb_work->work, pfeng_switchdev_fdb_work_handler);
+		fdb_work->sw = sw;
+		fdb_work->event = event;
+		fdb_work->netdev = netdev;
+		fdb_work->vid = fdb_info->vid;
+		ether_addr_copy(fdb_work->addr, fdb_info->addr);
+
+		/* Keep the netdev around until the work is done */
+		dev_hold(netdev);
+		queue_work(sw->wq, &fdb_work->work);
+		break;
+	}
+
+	return NOTIFY_DONE;
+}
+
+/* VLAN objects / port attributes */
+
+static int pfeng_switchdev_vlan_add(struct pfeng_netif *netif, const struct switchdev_obj_port_vlan *vlan,
+				    struct netlink_ext_ack *extack)
+{
+	pfe_l2br_t *bridge = netif->priv->pfe_platform->l2_bridge;
+	pfe_phy_if_t *phyif = pfeng_netif_get_emac_phyif(netif);
+	bool tagged = !(vlan->flags & BRIDGE_VLAN_INFO_UNTAGGED);
+	pfe_l2br_domain_t *domain;
+	errno_t ret;
+
+	/* Untagged ingress traffic always goes to the default bridge domain, there is no per-port PVID */
+	if ((vlan->flags & BRIDGE_VLAN_INFO_PVID) &&
+	    vlan->vid != pfeng_switchdev_vid_to_vlan(netif->priv, 0)) {
+		NL_SET_ERR_MSG_MOD(extack, "PVID other than the default bridge domain VLAN is not supported");
+		return -EOPNOTSUPP;
+	}
+
+	domain = pfe_l2br_get_first_domain(bridge, L2BD_CRIT_BY_VLAN, (void *)(addr_t)vlan->vid);
+	if (!domain) {
+		ret = pfe_l2br_domain_create(bridge, vlan->vid);
+		if (ret != EOK)
+			return -ret;
+
+		domain = pfe_l2br_get_first_domain(bridge, L2BD_CRIT_BY_VLAN, (void *)(addr_t)vlan->vid);
+		if (!domain)
+			return -ENOENT;
+
+		/* Linux bridge semantics: forward known, flood unknown */
+		pfe_l2br_domain_set_ucast_action(domain, L2BR_ACT_FORWARD, L2BR_ACT_FLOOD);
+		pfe_l2br_domain_set_mcast_action(domain, L2BR_ACT_FLOOD, L2BR_ACT_FLOOD);
+	}
+
+	/* Re-adding updates the tagging of the interface */
+	if (pfe_l2br_domain_get_first_if(domain, L2BD_IF_BY_PHY_IF, phyif))
+		pfe_l2br_domain_del_if(domain, phyif);
+
+	ret = pfe_l2br_domain_add_if(domain, phyif, tagged ? TRUE : FALSE);
+
+	return -ret;
+}
+
+static int pfeng_switchdev_domain_remove_if(pfe_l2br_domain_t *domain, pfe_phy_if_t *phyif)
+{
+	errno_t ret;
+
+	ret = pfe_l2br_domain_del_if(domain, phyif);
+	if (ret != EOK)
+		return -ret;
+
+	pfe_l2br_domain_flush_by_if(domain, phyif);
+
+	/* Destroy domains left without any member */
+	if (!pfe_l2br_domain_get_if_list(domain) &&
+	    !pfe_l2br_domain_is_default(domain) &&
+	    !pfe_l2br_domain_is_fallback(domain))
+		ret = pfe_l2br_domain_destroy(domain);
+
+	return -ret;
+}
+
+static int pfeng_switchdev_vlan_del(struct pfeng_netif *netif, const struct switchdev_obj_port_vlan *vlan)
+{
+	pfe_l2br_t *bridge = netif->priv->pfe_platform->l2_bridge;
+	pfe_phy_if_t *phyif = pfeng_netif_get_emac_phyif(netif);
+	pfe_l2br_domain_t *domain;
+
+	domain = pfe_l2br_get_first_domain(bridge, L2BD_CRIT_BY_VLAN, (void *)(addr_t)vlan->vid);
+	if (!domain)
+		return 0;
+
+	return pfeng_switchdev_domain_remove_if(domain, phyif);
+}
+
+static int pfeng_switchdev_port_obj_add(struct net_device *netdev, const void *ctx,
+					const struct switchdev_obj *obj,
+					struct netlink_ext_ack *extack)
+{
+	struct pfeng_netif *netif = netdev_priv(netdev);
+
+	switch (obj->id) {
+	case SWITCHDEV_OBJ_ID_PORT_VLAN:
+		return pfeng_switchdev_vlan_add(netif, SWITCHDEV_OBJ_PORT_VLAN(obj), extack);
+	default:
+		return -EOPNOTSUPP;
+	}
+}
+
+static int pfeng_switchdev_port_obj_del(struct net_device *netdev, const void *ctx,
+					const struct switchdev_obj *obj)
+{
+	struct pfeng_netif *netif = netdev_priv(netdev);
+
+	switch (obj->id) {
+	case SWITCHDEV_OBJ_ID_PORT_VLAN:
+		return pfeng_switchdev_vlan_del(netif, SWITCHDEV_OBJ_PORT_VLAN(obj));
+	default:
+		return -EOPNOTSUPP;
+	}
+}
+
+static int pfeng_switchdev_port_attr_set(struct net_device *netdev, const void *ctx,
+					 const struct switchdev_attr *attr,
+					 struct netlink_ext_ack *extack)
+{
+	struct pfeng_netif *netif = netdev_priv(netdev);
+	pfe_phy_if_t *phyif = pfeng_netif_get_emac_phyif(netif);
+	pfe_ct_block_state_t block_state;
+
+	switch (attr->id) {
+	case SWITCHDEV_ATTR_ID_PORT_STP_STATE:
+		switch (attr->u.stp_state) {
+		case BR_STATE_FORWARDING:
+			block_state = IF_BS_FORWARDING;
+			break;
+		case BR_STATE_LEARNING:
+			block_state = IF_BS_LEARN_ONLY;
+			break;
+		default:
+			block_state = IF_BS_BLOCKED;
+			break;
+		}
+		return -pfe_phy_if_set_block_state(phyif, block_state);
+	case SWITCHDEV_ATTR_ID_BRIDGE_AGEING_TIME:
+	case SWITCHDEV_ATTR_ID_BRIDGE_VLAN_FILTERING:
+		/* Aging is driven by the PFE firmware, VLAN domains are always active */
+		return 0;
+	default:
+		return -EOPNOTSUPP;
+	}
+}
+
+static int pfeng_switchdev_blocking_event(struct notifier_block *nb, unsigned long event, void *ptr)
+{
+	struct net_device *netdev = switchdev_notifier_info_to_dev(ptr);
+	int err;
+
+	switch (event) {
+	case SWITCHDEV_PORT_OBJ_ADD:
+		err = switchdev_handle_port_obj_add(netdev, ptr, pfeng_switchdev_port_dev_check,
+						    pfeng_switchdev_port_obj_add);
+		return notifier_from_errno(err);
+	case SWITCHDEV_PORT_OBJ_DEL:
+		err = switchdev_handle_port_obj_del(netdev, ptr, pfeng_switchdev_port_dev_check,
+						    pfeng_switchdev_port_obj_del);
+		return notifier_from_errno(err);
+	case SWITCHDEV_PORT_ATTR_SET:
+		err = switchdev_handle_port_attr_set(netdev, ptr, pfeng_switchdev_port_dev_check,
+						     pfeng_switchdev_port_attr_set);
+		return notifier_from_errno(err);
+	}
+
+	return NOTIFY_DONE;
+}
+
+/* H/W learned entries */
+
+static struct pfeng_switchdev_learned *pfeng_switchdev_learned_find(struct pfeng_switchdev *sw,
+								    const u8 *addr, u16 vlan, u32 key)
+{
+	struct pfeng_switchdev_learned *le;
+
+	hash_for_each_possible(sw->learned, le, hnode, key) {
+		if (le->vlan == vlan && ether_addr_equal(le->addr, addr))
+			return le;
+	}
+
+	return NULL;
+}
+
+static void pfeng_switchdev_learned_notify(struct net_device *netdev, unsigned long event,
+					   const u8 *addr, u16 vid)
+{
+	struct switchdev_notifier_fdb_info info = { 0 };
+
+	info.addr = addr;
+	info.vid = vid;
+	info.offloaded = true;
+	call_switchdev_notifiers(event, netdev, &info.info, NULL);
+}
+
+static void pfeng_switchdev_learned_flush(struct pfeng_switchdev *sw, struct net_device *netdev, bool notify)
+{
+	struct pfeng_switchdev_learned *le;
+	struct hlist_node *tmp;
+	int bkt;
+
+	hash_for_each_safe(sw->learned, bkt, tmp, le, hnode) {
+		if (netdev && le->netdev != netdev)
+			continue;
+
+		if (notify)
+			pfeng_switchdev_learned_notify(le->netdev, SWITCHDEV_FDB_DEL_TO_BRIDGE, le->addr, le->vid);
+		hash_del(&le->hnode);
+		kfree(le);
+	}
+}
+
+static void pfeng_switchdev_learn_work_handler(struct work_struct *work)
+{
+	struct pfeng_switchdev_learn_work *learn_work = container_of(work, struct pfeng_switchdev_learn_work, work);
+	struct pfeng_switchdev *sw = learn_work->sw;
+	struct pfeng_switchdev_learned *le;
+	struct pfeng_netif *netif = NULL;
+	u32 key;
+
+	rtnl_lock();
+
+	if (!sw->bridged_cnt || sw->priv->in_suspend)
+		goto out;
+
+	key = jhash(learn_work->addr, ETH_ALEN, learn_work->vlan);
+	le = pfeng_switchdev_learned_find(sw, learn_work->addr, learn_work->vlan, key);
+
+	/* Static entries are owned by the bridge, only learned ones are reported */
+	if (learn_work->event != L2BR_TABLE_EVT_REMOVED && !learn_work->is_static && learn_work->forward_list)
+		netif = pfeng_switchdev_find_netif_by_phyif_id(sw->priv, __ffs(learn_work->forward_list));
+
+	if (le && (!netif || le->netdev != netif->netdev)) {
+		/* Aged out, replaced by a static entry or station moved to another port */
+		pfeng_switchdev_learned_notify(le->netdev, SWITCHDEV_FDB_DEL_TO_BRIDGE, le->addr, le->vid);
+		hash_del(&le->hnode);
+		kfree(le);
+		le = NULL;
+	}
+
+	if (netif && !le) {
+		le = kzalloc(sizeof(*le), GFP_KERNEL);
+		if (!le)
+			goto out;
+
+		ether_addr_copy(le->addr, learn_work->addr);
+		le->vlan = learn_work->vlan;
+		le->vid = pfeng_switchdev_vlan_to_vid(netif, learn_work->vlan);
+		le->netdev = netif->netdev;
+		hash_add(sw->learned, &le->hnode, key);
+		pfeng_switchdev_learned_notify(le->netdev, SWITCHDEV_FDB_ADD_TO_BRIDGE, le->addr, le->vid);
+	}
+
+out:
+	rtnl_unlock();
+	kfree(learn_work);
+}
+
+/* Called by the MAC table reconciliation for every change, including h/w learning and aging */
+static void pfeng_switchdev_mactab_event(void *arg, pfe_l2br_table_event_t event, const pfe_l2br_table_entry_t *entry)
+{
+	struct pfeng_switchdev *sw = arg;
+	struct pfeng_switchdev_learn_work *learn_work;
+	pfe_ct_mac_table_result_t result;
+
+	learn_work = kzalloc(sizeof(*learn_work), GFP_ATOMIC);
+	if (!learn_work)
+		return;
+
+	INIT_WORK(&learn_work->work, pfeng_switchdev_learn_work_handler);
+	learn_work->sw = sw;
+	learn_work->event = event;
+	learn_work->vlan = (u16)pfe_l2br_table_entry_get_vlan(entry);
+	learn_work->is_static = pfe_l2br_table_entry_is_static(entry);
+	result.val = (u32)pfe_l2br_table_entry_get_action_data(entry);
+	learn_work->forward_list = result.item.forward_list;
+	pfe_l2br_table_entry_get_mac_addr(entry, learn_work->addr);
+
+	queue_work(sw->wq, &learn_work->work);
+}
+
+/* Bridge port join/leave */
+
+static int pfeng_switchdev_port_join(struct pfeng_switchdev *sw, struct pfeng_netif *netif,
+				     struct net_device *brport_dev, struct netlink_ext_ack *extack)
+{
+	pfe_phy_if_t *phyif = pfeng_netif_get_emac_phyif(netif);
+	int ret;
+
+	if (!phyif) {
+		NL_SET_ERR_MSG_MOD(extack, "Only EMAC interfaces can be offloaded");
+		return -EOPNOTSUPP;
+	}
+
+	netif->brport_dev = brport_dev;
+	netif->saved_op_mode = pfe_phy_if_get_op_mode(phyif);
+
+	ret = -pfe_phy_if_set_op_mode(phyif, IF_OP_VLAN_BRIDGE);
+	if (ret)
+		goto err_op_mode;
+
+	ret = switchdev_bridge_port_offload(netif->netdev, netif->netdev, NULL,
+					    &sw->switchdev_nb, &sw->switchdev_blocking_nb,
+					    false, extack);
+	if (ret)
+		goto err_offload;
+
+	sw->bridged_cnt++;
+	HM_MSG_NETDEV_INFO(netif->netdev, "Bridge port offloaded to %s\n", brport_dev->name);
+
+	return 0;
+
+err_offload:
+	pfe_phy_if_set_op_mode(phyif, netif->saved_op_mode);
+err_op_mode:
+	netif->brport_dev = NULL;
+	return ret;
+}
+
+static void pfeng_switchdev_port_leave(struct pfeng_switchdev *sw, struct pfeng_netif *netif)
+{
+	pfe_phy_if_t *phyif = pfeng_netif_get_emac_phyif(netif);
+	pfe_l2br_domain_t *domain;
+	pfe_l2br_t *bridge;
+
+	if (!netif->brport_dev)
+		return;
+
+	switchdev_bridge_port_unoffload(netif->netdev, NULL,
+					&sw->switchdev_nb, &sw->switchdev_blocking_nb);
+
+	if (phyif && netif->priv->pfe_platform) {
+		bridge = netif->priv->pfe_platform->l2_bridge;
+
+		/* Drop the port from every bridge domain it was added to */
+		domain = pfe_l2br_get_first_domain(bridge, L2BD_BY_PHY_IF, phyif);
+		while (domain) {
+			pfeng_switchdev_domain_remove_if(domain, phyif);
+			domain = pfe_l2br_get_first_domain(bridge, L2BD_BY_PHY_IF, phyif);
+		}
+
+		pfe_phy_if_set_block_state(phyif, IF_BS_FORWARDING);
+		pfe_phy_if_set_op_mode(phyif, netif->saved_op_mode);
+	}
+
+	pfeng_switchdev_learned_flush(sw, netif->netdev, false);
+	netif->brport_dev = NULL;
+	sw->bridged_cnt--;
+
+	HM_MSG_NETDEV_INFO(netif->netdev, "Bridge port offload removed\n");
+}
+
+static int pfeng_switchdev_netdev_event(struct notifier_block *nb, unsigned long event, void *ptr)
+{
+	struct pfeng_switchdev *sw = container_of(nb, struct pfeng_switchdev, netdev_nb);
+	struct net_device *netdev = netdev_notifier_info_to_dev(ptr);
+	struct netdev_notifier_changeupper_info *info = ptr;
+	struct pfeng_netif *netif;
+	int ret = 0;
+
+	netif = pfeng_switchdev_find_netif(sw->priv, netdev);
+	if (!netif)
+		return NOTIFY_DONE;
+
+	switch (event) {
+	case NETDEV_CHANGEUPPER:
+		if (!netif_is_bridge_master(info->upper_dev))
+			break;
+
+		if (info->linking)
+			ret = pfeng_switchdev_port_join(sw, netif, info->upper_dev,
+							netdev_notifier_info_to_extack(&info->info));
+		else
+			pfeng_switchdev_port_leave(sw, netif);
+		break;
+	case NETDEV_UNREGISTER:
+		pfeng_switchdev_port_leave(sw, netif);
+		break;
+	}
+
+	return notifier_from_errno(ret);
+}
+
+int pfeng_switchdev_get_port_parent_id(struct net_device *netdev, struct netdev_phys_item_id *ppid)
+{
+	struct pfeng_netif *netif = netdev_priv(netdev);
+	u64 cbus_base = netif->priv->pfe_cfg->cbus_base;
+
+	/* All EMAC ports share the single PFE L2 bridge */
+	ppid->id_len = sizeof(cbus_base);
+	memcpy(ppid->id, &cbus_base, ppid->id_len);
+
+	return 0;
+}
+
+int pfeng_switchdev_create(struct pfeng_priv *priv)
+{
+	struct device *dev = &priv->pdev->dev;
+	struct pfeng_switchdev *sw;
+	int ret;
+
+	if (!priv->pfe_platform->l2_bridge) {
+		HM_MSG_DEV_INFO(dev, "L2 bridge not available, switchdev offload disabled\n");
+		return 0;
+	}
+
+	sw = kzalloc(sizeof(*sw), GFP_KERNEL);
+	if (!sw)
+		return -ENOMEM;
+
+	sw->priv = priv;
+	sw->mactab = priv->pfe_platform->mactab;
+	hash_init(sw->learned);
+
+	sw->wq = alloc_ordered_workqueue("pfeng-switchdev", 0);
+	if (!sw->wq) {
+		ret = -ENOMEM;
+		goto err_wq;
+	}
+
+	sw->switchdev_nb.notifier_call = pfeng_switchdev_event;
+	ret = register_switchdev_notifier(&sw->switchdev_nb);
+	if (ret) {
+		HM_MSG_DEV_ERR(dev, "Error registering the switchdev notifier: %d\n", ret);
+		goto err_sw_nb;
+	}
+
+	sw->switchdev_blocking_nb.notifier_call = pfeng_switchdev_blocking_event;
+	ret = register_switchdev_blocking_notifier(&sw->switchdev_blocking_nb);
+	if (ret) {
+		HM_MSG_DEV_ERR(dev, "Error registering the switchdev blocking notifier: %d\n", ret);
+		goto err_sw_blocking_nb;
+	}
+
+	sw->netdev_nb.notifier_call = pfeng_switchdev_netdev_event;
+	ret = register_netdevice_notifier(&sw->netdev_nb);
+	if (ret) {
+		HM_MSG_DEV_ERR(dev, "Error registering the bridge port notifier: %d\n", ret);
+		goto err_netdev_nb;
+	}
+
+	/* H/W learned entries are reported to the bridge as the MAC table changes */
+	ret = -pfe_l2br_table_register_event_cb(sw->mactab, pfeng_switchdev_mactab_event, sw);
+	if (ret) {
+		HM_MSG_DEV_ERR(dev, "Error registering the MAC table callback: %d\n", ret);
+		goto err_mactab_cb;
+	}
+
+	priv->switchdev = sw;
+
+	return 0;
+
+err_mactab_cb:
+	unregister_netdevice_notifier(&sw->netdev_nb);
+err_netdev_nb:
+	unregister_switchdev_blocking_notifier(&sw->switchdev_blocking_nb);
+err_sw_blocking_nb:
+	unregister_switchdev_notifier(&sw->switchdev_nb);
+err_sw_nb:
+	destroy_workqueue(sw->wq);
+err_wq:
+	kfree(sw);
+	return ret;
+}
+
+void pfeng_switchdev_remove(struct pfeng_priv *priv)
+{
+	struct pfeng_switchdev *sw = priv->switchdev;
+	struct pfeng_netif *netif;
+
+	if (!sw)
+		return;
+
+	unregister_netdevice_notifier(&sw->netdev_nb);
+	if (sw->mactab)
+		pfe_l2br_table_unregister_event_cb(sw->mactab, pfeng_switchdev_mactab_event, sw);
+
+	rtnl_lock();
+	list_for_each_entry(netif, &priv->netif_list, lnode)
+		pfeng_switchdev_port_leave(sw, netif);
+	pfeng_switchdev_learned_flush(sw, NULL, false);
+	rtnl_unlock();
+
+	unregister_switchdev_blocking_notifier(&sw->switchdev_blocking_nb);
+	unregister_switchdev_notifier(&sw->switchdev_nb);
+	destroy_workqueue(sw->wq);
+
+	priv->switchdev = NULL;
+	kfree(sw);
+}
+
+/* The MAC table is re-created on resume, without the entries learned before */
+void pfeng_switchdev_suspend(struct pfeng_priv *priv)
+{
+	struct pfeng_switchdev *sw = priv->switchdev;
+
+	if (!sw || !sw->mactab)
+		return;
+
+	pfe_l2br_table_unregister_event_cb(sw->mactab, pfeng_switchdev_mactab_event, sw);
+	sw->mactab = NULL;
+
+	rtnl_lock();
+	pfeng_switchdev_learned_flush(sw, NULL, true);
+	rtnl_unlock();
+}
+
+void pfeng_switchdev_resume(struct pfeng_priv *priv)
+{
+	struct pfeng_switchdev *sw = priv->switchdev;
+
+	if (!sw)
+		return;
+
+	sw->mactab = priv->pfe_platform->mactab;
+	if (pfe_l2br_table_register_event_cb(sw->mactab, pfeng_switchdev_mactab_event, sw) != EOK) {
+		HM_MSG_DEV_WARN(&priv->pdev->dev, "H/W learned FDB entries are not reported to the bridge\n");
+		sw->mactab = NULL;
+	}
+}
+
+#else /* CONFIG_NET_SWITCHDEV */
+
+int pfeng_switchdev_get_port_parent_id(struct net_device *netdev, struct netdev_phys_item_id *ppid)
+{
+	return -EOPNOTSUPP;
+}
+
+int pfeng_switchdev_create(struct pfeng_priv *priv)
+{
+	return 0;
+}
+
+void pfeng_switchdev_remove(struct pfeng_priv *priv)
+{
+	/* NOP */
+}
+
+void pfeng_switchdev_suspend(struct pfeng_priv *priv)
+{
+	/* NOP */
+}
+
+void pfeng_switchdev_resume(struct pfeng_priv *priv)
+{
+	/* NOP */
+}
+
+#endif /* CONFIG_NET_SWITCHDEV */
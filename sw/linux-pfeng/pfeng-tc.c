@@ -0,0 +1,1603 @@
+/*
+ * Copyright 2023 NXP
+ *
+ * SPDX-License-Identifier: GPL-2.0
+ *
+ */
+
+#include <linux/version.h>
+#include <linux/netdevice.h>
+#include <linux/if_vlan.h>
+#include <linux/hashtable.h>
+#include <linux/ip.h>
+#include <linux/ipv6.h>
+#include <net/flow_offload.h>
+#include <net/pkt_cls.h>
+
+#include "pfe_cfg.h"
+#include "oal.h"
+#include "pfe_platform.h"
+#include "pfe_fp.h"
+#include "pfe_mirror.h"
+#include "pfeng.h"
+
+#define PFENG_TC_FLOWS_BITS	8
+#define PFENG_TC_CLS_LOGIF_RULES	16
+#define PFENG_TC_CLS_FP_RULES	24
+/* Flowtable flows inserted into/removed from the routing table at once */
+#define PFENG_TC_FT_BATCH	16
+
+/* Flower match compiled for the classifier */
+struct pfeng_tc_cls_match {
+	struct {
+		pfe_ct_if_m_rules_t	rule;
+		u8			arg[16];
+		u8			len;
+	} m[PFENG_TC_CLS_LOGIF_RULES];
+	u32				m_cnt;
+	pfe_ct_fp_rule_t		fp[PFENG_TC_CLS_FP_RULES];
+	u32				fp_cnt;
+	/* All fields are expressible by the logif matching rules */
+	bool				exact;
+};
+
+/* Flower actions compiled for the classifier */
+struct pfeng_tc_cls_action {
+	/* Egress of redirected traffic, otherwise resolved when offloaded */
+	u32				egress;
+	bool				redirect;
+	bool				queue_set;
+	u32				queue;
+	bool				drop;
+	bool				mirror;
+	pfe_ct_phy_if_id_t		mirror_port;
+};
+
+/* Flower rule offloaded as a logical interface of the ingress EMAC */
+struct pfeng_tc_cls_flow {
+	struct hlist_node		hnode;
+	unsigned long			cookie;
+	struct pfeng_netif		*netif;
+	/* Parsed rule, kept to re-offload the tc block rules after resume */
+	struct pfeng_tc_cls_match	*match;
+	struct pfeng_tc_cls_action	act;
+	bool				keep;
+	/* NULL if the rule is not offloaded (suspended or not restored) */
+	pfe_log_if_t			*logif;
+	u32				fp_table;
+	pfe_mirror_t			*mirror;
+	u32				mirror_sel;
+	u32				last_accepted;
+	u64				lastused;
+};
+
+#if defined(PFE_CFG_RTABLE_ENABLE)
+
+/* Flowtable actions compiled for the routing table */
+struct pfeng_tc_ft_action {
+	pfe_ct_phy_if_id_t		egress;
+	bool				vlan_push;
+	bool				vlan_pop;
+	u16				vlan;
+	bool				eth_mangled;
+	u8				eth[2 * ETH_ALEN];
+	bool				sip_mangled;
+	bool				dip_mangled;
+	pfe_ip_addr_t			sip;
+	pfe_ip_addr_t			dip;
+	bool				sport_mangled;
+	bool				dport_mangled;
+	u16				sport;
+	u16				dport;
+};
+
+/* Flow offloaded by the nf_flowtable into the routing table */
+struct pfeng_tc_ft_flow {
+	struct hlist_node		hnode;
+	unsigned long			cookie;
+	pfe_5_tuple_t			tuple;
+	struct pfeng_tc_ft_action	action;
+	/* NULL if the flow could not be restored after resume */
+	pfe_rtable_entry_t		*entry;
+	u32				last_hit;
+	u32				last_hit_bytes;
+	u64				lastused;
+};
+
+#endif /* PFE_CFG_RTABLE_ENABLE */
+
+struct pfeng_tc {
+	struct pfeng_priv		*priv;
+	struct mutex			lock;
+#if defined(PFE_CFG_RTABLE_ENABLE)
+	DECLARE_HASHTABLE(ft_flows, PFENG_TC_FLOWS_BITS);
+#endif /* PFE_CFG_RTABLE_ENABLE */
+	DECLARE_HASHTABLE(cls_flows, PFENG_TC_FLOWS_BITS);
+	u32				cls_seq;
+};
+
+static LIST_HEAD(pfeng_tc_cls_block_cb_list);
+
+#if defined(PFE_CFG_RTABLE_ENABLE)
+
+static LIST_HEAD(pfeng_tc_ft_block_cb_list);
+
+static struct pfeng_tc_ft_flow *pfeng_tc_ft_flow_find(struct pfeng_tc *tc, unsigned long cookie)
+{
+	struct pfeng_tc_ft_flow *flow;
+
+	hash_for_each_possible(tc->ft_flows, flow, hnode, cookie) {
+		if (flow->cookie == cookie)
+			return flow;
+	}
+
+	return NULL;
+}
+
+/* Apply 32-bit pedit mangle (new = (old & mask) | val) onto a header copy */
+static int pfeng_tc_mangle(u8 *hdr, u32 hdr_len, const struct flow_action_entry *act)
+{
+	u32 offset = act->mangle.offset;
+	__be32 word;
+
+	if (offset + sizeof(word) > hdr_len)
+		return -EOPNOTSUPP;
+
+	memcpy(&word, hdr + offset, sizeof(word));
+	word = (word & (__force __be32)act->mangle.mask) | (__force __be32)act->mangle.val;
+	memcpy(hdr + offset, &word, sizeof(word));
+
+	return 0;
+}
+
+static int pfeng_tc_ft_parse_match(struct flow_rule *rule, pfe_5_tuple_t *tuple, int *ingress_ifindex)
+{
+	struct flow_match_basic basic;
+	struct flow_match_control control;
+	struct flow_match_ports ports;
+
+	memset(tuple, 0, sizeof(*tuple));
+
+	if (flow_rule_match_key(rule, FLOW_DISSECTOR_KEY_META)) {
+		struct flow_match_meta meta;
+
+		flow_rule_match_meta(rule, &meta);
+		*ingress_ifindex = meta.key->ingress_ifindex;
+	}
+
+	if (!flow_rule_match_key(rule, FLOW_DISSECTOR_KEY_BASIC) ||
+	    !flow_rule_match_key(rule, FLOW_DISSECTOR_KEY_CONTROL) ||
+	    !flow_rule_match_key(rule, FLOW_DISSECTOR_KEY_PORTS))
+		return -EOPNOTSUPP;
+
+	flow_rule_match_basic(rule, &basic);
+	if (basic.key->ip_proto != IPPROTO_TCP && basic.key->ip_proto != IPPROTO_UDP)
+		return -EOPNOTSUPP;
+	tuple->proto = basic.key->ip_proto;
+
+	flow_rule_match_control(rule, &control);
+	switch (control.key->addr_type) {
+	case FLOW_DISSECTOR_KEY_IPV4_ADDRS: {
+		struct flow_match_ipv4_addrs addrs;
+
+		flow_rule_match_ipv4_addrs(rule, &addrs);
+		memcpy(tuple->src_ip.v4.v4, &addrs.key->src, sizeof(addrs.key->src));
+		memcpy(tuple->dst_ip.v4.v4, &addrs.key->dst, sizeof(addrs.key->dst));
+		tuple->src_ip.is_ipv4 = TRUE;
+		tuple->dst_ip.is_ipv4 = TRUE;
+		break;
+	}
+	case FLOW_DISSECTOR_KEY_IPV6_ADDRS: {
+		struct flow_match_ipv6_addrs addrs;
+
+		flow_rule_match_ipv6_addrs(rule, &addrs);
+		memcpy(tuple->src_ip.v6.v6, &addrs.key->src, sizeof(addrs.key->src));
+		memcpy(tuple->dst_ip.v6.v6, &addrs.key->dst, sizeof(addrs.key->dst));
+		tuple->src_ip.is_ipv4 = FALSE;
+		tuple->dst_ip.is_ipv4 = FALSE;
+		break;
+	}
+	default:
+		return -EOPNOTSUPP;
+	}
+
+	flow_rule_match_ports(rule, &ports);
+	tuple->sport = ntohs(ports.key->src);
+	tuple->dport = ntohs(ports.key->dst);
+
+	return 0;
+}
+
+static int pfeng_tc_ft_parse_actions(struct flow_rule *rule, const pfe_5_tuple_t *tuple,
+				     struct pfeng_tc_ft_action *action)
+{
+	const struct flow_action_entry *act;
+	struct pfeng_netif *out_netif = NULL;
+	u8 eth[2 * ETH_ALEN], ip[sizeof(struct ipv6hdr)];
+	__be16 l4[2];
+	bool eth_mangled = false, ip_mangled = false, l4_mangled = false;
+	pfe_phy_if_t *phyif;
+	int i, ret;
+
+	memset(action, 0, sizeof(*action));
+
+	/* Seed header copies with the original values */
+	memset(eth, 0, sizeof(eth));
+	memset(ip, 0, sizeof(ip));
+	if (tuple->src_ip.is_ipv4) {
+		memcpy(ip + offsetof(struct iphdr, saddr), tuple->src_ip.v4.v4, 4);
+		memcpy(ip + offsetof(struct iphdr, daddr), tuple->dst_ip.v4.v4, 4);
+	} else {
+		memcpy(ip + offsetof(struct ipv6hdr, saddr), tuple->src_ip.v6.v6, 16);
+		memcpy(ip + offsetof(struct ipv6hdr, daddr), tuple->dst_ip.v6.v6, 16);
+	}
+	l4[0] = htons(tuple->sport);
+	l4[1] = htons(tuple->dport);
+
+	flow_action_for_each(i, act, &rule->action) {
+		switch (act->id) {
+		case FLOW_ACTION_MANGLE:
+			switch (act->mangle.htype) {
+			case FLOW_ACT_MANGLE_HDR_TYPE_ETH:
+				ret = pfeng_tc_mangle(eth, sizeof(eth), act);
+				eth_mangled = true;
+				break;
+			case FLOW_ACT_MANGLE_HDR_TYPE_IP4:
+			case FLOW_ACT_MANGLE_HDR_TYPE_IP6:
+				ret = pfeng_tc_mangle(ip, sizeof(ip), act);
+				ip_mangled = true;
+				break;
+			case FLOW_ACT_MANGLE_HDR_TYPE_TCP:
+			case FLOW_ACT_MANGLE_HDR_TYPE_UDP:
+				ret = pfeng_tc_mangle((u8 *)l4, sizeof(l4), act);
+				l4_mangled = true;
+				break;
+			default:
+				ret = -EOPNOTSUPP;
+				break;
+			}
+			if (ret)
+				return ret;
+			break;
+		case FLOW_ACTION_CSUM:
+			/* Checksums are always updated by the firmware */
+			break;
+		case FLOW_ACTION_VLAN_PUSH:
+			action->vlan_push = true;
+			action->vlan = act->vlan.vid;
+			break;
+		case FLOW_ACTION_VLAN_POP:
+			action->vlan_pop = true;
+			break;
+		case FLOW_ACTION_REDIRECT:
+			if (!act->dev || !pfeng_netif_is_pfeng(act->dev))
+				return -EOPNOTSUPP;
+			out_netif = netdev_priv(act->dev);
+			break;
+		default:
+			return -EOPNOTSUPP;
+		}
+	}
+
+	phyif = out_netif ? pfeng_netif_get_emac_phyif(out_netif) : NULL;
+	if (!phyif)
+		return -EOPNOTSUPP;
+
+	/* Interface IDs survive the platform restart, the instances do not */
+	action->egress = pfe_phy_if_get_id(phyif);
+
+	if (eth_mangled) {
+		action->eth_mangled = true;
+		memcpy(action->eth, eth, sizeof(eth));
+	}
+
+	if (ip_mangled) {
+		action->sip.is_ipv4 = tuple->src_ip.is_ipv4;
+		action->dip.is_ipv4 = tuple->src_ip.is_ipv4;
+		if (tuple->src_ip.is_ipv4) {
+			memcpy(action->sip.v4.v4, ip + offsetof(struct iphdr, saddr), 4);
+			action->sip_mangled = !!memcmp(action->sip.v4.v4, tuple->src_ip.v4.v4, 4);
+			memcpy(action->dip.v4.v4, ip + offsetof(struct iphdr, daddr), 4);
+			action->dip_mangled = !!memcmp(action->dip.v4.v4, tuple->dst_ip.v4.v4, 4);
+		} else {
+			memcpy(action->sip.v6.v6, ip + offsetof(struct ipv6hdr, saddr), 16);
+			action->sip_mangled = !!memcmp(action->sip.v6.v6, tuple->src_ip.v6.v6, 16);
+			memcpy(action->dip.v6.v6, ip + offsetof(struct ipv6hdr, daddr), 16);
+			action->dip_mangled = !!memcmp(action->dip.v6.v6, tuple->dst_ip.v6.v6, 16);
+		}
+	}
+
+	if (l4_mangled) {
+		action->sport = ntohs(l4[0]);
+		action->sport_mangled = action->sport != tuple->sport;
+		action->dport = ntohs(l4[1]);
+		action->dport_mangled = action->dport != tuple->dport;
+	}
+
+	return 0;
+}
+
+/* Build the routing table entry of the flow */
+static int pfeng_tc_ft_entry_build(const struct pfeng_tc_ft_flow *flow, pfe_rtable_entry_t **entry_out)
+{
+	const struct pfeng_tc_ft_action *action = &flow->action;
+	pfe_rtable_entry_t *entry;
+	int ret;
+
+	entry = pfe_rtable_entry_create();
+	if (!entry)
+		return -ENOMEM;
+
+	ret = -pfe_rtable_entry_set_5t(entry, &flow->tuple);
+	if (ret)
+		goto err;
+
+	ret = -pfe_rtable_entry_set_dstif_id(entry, action->egress);
+	if (ret)
+		goto err;
+
+	/* Routed flow */
+	pfe_rtable_entry_set_ttl_decrement(entry);
+
+	if (action->vlan_push)
+		pfe_rtable_entry_set_out_vlan(entry, action->vlan, FALSE);
+	if (action->vlan_pop)
+		pfe_rtable_entry_set_out_vlan_pop(entry);
+	if (action->eth_mangled)
+		pfe_rtable_entry_set_out_mac_addrs(entry, action->eth + ETH_ALEN, action->eth);
+	if (action->sip_mangled)
+		pfe_rtable_entry_set_out_sip(entry, &action->sip);
+	if (action->dip_mangled)
+		pfe_rtable_entry_set_out_dip(entry, &action->dip);
+	if (action->sport_mangled)
+		pfe_rtable_entry_set_out_sport(entry, action->sport);
+	if (action->dport_mangled)
+		pfe_rtable_entry_set_out_dport(entry, action->dport);
+
+	*entry_out = entry;
+
+	return 0;
+
+err:
+	pfe_rtable_entry_free(NULL, entry);
+	return ret;
+}
+
+/*
+ * Insert routing table entries of up to PFENG_TC_FT_BATCH flows at once. Flows which
+ * could not be offloaded are left without entry. Returns the first error.
+ */
+static int pfeng_tc_ft_flows_offload(struct pfeng_tc *tc, struct pfeng_tc_ft_flow **flows, u32 count)
+{
+	pfe_rtable_t *rtable = tc->priv->pfe_platform->rtable;
+	pfe_rtable_entry_t *entries[PFENG_TC_FT_BATCH];
+	struct pfeng_tc_ft_flow *built[PFENG_TC_FT_BATCH];
+	errno_t results[PFENG_TC_FT_BATCH];
+	u32 i, n = 0;
+	int ret = 0, err;
+
+	for (i = 0; i < count; i++) {
+		err = pfeng_tc_ft_entry_build(flows[i], &entries[n]);
+		if (err) {
+			ret = ret ? ret : err;
+			continue;
+		}
+		built[n++] = flows[i];
+	}
+
+	if (!n)
+		return ret;
+
+	/* Aging is driven by the flowtable using the reported stats */
+	(void)pfe_rtable_add_entries(rtable, entries, n, results);
+
+	for (i = 0; i < n; i++) {
+		if (results[i] != EOK) {
+			ret = ret ? ret : -results[i];
+			pfe_rtable_entry_free(NULL, entries[i]);
+			continue;
+		}
+
+		built[i]->entry = entries[i];
+		built[i]->last_hit = 0;
+		built[i]->last_hit_bytes = 0;
+	}
+
+	return ret;
+}
+
+/* Remove routing table entries of up to PFENG_TC_FT_BATCH flows at once, the flows are kept */
+static void pfeng_tc_ft_flows_unoffload(struct pfeng_tc *tc, struct pfeng_tc_ft_flow **flows, u32 count)
+{
+	pfe_rtable_t *rtable = tc->priv->pfe_platform->rtable;
+	pfe_rtable_entry_t *entries[PFENG_TC_FT_BATCH];
+	errno_t results[PFENG_TC_FT_BATCH];
+	u32 i, n = 0;
+
+	for (i = 0; i < count; i++) {
+		if (flows[i]->entry)
+			entries[n++] = flows[i]->entry;
+		flows[i]->entry = NULL;
+	}
+
+	if (!n)
+		return;
+
+	(void)pfe_rtable_del_entries(rtable, entries, n, results);
+
+	for (i = 0; i < n; i++) {
+		if (results[i] != EOK)
+			HM_MSG_DEV_WARN(&tc->priv->pdev->dev, "Flow entry removal failed\n");
+
+		/* The flow is gone from the driver, the entry must not stay behind */
+		pfe_rtable_entry_free(rtable, entries[i]);
+	}
+}
+
+/* Remove routing table entries of all flows */
+static void pfeng_tc_ft_unoffload_all(struct pfeng_tc *tc)
+{
+	struct pfeng_tc_ft_flow *flow, *batch[PFENG_TC_FT_BATCH];
+	u32 n = 0;
+	int bkt;
+
+	hash_for_each(tc->ft_flows, bkt, flow, hnode) {
+		if (!flow->entry)
+			continue;
+
+		batch[n++] = flow;
+		if (n == PFENG_TC_FT_BATCH) {
+			pfeng_tc_ft_flows_unoffload(tc, batch, n);
+			n = 0;
+		}
+	}
+
+	if (n)
+		pfeng_tc_ft_flows_unoffload(tc, batch, n);
+}
+
+static int pfeng_tc_ft_replace(struct pfeng_netif *netif, struct flow_cls_offload *f)
+{
+	struct pfeng_priv *priv = netif->priv;
+	struct pfeng_tc *tc = priv->tc;
+	struct flow_rule *rule = flow_cls_offload_flow_rule(f);
+	struct pfeng_tc_ft_flow *flow;
+	int ingress_ifindex = 0;
+	int ret;
+
+	if (pfeng_tc_ft_flow_find(tc, f->cookie))
+		return 0;
+
+	flow = kzalloc(sizeof(*flow), GFP_KERNEL);
+	if (!flow)
+		return -ENOMEM;
+
+	ret = pfeng_tc_ft_parse_match(rule, &flow->tuple, &ingress_ifindex);
+	if (ret)
+		goto err;
+
+	/* The flowtable block is shared, the flow belongs to its ingress port only */
+	if (ingress_ifindex && ingress_ifindex != netif->netdev->ifindex) {
+		ret = -EOPNOTSUPP;
+		goto err;
+	}
+
+	ret = pfeng_tc_ft_parse_actions(rule, &flow->tuple, &flow->action);
+	if (ret)
+		goto err;
+
+	ret = pfeng_tc_ft_flows_offload(tc, &flow, 1);
+	if (ret) {
+		HM_MSG_NETDEV_DBG(netif->netdev, "Flow offload failed: %d\n", ret);
+		goto err;
+	}
+
+	flow->cookie = f->cookie;
+	flow->lastused = jiffies;
+	hash_add(tc->ft_flows, &flow->hnode, flow->cookie);
+
+	return 0;
+
+err:
+	kfree(flow);
+	return ret;
+}
+
+static void pfeng_tc_ft_flow_destroy(struct pfeng_tc *tc, struct pfeng_tc_ft_flow *flow)
+{
+	hash_del(&flow->hnode);
+	pfeng_tc_ft_flows_unoffload(tc, &flow, 1);
+	kfree(flow);
+}
+
+static int pfeng_tc_ft_destroy(struct pfeng_netif *netif, struct flow_cls_offload *f)
+{
+	struct pfeng_tc *tc = netif->priv->tc;
+	struct pfeng_tc_ft_flow *flow;
+
+	flow = pfeng_tc_ft_flow_find(tc, f->cookie);
+	if (!flow)
+		return -ENOENT;
+
+	pfeng_tc_ft_flow_destroy(tc, flow);
+
+	return 0;
+}
+
+static int pfeng_tc_ft_stats(struct pfeng_netif *netif, struct flow_cls_offload *f)
+{
+	struct pfeng_priv *priv = netif->priv;
+	pfe_rtable_t *rtable = priv->pfe_platform->rtable;
+	pfe_ct_conntrack_stats_t stats;
+	struct pfeng_tc_ft_flow *flow;
+	u8 stats_index;
+	u64 pkts = 0, bytes = 0;
+
+	flow = pfeng_tc_ft_flow_find(priv->tc, f->cookie);
+	if (!flow || !flow->entry)
+		return -ENOENT;
+
+	/* Several ports may share the block, report the flow only once */
+	if (flow_rule_match_key(flow_cls_offload_flow_rule(f), FLOW_DISSECTOR_KEY_META)) {
+		struct flow_match_meta meta;
+
+		flow_rule_match_meta(flow_cls_offload_flow_rule(f), &meta);
+		if (meta.key->ingress_ifindex && meta.key->ingress_ifindex != netif->netdev->ifindex)
+			return -EOPNOTSUPP;
+	}
+
+	stats_index = pfe_rtable_entry_get_stats_index(flow->entry);
+	if (stats_index && pfe_rtable_get_stats(rtable, &stats, stats_index) == EOK) {
+		pkts = (u32)(stats.hit - flow->last_hit);
+		bytes = (u32)(stats.hit_bytes - flow->last_hit_bytes);
+		flow->last_hit = stats.hit;
+		flow->last_hit_bytes = stats.hit_bytes;
+	}
+
+	if (pkts || pfe_rtable_entry_is_active(rtable, flow->entry))
+		flow->lastused = jiffies;
+
+	flow_stats_update(&f->stats, bytes, pkts, 0, flow->lastused, FLOW_ACTION_HW_STATS_DELAYED);
+
+	return 0;
+}
+
+static int pfeng_tc_ft_setup_cb(enum tc_setup_type type, void *type_data, void *cb_priv)
+{
+	struct pfeng_netif *netif = cb_priv;
+	struct flow_cls_offload *f = type_data;
+	int ret;
+
+	if (type != TC_SETUP_CLSFLOWER)
+		return -EOPNOTSUPP;
+
+	if (netif->priv->in_suspend)
+		return -EBUSY;
+
+	mutex_lock(&netif->priv->tc->lock);
+
+	switch (f->command) {
+	case FLOW_CLS_REPLACE:
+		ret = pfeng_tc_ft_replace(netif, f);
+		break;
+	case FLOW_CLS_DESTROY:
+		ret = pfeng_tc_ft_destroy(netif, f);
+		break;
+	case FLOW_CLS_STATS:
+		ret = pfeng_tc_ft_stats(netif, f);
+		break;
+	default:
+		ret = -EOPNOTSUPP;
+		break;
+	}
+
+	mutex_unlock(&netif->priv->tc->lock);
+
+	return ret;
+}
+
+static bool pfeng_tc_cls_netif_has_flows(struct pfeng_tc *tc, struct pfeng_netif *netif)
+{
+	struct pfeng_tc_cls_flow *flow;
+	int bkt;
+
+	hash_for_each(tc->cls_flows, bkt, flow, hnode) {
+		if (flow->netif == netif)
+			return true;
+	}
+
+	return false;
+}
+
+/* Routing table lookup is performed only on interfaces in router mode */
+static int pfeng_tc_ft_bind(struct pfeng_netif *netif, bool bind, struct netlink_ext_ack *extack)
+{
+	pfe_phy_if_t *phyif = pfeng_netif_get_emac_phyif(netif);
+	struct pfeng_tc *tc = netif->priv->tc;
+	int ret = 0;
+
+	if (!phyif)
+		return -EOPNOTSUPP;
+
+	mutex_lock(&tc->lock);
+	if (bind) {
+		if (pfe_phy_if_get_op_mode(phyif) == IF_OP_DEFAULT) {
+			/* Logical interfaces are not matched in router mode */
+			if (pfeng_tc_cls_netif_has_flows(tc, netif)) {
+				NL_SET_ERR_MSG_MOD(extack, "Flowtable offload would disable classifier rules of the port");
+				ret = -EBUSY;
+			} else {
+				ret = -pfe_phy_if_set_op_mode(phyif, IF_OP_ROUTER);
+				netif->ft_router_mode = !ret;
+			}
+		}
+		/* Bridge/router mode already set by user */
+	} else if (netif->ft_router_mode) {
+		/* Restore only the mode changed by the bind */
+		if (pfe_phy_if_get_op_mode(phyif) == IF_OP_ROUTER)
+			ret = -pfe_phy_if_set_op_mode(phyif, IF_OP_DEFAULT);
+		netif->ft_router_mode = false;
+	}
+	mutex_unlock(&tc->lock);
+
+	return ret;
+}
+
+static int pfeng_tc_setup_ft(struct pfeng_netif *netif, struct flow_block_offload *f)
+{
+	struct pfeng_tc *tc = netif->priv->tc;
+	int ret;
+
+	if (!tc || !netif->priv->pfe_platform->rtable)
+		return -EOPNOTSUPP;
+
+	if (f->command == FLOW_BLOCK_BIND) {
+		ret = pfeng_tc_ft_bind(netif, true, f->extack);
+		if (ret)
+			return ret;
+	}
+
+	ret = flow_block_cb_setup_simple(f, &pfeng_tc_ft_block_cb_list, pfeng_tc_ft_setup_cb,
+					 netif, netif, true);
+
+	if (f->command == FLOW_BLOCK_BIND && ret)
+		pfeng_tc_ft_bind(netif, false, NULL);
+	else if (f->command == FLOW_BLOCK_UNBIND && !ret)
+		pfeng_tc_ft_bind(netif, false, NULL);
+
+	return ret;
+}
+
+#endif /* PFE_CFG_RTABLE_ENABLE */
+
+static struct pfeng_tc_cls_flow *pfeng_tc_cls_flow_find(struct pfeng_tc *tc, unsigned long cookie)
+{
+	struct pfeng_tc_cls_flow *flow;
+
+	hash_for_each_possible(tc->cls_flows, flow, hnode, cookie) {
+		if (flow->cookie == cookie)
+			return flow;
+	}
+
+	return NULL;
+}
+
+static int pfeng_tc_cls_add_logif(struct pfeng_tc_cls_match *match, pfe_ct_if_m_rules_t rule,
+				  const void *arg, u32 len)
+{
+	if (match->m_cnt >= PFENG_TC_CLS_LOGIF_RULES || len > sizeof(match->m[0].arg))
+		return -E2BIG;
+
+	match->m[match->m_cnt].rule = rule;
+	if (len)
+		memcpy(match->m[match->m_cnt].arg, arg, len);
+	match->m[match->m_cnt].len = len;
+	match->m_cnt++;
+
+	return 0;
+}
+
+/* Compare the field word by word, any mismatch rejects the frame */
+static int pfeng_tc_cls_add_fp(struct pfeng_tc_cls_match *match, const void *key, const void *mask,
+			       u32 len, u16 offset, pfe_ct_fp_flags_t flags)
+{
+	pfe_ct_fp_rule_t *fp;
+	u8 data[4], dmask[4];
+	u32 i, j, n;
+
+	for (i = 0; i < len; i += sizeof(data)) {
+		n = min_t(u32, len - i, sizeof(data));
+		memset(data, 0, sizeof(data));
+		memset(dmask, 0, sizeof(dmask));
+		memcpy(data, (const u8 *)key + i, n);
+		memcpy(dmask, (const u8 *)mask + i, n);
+		if (!memchr_inv(dmask, 0, sizeof(dmask)))
+			continue;
+
+		/* Keep the last slot for the final accept rule */
+		if (match->fp_cnt >= PFENG_TC_CLS_FP_RULES - 1)
+			return -E2BIG;
+
+		for (j = 0; j < sizeof(data); j++)
+			data[j] &= dmask[j];
+
+		/* Rule data are in network byte order */
+		fp = &match->fp[match->fp_cnt++];
+		memcpy(&fp->data, data, sizeof(fp->data));
+		memcpy(&fp->mask, dmask, sizeof(fp->mask));
+		fp->offset = htons(offset + i);
+		fp->next_idx = 0xffU;
+		fp->flags = (pfe_ct_fp_flags_t)(FP_FL_INVERT | FP_FL_REJECT | flags);
+	}
+
+	return 0;
+}
+
+/* Fully masked fields map to logif rules, the flexible parser takes the rest */
+static int pfeng_tc_cls_add_field(struct pfeng_tc_cls_match *match, pfe_ct_if_m_rules_t rule,
+				  const void *key, const void *mask, u32 len, u16 offset,
+				  pfe_ct_fp_flags_t flags)
+{
+	int ret;
+
+	if (!memchr_inv(mask, 0, len))
+		return 0;
+
+	if (!memchr_inv(mask, 0xff, len)) {
+		ret = pfeng_tc_cls_add_logif(match, rule, key, len);
+		if (ret)
+			return ret;
+	} else {
+		match->exact = false;
+	}
+
+	return pfeng_tc_cls_add_fp(match, key, mask, len, offset, flags);
+}
+
+static int pfeng_tc_cls_parse_match(struct flow_rule *rule, struct pfeng_tc_cls_match *match,
+				    struct netlink_ext_ack *extack)
+{
+	struct flow_dissector *dissector = rule->match.dissector;
+	u16 ethtype_offset = 2 * ETH_ALEN;
+	__be16 n_proto = 0;
+	u8 ip_proto = 0;
+	int ret;
+
+	memset(match, 0, sizeof(*match));
+	match->exact = true;
+
+	if (dissector->used_keys &
+	    ~(BIT_ULL(FLOW_DISSECTOR_KEY_CONTROL) |
+	      BIT_ULL(FLOW_DISSECTOR_KEY_BASIC) |
+	      BIT_ULL(FLOW_DISSECTOR_KEY_ETH_ADDRS) |
+	      BIT_ULL(FLOW_DISSECTOR_KEY_VLAN) |
+	      BIT_ULL(FLOW_DISSECTOR_KEY_IPV4_ADDRS) |
+	      BIT_ULL(FLOW_DISSECTOR_KEY_IPV6_ADDRS) |
+	      BIT_ULL(FLOW_DISSECTOR_KEY_PORTS))) {
+		NL_SET_ERR_MSG_MOD(extack, "Unsupported match key");
+		return -EOPNOTSUPP;
+	}
+
+	if (flow_rule_match_key(rule, FLOW_DISSECTOR_KEY_CONTROL)) {
+		struct flow_match_control control;
+
+		flow_rule_match_control(rule, &control);
+		if (control.mask->flags) {
+			NL_SET_ERR_MSG_MOD(extack, "Fragment matching is not supported");
+			return -EOPNOTSUPP;
+		}
+	}
+
+	if (flow_rule_match_key(rule, FLOW_DISSECTOR_KEY_ETH_ADDRS)) {
+		struct flow_match_eth_addrs eth;
+
+		flow_rule_match_eth_addrs(rule, &eth);
+		ret = pfeng_tc_cls_add_field(match, IF_MATCH_DMAC, eth.key->dst, eth.mask->dst,
+					     ETH_ALEN, 0, FP_FL_NONE);
+		if (ret)
+			return ret;
+		ret = pfeng_tc_cls_add_field(match, IF_MATCH_SMAC, eth.key->src, eth.mask->src,
+					     ETH_ALEN, ETH_ALEN, FP_FL_NONE);
+		if (ret)
+			return ret;
+	}
+
+	if (flow_rule_match_key(rule, FLOW_DISSECTOR_KEY_VLAN)) {
+		struct flow_match_vlan vlan;
+		__be16 tci, tci_mask;
+
+		flow_rule_match_vlan(rule, &vlan);
+		tci = htons(vlan.key->vlan_priority << VLAN_PRIO_SHIFT | vlan.key->vlan_id);
+		tci_mask = htons(vlan.mask->vlan_priority << VLAN_PRIO_SHIFT | vlan.mask->vlan_id);
+		tci &= tci_mask;
+
+		ret = pfeng_tc_cls_add_logif(match, IF_MATCH_TYPE_VLAN, NULL, 0);
+		if (ret)
+			return ret;
+		ret = pfeng_tc_cls_add_fp(match, &vlan.key->vlan_tpid, &vlan.mask->vlan_tpid,
+					  sizeof(__be16), 2 * ETH_ALEN, FP_FL_NONE);
+		if (ret)
+			return ret;
+
+		/* The logif matches the VLAN ID only */
+		if (tci_mask == htons(VLAN_VID_MASK))
+			ret = pfeng_tc_cls_add_logif(match, IF_MATCH_VLAN, &tci, sizeof(tci));
+		else if (tci_mask)
+			match->exact = false;
+		if (ret)
+			return ret;
+		ret = pfeng_tc_cls_add_fp(match, &tci, &tci_mask, sizeof(tci), 2 * ETH_ALEN + 2, FP_FL_NONE);
+		if (ret)
+			return ret;
+
+		ethtype_offset += VLAN_HLEN;
+	}
+
+	if (flow_rule_match_key(rule, FLOW_DISSECTOR_KEY_BASIC)) {
+		struct flow_match_basic basic;
+
+		flow_rule_match_basic(rule, &basic);
+		ret = pfeng_tc_cls_add_field(match, IF_MATCH_ETHTYPE, &basic.key->n_proto, &basic.mask->n_proto,
+					     sizeof(__be16), ethtype_offset, FP_FL_NONE);
+		if (ret)
+			return ret;
+
+		if (basic.mask->n_proto == htons(0xffff))
+			n_proto = basic.key->n_proto;
+
+		if (n_proto == htons(ETH_P_IP))
+			ret = pfeng_tc_cls_add_logif(match, IF_MATCH_TYPE_IPV4, NULL, 0);
+		else if (n_proto == htons(ETH_P_IPV6))
+			ret = pfeng_tc_cls_add_logif(match, IF_MATCH_TYPE_IPV6, NULL, 0);
+		if (ret)
+			return ret;
+
+		if (basic.mask->ip_proto) {
+			if (n_proto != htons(ETH_P_IP) && n_proto != htons(ETH_P_IPV6)) {
+				NL_SET_ERR_MSG_MOD(extack, "IP protocol match requires IPv4 or IPv6");
+				return -EOPNOTSUPP;
+			}
+
+			ret = pfeng_tc_cls_add_field(match, IF_MATCH_PROTO, &basic.key->ip_proto, &basic.mask->ip_proto,
+						     sizeof(u8), n_proto == htons(ETH_P_IP) ?
+						     offsetof(struct iphdr, protocol) : offsetof(struct ipv6hdr, nexthdr),
+						     FP_FL_L3_OFFSET);
+			if (ret)
+				return ret;
+
+			if (basic.mask->ip_proto == 0xffU)
+				ip_proto = basic.key->ip_proto;
+		}
+	}
+
+	if (flow_rule_match_key(rule, FLOW_DISSECTOR_KEY_IPV4_ADDRS)) {
+		struct flow_match_ipv4_addrs addrs;
+
+		if (n_proto != htons(ETH_P_IP)) {
+			NL_SET_ERR_MSG_MOD(extack, "IPv4 address match requires IPv4 protocol");
+			return -EOPNOTSUPP;
+		}
+
+		flow_rule_match_ipv4_addrs(rule, &addrs);
+		ret = pfeng_tc_cls_add_field(match, IF_MATCH_SIP, &addrs.key->src, &addrs.mask->src,
+					     sizeof(__be32), offsetof(struct iphdr, saddr), FP_FL_L3_OFFSET);
+		if (ret)
+			return ret;
+		ret = pfeng_tc_cls_add_field(match, IF_MATCH_DIP, &addrs.key->dst, &addrs.mask->dst,
+					     sizeof(__be32), offsetof(struct iphdr, daddr), FP_FL_L3_OFFSET);
+		if (ret)
+			return ret;
+	}
+
+	if (flow_rule_match_key(rule, FLOW_DISSECTOR_KEY_IPV6_ADDRS)) {
+		struct flow_match_ipv6_addrs addrs;
+
+		if (n_proto != htons(ETH_P_IPV6)) {
+			NL_SET_ERR_MSG_MOD(extack, "IPv6 address match requires IPv6 protocol");
+			return -EOPNOTSUPP;
+		}
+
+		flow_rule_match_ipv6_addrs(rule, &addrs);
+		ret = pfeng_tc_cls_add_field(match, IF_MATCH_SIP6, &addrs.key->src, &addrs.mask->src,
+					     sizeof(struct in6_addr), offsetof(struct ipv6hdr, saddr), FP_FL_L3_OFFSET);
+		if (ret)
+			return ret;
+		ret = pfeng_tc_cls_add_field(match, IF_MATCH_DIP6, &addrs.key->dst, &addrs.mask->dst,
+					     sizeof(struct in6_addr), offsetof(struct ipv6hdr, daddr), FP_FL_L3_OFFSET);
+		if (ret)
+			return ret;
+	}
+
+	if (flow_rule_match_key(rule, FLOW_DISSECTOR_KEY_PORTS)) {
+		struct flow_match_ports ports;
+
+		if (ip_proto != IPPROTO_TCP && ip_proto != IPPROTO_UDP) {
+			NL_SET_ERR_MSG_MOD(extack, "Port match requires TCP or UDP");
+			return -EOPNOTSUPP;
+		}
+
+		ret = pfeng_tc_cls_add_logif(match, ip_proto == IPPROTO_TCP ?
+					     IF_MATCH_TYPE_TCP : IF_MATCH_TYPE_UDP, NULL, 0);
+		if (ret)
+			return ret;
+
+		flow_rule_match_ports(rule, &ports);
+		ret = pfeng_tc_cls_add_field(match, IF_MATCH_SPORT, &ports.key->src, &ports.mask->src,
+					     sizeof(__be16), 0, FP_FL_L4_OFFSET);
+		if (ret)
+			return ret;
+		ret = pfeng_tc_cls_add_field(match, IF_MATCH_DPORT, &ports.key->dst, &ports.mask->dst,
+					     sizeof(__be16), sizeof(__be16), FP_FL_L4_OFFSET);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+static pfe_phy_if_t *pfeng_tc_cls_target_phyif(const struct flow_action_entry *act)
+{
+	if (!act->dev || !pfeng_netif_is_pfeng(act->dev))
+		return NULL;
+
+	return pfeng_netif_get_emac_phyif(netdev_priv(act->dev));
+}
+
+static int pfeng_tc_cls_parse_actions(struct pfeng_netif *netif, struct flow_rule *rule,
+				      struct pfeng_tc_cls_action *cls_act,
+				      struct netlink_ext_ack *extack)
+{
+	const struct flow_action_entry *act;
+	pfe_phy_if_t *phyif;
+	int i;
+
+	memset(cls_act, 0, sizeof(*cls_act));
+
+	flow_action_for_each(i, act, &rule->action) {
+		switch (act->id) {
+		case FLOW_ACTION_ACCEPT:
+			break;
+		case FLOW_ACTION_DROP:
+			cls_act->drop = true;
+			break;
+		case FLOW_ACTION_REDIRECT:
+			phyif = pfeng_tc_cls_target_phyif(act);
+			if (!phyif) {
+				NL_SET_ERR_MSG_MOD(extack, "Redirect target must be a PFE EMAC interface");
+				return -EOPNOTSUPP;
+			}
+			cls_act->egress = 1U << pfe_phy_if_get_id(phyif);
+			cls_act->redirect = true;
+			cls_act->queue_set = false;
+			break;
+		case FLOW_ACTION_MIRRED:
+			phyif = pfeng_tc_cls_target_phyif(act);
+			if (!phyif || cls_act->mirror) {
+				NL_SET_ERR_MSG_MOD(extack, "Single mirror to a PFE EMAC interface is supported");
+				return -EOPNOTSUPP;
+			}
+			cls_act->mirror = true;
+			cls_act->mirror_port = pfe_phy_if_get_id(phyif);
+			break;
+		case FLOW_ACTION_QUEUE:
+			/* ethtool ntuple ring_cookie */
+			if (pfeng_netif_rxq_to_chnl_idx(netif, act->queue.index) < 0) {
+				NL_SET_ERR_MSG_MOD(extack, "Rx queue is out of range");
+				return -EINVAL;
+			}
+			cls_act->queue = act->queue.index;
+			cls_act->queue_set = true;
+			cls_act->redirect = false;
+			break;
+#if LINUX_VERSION_CODE >= KERNEL_VERSION(6, 1, 0)
+		case FLOW_ACTION_RX_QUEUE_MAPPING:
+			if (pfeng_netif_rxq_to_chnl_idx(netif, act->rx_queue) < 0) {
+				NL_SET_ERR_MSG_MOD(extack, "Rx queue is out of range");
+				return -EINVAL;
+			}
+			cls_act->queue = act->rx_queue;
+			cls_act->queue_set = true;
+			cls_act->redirect = false;
+			break;
+#endif
+		case FLOW_ACTION_POLICE:
+			NL_SET_ERR_MSG_MOD(extack, "Policing is not supported by the classifier");
+			return -EOPNOTSUPP;
+		default:
+			NL_SET_ERR_MSG_MOD(extack, "Unsupported action");
+			return -EOPNOTSUPP;
+		}
+	}
+
+	return 0;
+}
+
+/* Rx queue to HIF channel mapping and the EMAC logif may change between offloads */
+static int pfeng_tc_cls_egress(struct pfeng_netif *netif, const struct pfeng_tc_cls_action *cls_act, u32 *egress)
+{
+	int idx;
+
+	if (cls_act->redirect) {
+		*egress = cls_act->egress;
+		return 0;
+	}
+
+	if (cls_act->queue_set) {
+		idx = pfeng_netif_rxq_to_chnl_idx(netif, cls_act->queue);
+		if (idx < 0)
+			return -EINVAL;
+		*egress = 1U << pfeng_hif_ids[idx];
+		return 0;
+	}
+
+	/* Not redirected traffic goes where the EMAC logif sends it */
+	if (pfe_log_if_get_egress_ifs(pfeng_netif_get_emac_logif(netif), egress) != EOK)
+		return -EINVAL;
+
+	return 0;
+}
+
+static int pfeng_tc_cls_fp_create(struct pfeng_priv *priv, struct pfeng_tc_cls_match *match, u32 *table)
+{
+	pfe_class_t *class = priv->pfe_platform->classifier;
+	pfe_ct_fp_rule_t *accept = &match->fp[match->fp_cnt];
+	u32 i;
+
+	/* Frames passing all the comparisons are accepted */
+	memset(accept, 0, sizeof(*accept));
+	accept->next_idx = 0xffU;
+	accept->flags = FP_FL_ACCEPT;
+
+	*table = pfe_fp_create_table(class, match->fp_cnt + 1);
+	if (!*table)
+		return -ENOMEM;
+
+	for (i = 0; i <= match->fp_cnt; i++) {
+		if (!pfe_fp_table_write_rule(class, *table, &match->fp[i], i)) {
+			pfe_fp_destroy_table(class, *table);
+			*table = 0;
+			return -EIO;
+		}
+	}
+
+	return 0;
+}
+
+static int pfeng_tc_cls_logif_setup(struct pfeng_tc_cls_flow *flow, struct pfeng_tc_cls_match *match,
+				    struct pfeng_tc_cls_action *cls_act)
+{
+	pfe_log_if_t *logif = flow->logif;
+	u32 i, fp_table, egress;
+	int ret;
+
+	ret = pfeng_tc_cls_egress(flow->netif, cls_act, &egress);
+	if (ret)
+		return ret;
+
+	ret = -pfe_log_if_set_match_and(logif);
+	if (ret)
+		return ret;
+
+	if (!match->m_cnt && !match->fp_cnt) {
+		/* Match-all rule */
+		ret = -pfe_log_if_promisc_enable(logif);
+		if (ret)
+			return ret;
+	}
+
+	for (i = 0; i < match->m_cnt; i++) {
+		/* The flexible parser table replaces the argument based rules */
+		if (flow->fp_table && match->m[i].len)
+			continue;
+
+		ret = -pfe_log_if_add_match_rule(logif, match->m[i].rule,
+						 match->m[i].len ? match->m[i].arg : NULL,
+						 match->m[i].len);
+		if (ret)
+			return ret;
+	}
+
+	if (flow->fp_table) {
+		fp_table = htonl(flow->fp_table);
+		ret = -pfe_log_if_add_match_rule(logif, IF_MATCH_FP0, &fp_table, sizeof(fp_table));
+		if (ret)
+			return ret;
+	}
+
+	ret = -pfe_log_if_set_egress_ifs(logif, egress);
+	if (ret)
+		return ret;
+
+	if (cls_act->drop)
+		ret = -pfe_log_if_discard_enable(logif);
+
+	return ret;
+}
+
+static int pfeng_tc_cls_mirror_attach(struct pfeng_tc_cls_flow *flow, pfe_phy_if_t *phyif,
+				      struct pfeng_tc_cls_action *cls_act)
+{
+	char name[IFNAMSIZ + 24];
+	u32 sel;
+	int ret;
+
+	for (sel = 0; sel < PFE_CT_MIRRORS_COUNT; sel++) {
+		if (!pfe_phy_if_get_rx_mirror(phyif, sel))
+			break;
+	}
+	if (sel == PFE_CT_MIRRORS_COUNT)
+		return -ENOSPC;
+
+	scnprintf(name, sizeof(name), "%s.m", pfe_log_if_get_name(flow->logif));
+	flow->mirror = pfe_mirror_create(name);
+	if (!flow->mirror)
+		return -ENOMEM;
+
+	ret = -pfe_mirror_set_egress_port(flow->mirror, cls_act->mirror_port);
+	if (!ret)
+		ret = -pfe_mirror_set_filter(flow->mirror, flow->fp_table);
+	if (!ret)
+		ret = -pfe_phy_if_set_rx_mirror(phyif, sel, flow->mirror);
+	if (ret) {
+		pfe_mirror_destroy(flow->mirror);
+		flow->mirror = NULL;
+		return ret;
+	}
+
+	flow->mirror_sel = sel;
+
+	return 0;
+}
+
+/* Release the classifier objects of the rule, the parsed rule is kept */
+static void pfeng_tc_cls_flow_unoffload(struct pfeng_tc *tc, struct pfeng_tc_cls_flow *flow)
+{
+	struct pfeng_priv *priv = tc->priv;
+
+	if (flow->mirror) {
+		pfe_phy_if_set_rx_mirror(pfeng_netif_get_emac_phyif(flow->netif), flow->mirror_sel, NULL);
+		pfe_mirror_destroy(flow->mirror);
+		flow->mirror = NULL;
+	}
+
+	if (flow->logif) {
+		pfe_log_if_disable(flow->logif);
+		if (pfe_platform_unregister_log_if(priv->pfe_platform, flow->logif) == EOK)
+			pfe_log_if_destroy(flow->logif);
+		else
+			HM_MSG_NETDEV_WARN(flow->netif->netdev, "Can't unregister tc Logif\n");
+		flow->logif = NULL;
+	}
+
+	/* The table is unreferenced once the logif and mirror are gone */
+	if (flow->fp_table) {
+		pfe_fp_destroy_table(priv->pfe_platform->classifier, flow->fp_table);
+		flow->fp_table = 0;
+	}
+}
+
+/* Create the classifier objects of the parsed rule */
+static int pfeng_tc_cls_flow_offload(struct pfeng_tc *tc, struct pfeng_tc_cls_flow *flow,
+				     struct netlink_ext_ack *extack)
+{
+	struct pfeng_priv *priv = tc->priv;
+	struct pfeng_netif *netif = flow->netif;
+	pfe_phy_if_t *phyif = pfeng_netif_get_emac_phyif(netif);
+	char name[IFNAMSIZ + 16];
+	int ret;
+
+	if (!phyif)
+		return -EOPNOTSUPP;
+
+	/* Partially masked fields and mirror filter are evaluated by the flexible parser */
+	if (!flow->match->exact || flow->act.mirror) {
+		ret = pfeng_tc_cls_fp_create(priv, flow->match, &flow->fp_table);
+		if (ret) {
+			NL_SET_ERR_MSG_MOD(extack, "Flexible parser table can't be created");
+			goto err;
+		}
+	}
+
+	scnprintf(name, sizeof(name), "%s.tc%u", netdev_name(netif->netdev), tc->cls_seq++);
+	flow->logif = pfe_log_if_create(phyif, name);
+	if (!flow->logif) {
+		ret = -ENOMEM;
+		goto err;
+	}
+	if (pfe_platform_register_log_if(priv->pfe_platform, flow->logif) != EOK) {
+		pfe_log_if_destroy(flow->logif);
+		flow->logif = NULL;
+		ret = -EINVAL;
+		goto err;
+	}
+
+	ret = pfeng_tc_cls_logif_setup(flow, flow->match, &flow->act);
+	if (ret)
+		goto err;
+
+	if (flow->act.mirror) {
+		ret = pfeng_tc_cls_mirror_attach(flow, phyif, &flow->act);
+		if (ret) {
+			NL_SET_ERR_MSG_MOD(extack, "No free mirror slot");
+			goto err;
+		}
+	}
+
+	ret = -pfe_log_if_enable(flow->logif);
+	if (ret)
+		goto err;
+
+	HM_MSG_NETDEV_DBG(netif->netdev, "Classifier rule offloaded as %s\n", name);
+
+	return 0;
+
+err:
+	pfeng_tc_cls_flow_unoffload(tc, flow);
+	return ret;
+}
+
+static void pfeng_tc_cls_flow_destroy(struct pfeng_tc *tc, struct pfeng_tc_cls_flow *flow)
+{
+	pfeng_tc_cls_flow_unoffload(tc, flow);
+
+	if (!hlist_unhashed(&flow->hnode))
+		hash_del(&flow->hnode);
+	kfree(flow->match);
+	kfree(flow);
+}
+
+static int __pfeng_tc_cls_rule_add(struct pfeng_netif *netif, unsigned long cookie,
+				   struct flow_rule *rule, bool keep, struct netlink_ext_ack *extack)
+{
+	struct pfeng_priv *priv = netif->priv;
+	struct pfeng_tc *tc = priv->tc;
+	pfe_phy_if_t *phyif = pfeng_netif_get_emac_phyif(netif);
+	struct pfeng_tc_cls_flow *flow;
+	pfe_ct_if_op_mode_t mode;
+	int ret;
+
+	if (!phyif)
+		return -EOPNOTSUPP;
+
+	if (pfeng_tc_cls_flow_find(tc, cookie)) {
+		NL_SET_ERR_MSG_MOD(extack, "Rule is already offloaded");
+		return -EEXIST;
+	}
+
+	/* Logical interfaces are matched in the default and flexible router modes only */
+	mode = pfe_phy_if_get_op_mode(phyif);
+	if (mode != IF_OP_DEFAULT && mode != IF_OP_FLEX_ROUTER) {
+		NL_SET_ERR_MSG_MOD(extack, netif->ft_router_mode ?
+				   "Port is in router mode for flowtable offload" :
+				   "EMAC operational mode does not use logical interfaces");
+		return -EBUSY;
+	}
+
+	flow = kzalloc(sizeof(*flow), GFP_KERNEL);
+	if (!flow)
+		return -ENOMEM;
+	flow->cookie = cookie;
+	flow->netif = netif;
+	flow->keep = keep;
+
+	flow->match = kzalloc(sizeof(*flow->match), GFP_KERNEL);
+	if (!flow->match) {
+		ret = -ENOMEM;
+		goto err;
+	}
+
+	ret = pfeng_tc_cls_parse_match(rule, flow->match, extack);
+	if (ret)
+		goto err;
+
+	ret = pfeng_tc_cls_parse_actions(netif, rule, &flow->act, extack);
+	if (ret)
+		goto err;
+
+	ret = pfeng_tc_cls_flow_offload(tc, flow, extack);
+	if (ret)
+		goto err;
+
+	flow->lastused = jiffies;
+	hash_add(tc->cls_flows, &flow->hnode, flow->cookie);
+
+	return 0;
+
+err:
+	pfeng_tc_cls_flow_destroy(tc, flow);
+	return ret;
+}
+
+static int __pfeng_tc_cls_rule_del(struct pfeng_netif *netif, unsigned long cookie)
+{
+	struct pfeng_tc *tc = netif->priv->tc;
+	struct pfeng_tc_cls_flow *flow;
+
+	flow = pfeng_tc_cls_flow_find(tc, cookie);
+	if (!flow)
+		return -ENOENT;
+
+	pfeng_tc_cls_flow_destroy(tc, flow);
+
+	return 0;
+}
+
+static int pfeng_tc_cls_stats(struct pfeng_netif *netif, struct flow_cls_offload *f)
+{
+	struct pfeng_tc_cls_flow *flow;
+	pfe_ct_class_algo_stats_t stats;
+	u64 pkts = 0;
+
+	flow = pfeng_tc_cls_flow_find(netif->priv->tc, f->cookie);
+	if (!flow)
+		return -ENOENT;
+
+	/* The classifier counts frames only */
+	if (flow->logif && pfe_log_if_get_stats(flow->logif, &stats) == EOK) {
+		pkts = (u32)(stats.accepted - flow->last_accepted);
+		flow->last_accepted = stats.accepted;
+	}
+
+	if (pkts)
+		flow->lastused = jiffies;
+
+	flow_stats_update(&f->stats, 0, pkts, 0, flow->lastused, FLOW_ACTION_HW_STATS_DELAYED);
+
+	return 0;
+}
+
+static int pfeng_tc_cls_setup_cb(enum tc_setup_type type, void *type_data, void *cb_priv)
+{
+	struct pfeng_netif *netif = cb_priv;
+	struct flow_cls_offload *f = type_data;
+	int ret;
+
+	if (type != TC_SETUP_CLSFLOWER)
+		return -EOPNOTSUPP;
+
+	if (netif->priv->in_suspend)
+		return -EBUSY;
+
+	if (!tc_cls_can_offload_and_chain0(netif->netdev, &f->common))
+		return -EOPNOTSUPP;
+
+	mutex_lock(&netif->priv->tc->lock);
+
+	switch (f->command) {
+	case FLOW_CLS_REPLACE:
+		ret = __pfeng_tc_cls_rule_add(netif, f->cookie, flow_cls_offload_flow_rule(f),
+					      true, f->common.extack);
+		break;
+	case FLOW_CLS_DESTROY:
+		ret = __pfeng_tc_cls_rule_del(netif, f->cookie);
+		break;
+	case FLOW_CLS_STATS:
+		ret = pfeng_tc_cls_stats(netif, f);
+		break;
+	default:
+		ret = -EOPNOTSUPP;
+		break;
+	}
+
+	mutex_unlock(&netif->priv->tc->lock);
+
+	return ret;
+}
+
+/**
+ * @brief	Offload classifier rule not managed by a tc block (e.g. ethtool ntuple)
+ * @param[in]	netif Ingress net interface
+ * @param[in]	cookie Unique rule identifier
+ * @param[in]	rule Match and actions of the rule
+ * @param[in]	extack Netlink extended ACK, can be NULL
+ * @return	0 OK
+ */
+int pfeng_tc_cls_rule_add(struct pfeng_netif *netif, unsigned long cookie,
+			  struct flow_rule *rule, struct netlink_ext_ack *extack)
+{
+	struct pfeng_tc *tc = netif->priv->tc;
+	int ret;
+
+	if (!tc || !pfeng_netif_get_emac_phyif(netif))
+		return -EOPNOTSUPP;
+
+	mutex_lock(&tc->lock);
+	ret = __pfeng_tc_cls_rule_add(netif, cookie, rule, false, extack);
+	mutex_unlock(&tc->lock);
+
+	return ret;
+}
+
+int pfeng_tc_cls_rule_del(struct pfeng_netif *netif, unsigned long cookie)
+{
+	struct pfeng_tc *tc = netif->priv->tc;
+	int ret;
+
+	if (!tc)
+		return -ENOENT;
+
+	mutex_lock(&tc->lock);
+	ret = __pfeng_tc_cls_rule_del(netif, cookie);
+	mutex_unlock(&tc->lock);
+
+	return ret;
+}
+
+static int pfeng_tc_setup_block(struct pfeng_netif *netif, struct flow_block_offload *f)
+{
+	if (!netif->priv->tc || !pfeng_netif_get_emac_phyif(netif))
+		return -EOPNOTSUPP;
+
+	return flow_block_cb_setup_simple(f, &pfeng_tc_cls_block_cb_list, pfeng_tc_cls_setup_cb,
+					  netif, netif, true);
+}
+
+int pfeng_tc_setup(struct net_device *netdev, enum tc_setup_type type, void *type_data)
+{
+	struct pfeng_netif *netif = netdev_priv(netdev);
+
+	switch (type) {
+	case TC_SETUP_BLOCK:
+		return pfeng_tc_setup_block(netif, type_data);
+#if defined(PFE_CFG_RTABLE_ENABLE)
+	case TC_SETUP_FT:
+		return pfeng_tc_setup_ft(netif, type_data);
+#endif /* PFE_CFG_RTABLE_ENABLE */
+	default:
+		return -EOPNOTSUPP;
+	}
+}
+
+int pfeng_tc_create(struct pfeng_priv *priv)
+{
+	struct pfeng_tc *tc;
+
+	tc = kzalloc(sizeof(*tc), GFP_KERNEL);
+	if (!tc)
+		return -ENOMEM;
+
+	tc->priv = priv;
+	mutex_init(&tc->lock);
+#if defined(PFE_CFG_RTABLE_ENABLE)
+	hash_init(tc->ft_flows);
+#endif /* PFE_CFG_RTABLE_ENABLE */
+	hash_init(tc->cls_flows);
+	priv->tc = tc;
+
+	return 0;
+}
+
+/*
+ * The platform is restarted by suspend/resume while nf_flowtable and tc still
+ * consider the flows and flower rules offloaded. Keep them, drop only their
+ * routing table entries and classifier objects.
+ */
+void pfeng_tc_suspend(struct pfeng_priv *priv)
+{
+	struct pfeng_tc *tc = priv->tc;
+	struct pfeng_tc_cls_flow *cls_flow;
+	struct hlist_node *tmp;
+	int bkt;
+
+	if (!tc)
+		return;
+
+	mutex_lock(&tc->lock);
+	if (priv->pfe_platform) {
+		/* Rules not kept here are restored with the netif RX rules */
+		hash_for_each_safe(tc->cls_flows, bkt, tmp, cls_flow, hnode) {
+			if (cls_flow->keep)
+				pfeng_tc_cls_flow_unoffload(tc, cls_flow);
+			else
+				pfeng_tc_cls_flow_destroy(tc, cls_flow);
+		}
+#if defined(PFE_CFG_RTABLE_ENABLE)
+		if (priv->pfe_platform->rtable)
+			pfeng_tc_ft_unoffload_all(tc);
+#endif /* PFE_CFG_RTABLE_ENABLE */
+	}
+	mutex_unlock(&tc->lock);
+}
+
+/*
+ * Re-offload the flows and flower rules kept by pfeng_tc_suspend(). Has to be
+ * called once the EMAC interfaces of the net interfaces are resumed.
+ */
+void pfeng_tc_resume(struct pfeng_priv *priv)
+{
+	struct pfeng_tc *tc = priv->tc;
+	struct pfeng_tc_cls_flow *cls_flow;
+#if defined(PFE_CFG_RTABLE_ENABLE)
+	struct pfeng_tc_ft_flow *flow, *batch[PFENG_TC_FT_BATCH];
+	struct pfeng_netif *netif;
+	pfe_phy_if_t *phyif;
+	u32 n = 0;
+#endif /* PFE_CFG_RTABLE_ENABLE */
+	int bkt, ret;
+
+	if (!tc || !priv->pfe_platform)
+		return;
+
+	mutex_lock(&tc->lock);
+	hash_for_each(tc->cls_flows, bkt, cls_flow, hnode) {
+		if (cls_flow->logif)
+			continue;
+
+		/* Left without logif the rule stops matching and reports no stats */
+		ret = pfeng_tc_cls_flow_offload(tc, cls_flow, NULL);
+		if (ret)
+			HM_MSG_NETDEV_WARN(cls_flow->netif->netdev, "Classifier rule restore failed: %d\n", ret);
+	}
+
+#if defined(PFE_CFG_RTABLE_ENABLE)
+	if (!priv->pfe_platform->rtable)
+		goto out;
+
+	/* The restarted platform dropped the router mode set by the flowtable bind */
+	list_for_each_entry(netif, &priv->netif_list, lnode) {
+		phyif = pfeng_netif_get_emac_phyif(netif);
+		if (!netif->ft_router_mode || !phyif)
+			continue;
+
+		if (pfe_phy_if_get_op_mode(phyif) == IF_OP_DEFAULT &&
+		    pfe_phy_if_set_op_mode(phyif, IF_OP_ROUTER) != EOK) {
+			HM_MSG_NETDEV_WARN(netif->netdev, "Router mode not restored\n");
+			netif->ft_router_mode = false;
+		}
+	}
+
+	hash_for_each(tc->ft_flows, bkt, flow, hnode) {
+		if (flow->entry)
+			continue;
+
+		batch[n++] = flow;
+		if (n < PFENG_TC_FT_BATCH)
+			continue;
+
+		/* Left without entry the flow stops reporting stats and the flowtable ages it out */
+		ret = pfeng_tc_ft_flows_offload(tc, batch, n);
+		if (ret)
+			HM_MSG_DEV_WARN(&priv->pdev->dev, "Flow restore failed: %d\n", ret);
+		n = 0;
+	}
+
+	if (n) {
+		ret = pfeng_tc_ft_flows_offload(tc, batch, n);
+		if (ret)
+			HM_MSG_DEV_WARN(&priv->pdev->dev, "Flow restore failed: %d\n", ret);
+	}
+
+out:
+#endif /* PFE_CFG_RTABLE_ENABLE */
+	mutex_unlock(&tc->lock);
+}
+
+void pfeng_tc_remove(struct pfeng_priv *priv)
+{
+	struct pfeng_tc *tc = priv->tc;
+	struct pfeng_tc_cls_flow *cls_flow;
+#if defined(PFE_CFG_RTABLE_ENABLE)
+	struct pfeng_tc_ft_flow *flow;
+#endif /* PFE_CFG_RTABLE_ENABLE */
+	struct hlist_node *tmp;
+	int bkt;
+
+	if (!tc)
+		return;
+
+	mutex_lock(&tc->lock);
+	if (priv->pfe_platform) {
+		hash_for_each_safe(tc->cls_flows, bkt, tmp, cls_flow, hnode)
+			pfeng_tc_cls_flow_destroy(tc, cls_flow);
+#if defined(PFE_CFG_RTABLE_ENABLE)
+		pfeng_tc_ft_unoffload_all(tc);
+		hash_for_each_safe(tc->ft_flows, bkt, tmp, flow, hnode)
+			pfeng_tc_ft_flow_destroy(tc, flow);
+#endif /* PFE_CFG_RTABLE_ENABLE */
+	}
+	mutex_unlock(&tc->lock);
+
+	mutex_destroy(&tc->lock);
+	priv->tc = NULL;
+	kfree(tc);
+}
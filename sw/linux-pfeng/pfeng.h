@@ -71,7 +71,12 @@ static const pfe_ct_phy_if_id_t pfeng_hif_ids[] = {
 	PFE_PHY_IF_ID_HIF3,
 	/* HIF NOCPY is unsupported, the id can be used
 	 * only for addressing master IDEX HIF channel
-	 * or linked HIF netdev
+	 * or linked HIF netdev. NOCPY would leave the
+	 * frames in PFE buffers which have to be given
+	 * back to the BMU, so the driver could not hand
+	 * them to the stack without a CPU copy. Standard
+	 * HIF RX keeps the HIF DMA copy into host pages,
+	 * which the driver attaches to the skb as they are.
 	 */
 	PFE_PHY_IF_ID_HIF_NOCPY
 };
@@ -103,6 +108,10 @@ enum {
 
 #define PFENG_INT_TIMER_DEFAULT		256 /* usecs */
 
+/* BMU2 pool size limits, the count is 16-bit and the pool is aligned to its size */
+#define PFENG_BMU2_BUF_CNT_MIN		256
+#define PFENG_BMU2_BUF_CNT_MAX		32768
+
 /* skbs waiting for time stamp */
 struct pfeng_ts_skb {
 	struct list_head		list;
@@ -138,6 +147,18 @@ enum tx_queue_status {
 	PFENG_TMU_FULL
 };
 
+/* ethtool private flags, bit positions in pfeng_netif.priv_flags */
+enum pfeng_priv_flag {
+	PFENG_PRIV_FLAG_RX_VLAN_ERRATUM,	/* restore VLAN tag of frames hit by the erratum */
+	PFENG_PRIV_FLAG_TMU_PRECHECK,		/* check TMU queue capacity before TX */
+	PFENG_PRIV_FLAG_CSUM_LEN_LIMIT,		/* no CSUM offload above PFENG_CSUM_OFF_PKT_LIMIT */
+	PFENG_PRIV_FLAG_RX_HWTS,		/* extract RX HW time stamps */
+	PFENG_PRIV_FLAG_TX_ETS,			/* request egress HW time stamps */
+	PFENG_PRIV_FLAGS_CNT
+};
+
+#define PFENG_PRIV_FLAGS_DEFAULT	(BIT(PFENG_PRIV_FLAGS_CNT) - 1)
+
 #define PFENG_TMU_LLTX_DISABLE_MODE_Q_ID	255U
 
 struct pfeng_tmu_q_cfg {
@@ -171,6 +192,8 @@ struct pfeng_netif {
 	/* if set, the multicast/ unicast MAC addr list needs to be sync'ed with the hw */
 	bool mc_unsynced;
 	bool uc_unsynced;
+	/* ethtool private flags (enum pfeng_priv_flag) */
+	u32				priv_flags;
 
 	pfe_tmu_t 			*tmu; /* fast access to the TMU handle */
 	struct pfeng_tmu_q_cfg 		tmu_q_cfg;
@@ -188,8 +211,23 @@ struct pfeng_netif {
 	bool				ts_work_on;
 	bool				dbg_info_dumped;
 	struct work_struct              ndev_reset_work;
+#ifdef PFE_CFG_PFE_MASTER
+	/* switchdev: bridge the netif is offloaded to, if any */
+	struct net_device		*brport_dev;
+	pfe_ct_if_op_mode_t		saved_op_mode;
+	/* tc: router mode has been set by the flowtable bind */
+	bool				ft_router_mode;
+	/* ethtool RX classification (ntuple) rules */
+	struct list_head		rxnfc_rules;
+	u32				rxnfc_cnt;
+#endif /* PFE_CFG_PFE_MASTER */
 };
 
+static inline bool pfeng_netif_priv_flag(struct pfeng_netif *netif, enum pfeng_priv_flag flag)
+{
+	return !!(READ_ONCE(netif->priv_flags) & BIT(flag));
+}
+
 #ifdef PFE_CFG_MULTI_INSTANCE_SUPPORT
 struct pfe_hif_drv_client_tag
 {
@@ -215,6 +253,15 @@ struct pfe_hif_drv_tag
 
 struct pfeng_rx_chnl_pool;
 struct pfeng_tx_chnl_pool;
+
+/* RX buffer refill events */
+struct pfeng_bman_rx_stats {
+	u64				alloc_fail;	/* no page, not even from the reserve */
+	u64				reserve_used;	/* page taken from the reserve */
+	u64				deferred_refill; /* refill work runs */
+	u64				ring_starved;	/* refill left the ring empty */
+};
+
 struct pfeng_hif_chnl {
 	struct napi_struct		napi ____cacheline_aligned_in_smp;
 	spinlock_t			lock_tx;
@@ -344,6 +391,14 @@ struct pfeng_priv {
 	const char			*fw_util_name;
 	struct dentry			*dbgfs;
 	u32				msg_verbosity;
+	u32				rx_coalesce_usecs;
+#ifdef PFE_CFG_PFE_MASTER
+	struct pfeng_switchdev		*switchdev;
+	struct pfeng_tc			*tc;
+	struct devlink			*devlink;
+	/* serializes PFE stop/start (PM, devlink reload and health recovery) */
+	struct mutex			pfe_lock;
+#endif /* PFE_CFG_PFE_MASTER */
 };
 
 static inline bool pfeng_netif_cfg_is_aux(struct pfeng_netif_cfg *cfg)
@@ -390,6 +445,20 @@ static inline pfe_phy_if_t *pfeng_netif_get_emac_phyif(struct pfeng_netif *netif
 	return __pfeng_netif_get_emac(netif)->phyif_emac;
 }
 
+/* Rx queue N of the netdev is served by the N-th HIF channel of the hifmap */
+static inline int pfeng_netif_rxq_to_chnl_idx(struct pfeng_netif *netif, u32 rxq)
+{
+	unsigned long hifmap = netif->cfg->hifmap;
+	int idx;
+
+	for_each_set_bit(idx, &hifmap, PFENG_PFE_HIF_CHANNELS) {
+		if (!rxq--)
+			return idx;
+	}
+
+	return -EINVAL;
+}
+
 /* fw */
 int pfeng_fw_load(struct pfeng_priv *priv, const char *fw_class_name, const char *fw_util_name);
 void pfeng_fw_free(struct pfeng_priv *priv);
@@ -428,6 +497,7 @@ int pfeng_hif_slave_resume(struct pfeng_priv *priv);
 /* bman */
 int pfeng_bman_pool_create(struct pfeng_hif_chnl *chnl);
 void pfeng_bman_pool_destroy(struct pfeng_hif_chnl *chnl);
+void pfeng_bman_rx_stats_add(struct pfeng_hif_chnl *chnl, struct pfeng_bman_rx_stats *stats);
 int pfeng_hif_chnl_fill_rx_buffers(struct pfeng_hif_chnl *chnl);
 void pfeng_hif_chnl_txconf_put_map_frag(struct pfeng_hif_chnl *chnl, addr_t pa_addr, u32 size, struct sk_buff *skb, u8 flags, int i);
 u8 pfeng_hif_chnl_txconf_get_flag(struct pfeng_hif_chnl *chnl);
@@ -441,11 +511,16 @@ void pfeng_bman_tx_pool_dump(struct pfeng_hif_chnl *chnl, struct net_device *nde
 /* netif */
 int pfeng_netif_create(struct pfeng_priv *priv);
 void pfeng_netif_remove(struct pfeng_priv *priv);
+bool pfeng_netif_is_pfeng(const struct net_device *netdev);
 int pfeng_netif_suspend(struct pfeng_priv *priv);
 int pfeng_netif_resume(struct pfeng_priv *priv);
+#ifdef PFE_CFG_PFE_MASTER
+int pfeng_netif_set_hifmap(struct pfeng_netif *netif, u32 hifmap);
+#endif /* PFE_CFG_PFE_MASTER */
 void pfeng_ethtool_init(struct net_device *netdev);
 int pfeng_ethtool_params_save(struct pfeng_netif *netif);
 int pfeng_ethtool_params_restore(struct pfeng_netif *netif);
+void pfeng_ethtool_rxnfc_release(struct pfeng_netif *netif);
 int pfeng_phylink_create(struct pfeng_netif *netif);
 int pfeng_phylink_connect_phy(struct pfeng_netif *netif);
 int pfeng_phylink_start(struct pfeng_netif *netif);
@@ -454,6 +529,43 @@ void pfeng_phylink_disconnect_phy(struct pfeng_netif *netif);
 void pfeng_phylink_destroy(struct pfeng_netif *netif);
 void pfeng_phylink_mac_change(struct pfeng_netif *netif, bool up);
 
+/* switchdev */
+#ifdef PFE_CFG_PFE_MASTER
+int pfeng_switchdev_create(struct pfeng_priv *priv);
+void pfeng_switchdev_remove(struct pfeng_priv *priv);
+void pfeng_switchdev_suspend(struct pfeng_priv *priv);
+void pfeng_switchdev_resume(struct pfeng_priv *priv);
+int pfeng_switchdev_get_port_parent_id(struct net_device *netdev, struct netdev_phys_item_id *ppid);
+#endif /* PFE_CFG_PFE_MASTER */
+
+/* tc */
+#ifdef PFE_CFG_PFE_MASTER
+struct flow_rule;
+int pfeng_tc_create(struct pfeng_priv *priv);
+void pfeng_tc_remove(struct pfeng_priv *priv);
+void pfeng_tc_suspend(struct pfeng_priv *priv);
+void pfeng_tc_resume(struct pfeng_priv *priv);
+int pfeng_tc_setup(struct net_device *netdev, enum tc_setup_type type, void *type_data);
+int pfeng_tc_cls_rule_add(struct pfeng_netif *netif, unsigned long cookie,
+			  struct flow_rule *rule, struct netlink_ext_ack *extack);
+int pfeng_tc_cls_rule_del(struct pfeng_netif *netif, unsigned long cookie);
+#endif /* PFE_CFG_PFE_MASTER */
+
+/* drv */
+#ifdef PFE_CFG_PFE_MASTER
+int pfeng_drv_pfe_stop(struct pfeng_priv *priv);
+int pfeng_drv_pfe_start(struct pfeng_priv *priv);
+int pfeng_drv_pfe_restart(struct pfeng_priv *priv);
+#endif /* PFE_CFG_PFE_MASTER */
+
+/* devlink */
+#ifdef PFE_CFG_PFE_MASTER
+int pfeng_devlink_create(struct pfeng_priv *priv);
+void pfeng_devlink_remove(struct pfeng_priv *priv);
+void pfeng_devlink_hm_attach(struct pfeng_priv *priv);
+void pfeng_devlink_hm_detach(struct pfeng_priv *priv);
+#endif /* PFE_CFG_PFE_MASTER */
+
 /* ptp */
 void pfeng_ptp_register(struct pfeng_netif *netif);
 void pfeng_ptp_unregister(struct pfeng_netif *netif);
@@ -137,6 +137,42 @@ void *oal_mm_malloc(const addr_t size);
  */
 void oal_mm_free(const void *vaddr);
 
+/**
+ * @brief		Object cache (slab) instance
+ */
+typedef struct oal_mm_slab_tag oal_mm_slab_t;
+
+/**
+ * @brief		Create cache of equally sized objects
+ * @details		Intended for objects which are frequently allocated and released. The objects
+ *				are not physically contiguous with each other nor suitable for DMA.
+ * @param[in]	name Name of the cache
+ * @param[in]	size Size of a single object in bytes
+ * @return		The cache instance or NULL if failed
+ */
+oal_mm_slab_t *oal_mm_slab_create(const char_t *name, const addr_t size);
+
+/**
+ * @brief		Allocate zero-initialized object from a cache
+ * @param[in]	slab The cache instance
+ * @return		Pointer (virtual) to the object or NULL if failed
+ */
+void *oal_mm_slab_alloc(oal_mm_slab_t *slab);
+
+/**
+ * @brief		Return object back to the cache
+ * @param[in]	slab The cache instance the object has been allocated from
+ * @param[in]	vaddr Pointer to the object (virtual)
+ */
+void oal_mm_slab_free(oal_mm_slab_t *slab, const void *vaddr);
+
+/**
+ * @brief		Destroy a cache
+ * @details		All objects shall be returned to the cache before the call.
+ * @param[in]	slab The cache instance
+ */
+void oal_mm_slab_destroy(oal_mm_slab_t *slab);
+
 #endif /* PFE_CFG_DETACHED_MINIHIF */
 
 /**
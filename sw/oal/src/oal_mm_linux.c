@@ -451,6 +451,46 @@ void oal_mm_free(const void *vaddr)
 	kfree((void *)vaddr);
 }
 
+/**
+ * Object cache creation
+ */
+oal_mm_slab_t *oal_mm_slab_create(const char_t *name, const addr_t size)
+{
+	return (oal_mm_slab_t *)kmem_cache_create(name, size, 0, SLAB_HWCACHE_ALIGN, NULL);
+}
+
+/**
+ * Object cache allocation
+ */
+void *oal_mm_slab_alloc(oal_mm_slab_t *slab)
+{
+	return kmem_cache_zalloc((struct kmem_cache *)slab, GFP_KERNEL);
+}
+
+/**
+ * Object cache release
+ */
+void oal_mm_slab_free(oal_mm_slab_t *slab, const void *vaddr)
+{
+#if defined(PFE_CFG_NULL_ARG_CHECK)
+	if (unlikely((NULL == slab) || (NULL == vaddr)))
+	{
+		NXP_LOG_ERROR("NULL argument received\n");
+		return;
+	}
+#endif /* PFE_CFG_NULL_ARG_CHECK */
+
+	kmem_cache_free((struct kmem_cache *)slab, (void *)vaddr);
+}
+
+/**
+ * Object cache destruction
+ */
+void oal_mm_slab_destroy(oal_mm_slab_t *slab)
+{
+	kmem_cache_destroy((struct kmem_cache *)slab);
+}
+
 /**
  *	Try to find physical address associated with mapped virtual range
  */
@@ -293,6 +293,20 @@ void pfe_bmu_cfg_free_buf(addr_t base_va, addr_t buffer)
 	hal_write32((uint32_t)(buffer & 0xffffffffU), base_va + BMU_FREE_CTRL);
 }
 
+/**
+ * @brief		Get current number of free and allocated buffers
+ * @param[in]	base_va Base address of the BMU register space (virtual)
+ * @param[out]	free_cnt Number of free buffers
+ * @param[out]	used_cnt Number of allocated buffers
+ * @param[out]	low_wm Configured low watermark (number of free buffers)
+ */
+void pfe_bmu_cfg_get_occupancy(addr_t base_va, uint32_t *free_cnt, uint32_t *used_cnt, uint32_t *low_wm)
+{
+	*free_cnt = hal_read32(base_va + BMU_REM_BUF_CNT) & 0xffffU;
+	*used_cnt = hal_read32(base_va + BMU_CURR_BUF_CNT) & 0xffffU;
+	*low_wm = hal_read32(base_va + BMU_LOW_WATERMARK) & 0xffffU;
+}
+
 /**
  * @brief		Get BMU statistics in text form
  * @details		This is a HW-specific function providing detailed text statistics
@@ -99,6 +99,7 @@ void pfe_bmu_cfg_enable(addr_t base_va);
 void pfe_bmu_cfg_disable(addr_t base_va);
 void * pfe_bmu_cfg_alloc_buf(addr_t base_va);
 void pfe_bmu_cfg_free_buf(addr_t base_va, addr_t buffer);
+void pfe_bmu_cfg_get_occupancy(addr_t base_va, uint32_t *free_cnt, uint32_t *used_cnt, uint32_t *low_wm);
 
 uint32_t pfe_bmu_cfg_get_text_stat(addr_t base_va, struct seq_file *seq, uint8_t verb_level);
 
@@ -199,6 +199,18 @@ static void *pfe_poller_func(void *arg)
 					pfe_ecc_err_irq_unmask(platform->ecc_err);
 				}
 
+				/*	BMU occupancy */
+				if (NULL != platform->bmu)
+				{
+					for (i = 0; i < platform->bmu_count; i++)
+					{
+						if (NULL != platform->bmu[i])
+						{
+							pfe_bmu_sample_occupancy(platform->bmu[i]);
+						}
+					}
+				}
+
 				/*  Process HIF global ISR */
 				if (NULL != platform->hif)
 				{
@@ -1770,8 +1782,22 @@ static void pfe_platform_destroy_hif_nocpy(pfe_platform_t *platform)
 static errno_t pfe_platform_create_bmu(pfe_platform_t *platform, const pfe_platform_config_t *config)
 {
 	pfe_bmu_cfg_t bmu_cfg = {0U};
+	uint32_t bmu2_buf_count = PFE_CFG_BMU2_BUF_COUNT;
 	errno_t ret = EOK;
 
+	if (0U != config->bmu2_buf_count)
+	{
+		/*	UCAST_CONFIG holds 16-bit buffer count, pool alignment requires power of 2 */
+		if ((0U != (config->bmu2_buf_count & (config->bmu2_buf_count - 1U))) || (config->bmu2_buf_count > 0x8000U))
+		{
+			NXP_LOG_WARNING("Invalid BMU2 buffer count %u, using %u\n", (uint_t)config->bmu2_buf_count, (uint_t)bmu2_buf_count);
+		}
+		else
+		{
+			bmu2_buf_count = config->bmu2_buf_count;
+		}
+	}
+
 	platform->bmu = oal_mm_malloc(platform->bmu_count * sizeof(pfe_bmu_t *));
 	if (NULL == platform->bmu)
 	{
@@ -1805,7 +1831,7 @@ static errno_t pfe_platform_create_bmu(pfe_platform_t *platform, const pfe_platf
 		{
 
 			/*	Must be aligned to BUF_COUNT * BUF_SIZE */
-			platform->bmu_buffers_size = PFE_CFG_BMU2_BUF_COUNT * PFE_CFG_BMU2_BUF_SIZE;
+			platform->bmu_buffers_size = bmu2_buf_count * PFE_CFG_BMU2_BUF_SIZE;
 			platform->bmu_buffers_va = oal_mm_malloc_contig_named_aligned_nocache(
 					PFE_CFG_SYS_MEM, platform->bmu_buffers_size, platform->bmu_buffers_size);
 			if (NULL == platform->bmu_buffers_va)
@@ -1829,7 +1855,7 @@ static errno_t pfe_platform_create_bmu(pfe_platform_t *platform, const pfe_platf
 					NXP_LOG_INFO("BMU2 buffer base: p0x%"PRINTADDR_T" (0x%"PRINTADDR_T" bytes)\n", bmu_cfg.pool_pa, platform->bmu_buffers_size);
 				}
 
-				bmu_cfg.max_buf_cnt = PFE_CFG_BMU2_BUF_COUNT;
+				bmu_cfg.max_buf_cnt = bmu2_buf_count;
 				bmu_cfg.buf_size = PFE_CFG_BMU2_BUF_SIZE;
 				bmu_cfg.bmu_ucast_thres = 0x800U;
 				bmu_cfg.bmu_mcast_thres = 0x200U;
@@ -2501,6 +2527,85 @@ static void pfe_platform_destroy_rtable(pfe_platform_t *platform)
 		platform->rtable_va = NULL;
 	}
 }
+
+/**
+ * @brief		Change size of the routing table at runtime
+ * @details		New table memory is allocated and the routing table moves there
+ *				with all its entries while the traffic is running. The original
+ *				memory is released once the classifier uses the new table.
+ *				The routing table lookup is briefly disabled during the switch,
+ *				see pfe_rtable_resize().
+ * @param[in]	platform The platform instance
+ * @param[in]	hash_size Number of hash table entries (power of 2)
+ * @param[in]	collision_size Number of collision pool entries
+ * @return		EOK if success, error code otherwise
+ */
+errno_t pfe_platform_resize_rtable(pfe_platform_t *platform, uint32_t hash_size, uint32_t collision_size)
+{
+	pfe_rtable_cfg_t cfg = { 0 };
+	void *rtable_va;
+	addr_t rtable_size;
+	errno_t ret;
+
+#if defined(PFE_CFG_NULL_ARG_CHECK)
+	if (unlikely(NULL == platform))
+	{
+		NXP_LOG_ERROR("NULL argument received\n");
+		return EINVAL;
+	}
+#endif /* PFE_CFG_NULL_ARG_CHECK */
+
+	if (NULL == platform->rtable)
+	{
+		ret = ENODEV;
+	}
+	else if (TRUE == platform->g3_rtable_in_lmem)
+	{
+		NXP_LOG_ERROR("Routing table in LMEM can't be resized\n");
+		ret = ENOTSUP;
+	}
+	else if ((hash_size > PFE_CFG_RT_HASH_ENTRIES_MAX_CNT) || (0U == hash_size) || (0U != (hash_size & (hash_size - 1U))))
+	{
+		NXP_LOG_ERROR("Required HASH size exceeds allowed range.\n");
+		ret = EINVAL;
+	}
+	else
+	{
+		rtable_size = (hash_size + collision_size) * pfe_rtable_get_entry_size();
+		rtable_va = oal_mm_malloc_contig_named_aligned_nocache(PFE_CFG_RT_MEM, rtable_size, 2048U);
+		if (NULL == rtable_va)
+		{
+			NXP_LOG_ERROR("Unable to get routing table memory\n");
+			ret = ENOMEM;
+		}
+		else
+		{
+			cfg.htable_base_va = (addr_t)rtable_va;
+			cfg.pool_base_va = (addr_t)rtable_va + (hash_size * pfe_rtable_get_entry_size());
+			cfg.htable_size = hash_size;
+			cfg.pool_size = collision_size;
+			cfg.lmem_allocated = FALSE;
+			cfg.htable_base_pa = (addr_t)oal_mm_virt_to_phys_contig((void *)cfg.htable_base_va);
+			cfg.pool_base_pa = cfg.htable_base_pa + (hash_size * pfe_rtable_get_entry_size());
+
+			ret = pfe_rtable_resize(platform->rtable, &cfg);
+			if (EOK != ret)
+			{
+				NXP_LOG_ERROR("Routing table resize failed: %d\n", ret);
+				oal_mm_free_contig(rtable_va);
+			}
+			else
+			{
+				/*	The original table is not used anymore */
+				oal_mm_free_contig(platform->rtable_va);
+				platform->rtable_va = rtable_va;
+				platform->rtable_size = rtable_size;
+			}
+		}
+	}
+
+	return ret;
+}
 #endif /* PFE_CFG_RTABLE_ENABLE */
 
 /**
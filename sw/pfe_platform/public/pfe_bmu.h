@@ -24,6 +24,25 @@ typedef struct
 	uint32_t buf_mem_loc_cnt;
 } pfe_bmu_cfg_t;
 
+#define PFE_BMU_OCC_HISTORY_LEN	16U
+
+typedef struct
+{
+	uint32_t free_cnt;			/*	Number of free buffers */
+	uint32_t used_cnt;			/*	Number of allocated buffers */
+} pfe_bmu_occ_sample_t;
+
+typedef struct
+{
+	uint32_t buf_cnt;			/*	Number of buffers in the pool */
+	uint32_t low_wm;			/*	Low watermark (free buffers) */
+	uint32_t free_min;			/*	Minimum of free buffers seen so far */
+	uint32_t used_max;			/*	Maximum of allocated buffers seen so far */
+	uint32_t low_wm_cnt;		/*	Number of low watermark crossings */
+	uint32_t samples;			/*	Number of samples taken */
+	pfe_bmu_occ_sample_t history[PFE_BMU_OCC_HISTORY_LEN];	/*	Latest samples, newest first */
+} pfe_bmu_occupancy_t;
+
 #ifdef PFE_CFG_TARGET_OS_AUTOSAR
 #define ETH_43_PFE_START_SEC_CODE
 #include "Eth_43_PFE_MemMap.h"
@@ -42,7 +61,9 @@ void *pfe_bmu_get_pa(const pfe_bmu_t *bmu, addr_t va) __attribute__((hot, pure))
 uint32_t pfe_bmu_get_buf_size(const pfe_bmu_t *bmu) __attribute__((cold, pure));
 void pfe_bmu_free_buf(const pfe_bmu_t *bmu, addr_t buffer) __attribute__((hot));
 
-uint32_t pfe_bmu_get_text_statistics(const pfe_bmu_t *bmu, struct seq_file *seq, uint8_t verb_level) __attribute__((cold));
+uint32_t pfe_bmu_get_text_statistics(pfe_bmu_t *bmu, struct seq_file *seq, uint8_t verb_level) __attribute__((cold));
+void pfe_bmu_sample_occupancy(pfe_bmu_t *bmu);
+errno_t pfe_bmu_get_occupancy(pfe_bmu_t *bmu, pfe_bmu_occupancy_t *occ);
 
 void pfe_bmu_destroy(pfe_bmu_t *bmu) __attribute__((cold));
 #ifdef PFE_CFG_PFE_MASTER
@@ -52,6 +52,7 @@ errno_t pfe_class_write_dmem(void *class_p, int32_t pe_idx, addr_t dst_addr, con
 errno_t pfe_class_read_dmem(void *class_p, int32_t pe_idx, void *dst_ptr, addr_t src_addr, uint32_t len);
 errno_t pfe_class_gather_read_dmem(pfe_class_t *class, void *dst_ptr, addr_t src_addr, uint32_t buffer_len, uint32_t read_len);
 errno_t pfe_class_set_rtable(pfe_class_t *class, addr_t rtable_pa, uint32_t rtable_len, uint32_t entry_size);
+errno_t pfe_class_switch_rtable(pfe_class_t *class, addr_t rtable_pa, uint32_t rtable_len, uint32_t entry_size);
 errno_t pfe_class_set_default_vlan(const pfe_class_t *class, uint16_t vlan);
 uint32_t pfe_class_get_num_of_pes(const pfe_class_t *class);
 
@@ -19,7 +19,8 @@
 void pfe_fp_init(void);
 uint32_t pfe_fp_create_table(pfe_class_t *class, uint16_t rules_count);
 uint32_t pfe_fp_table_write_rule(pfe_class_t *class, uint32_t table_address, const pfe_ct_fp_rule_t *rule, uint16_t position);
-void pfe_fp_destroy_table(const pfe_class_t *class, uint32_t table_address);
+void pfe_fp_destroy_table(pfe_class_t *class, uint32_t table_address);
+uint32_t pfe_fp_get_rules_count(void);
 errno_t pfe_fp_table_get_statistics(pfe_class_t *class, uint32_t pe_idx ,uint32_t table_address, pfe_ct_class_flexi_parser_stats_t *stats);
 
 #ifdef PFE_CFG_TARGET_OS_AUTOSAR
@@ -12,6 +12,7 @@
 
 #define PFE_HM_DESCRIPTION_MAX_LEN 256
 #define PFE_HM_QUEUE_LEN 8
+#define PFE_HM_EVENT_CB_MAX 2U
 
 typedef enum {
 	HM_INFO = 0,
@@ -127,6 +128,7 @@ typedef enum {
 	HM_EVT_BMU_FULL = 170,
 	HM_EVT_BMU_FREE_ERR = 171,
 	HM_EVT_BMU_MCAST = 172,
+	HM_EVT_BMU_LOW_WATERMARK = 173,
 #endif
 
 	HM_EVT_PE_STALL = 180,
@@ -177,6 +179,7 @@ errno_t pfe_hm_get(pfe_hm_item_t *item);
 const char *pfe_hm_get_event_str(pfe_hm_evt_t id);
 const char *pfe_hm_get_src_str(pfe_hm_src_t src);
 bool_t pfe_hm_register_event_cb(pfe_hm_cb_t cb);
+void pfe_hm_unregister_event_cb(pfe_hm_cb_t cb);
 
 #define __FILENAME__ (strrchr(__FILE__, '/') ? strrchr(__FILE__, '/') + 1 : __FILE__)
 
@@ -32,6 +32,46 @@ typedef struct __pfe_l2br_table_tag pfe_l2br_table_t;
 typedef struct __pfe_l2br_table_iterator_tag pfe_l2br_table_iterator_t;
 typedef struct __pfe_l2br_table_entry_tag pfe_l2br_table_entry_t;
 
+/**
+ * @brief	L2 bridge table operation type
+ */
+typedef enum
+{
+	L2BR_TABLE_OP_ADD,				/*!< Add the entry */
+	L2BR_TABLE_OP_UPDATE,			/*!< Update the entry */
+	L2BR_TABLE_OP_DEL				/*!< Delete the entry */
+} pfe_l2br_table_op_t;
+
+/**
+ * @brief	Single operation of pfe_l2br_table_batch()
+ */
+typedef struct
+{
+	pfe_l2br_table_op_t op;			/*!< Operation to be done */
+	pfe_l2br_table_entry_t *entry;	/*!< The entry */
+	errno_t ret;					/*!< Result of the operation */
+} pfe_l2br_table_batch_op_t;
+
+/**
+ * @brief	L2 bridge table change event type
+ */
+typedef enum
+{
+	L2BR_TABLE_EVT_ADDED,			/*!< Entry has been added (configured or learned) */
+	L2BR_TABLE_EVT_REMOVED,			/*!< Entry has been removed (deleted or aged) */
+	L2BR_TABLE_EVT_CHANGED			/*!< Action data of the entry have changed */
+} pfe_l2br_table_event_t;
+
+/**
+ * @brief	L2 bridge table change callback, see pfe_l2br_table_register_event_cb()
+ */
+typedef void (*pfe_l2br_table_event_cb_t)(void *arg, pfe_l2br_table_event_t event, const pfe_l2br_table_entry_t *entry);
+
+/**
+ * @brief	Maximum number of table change callbacks registered at a time
+ */
+#define PFE_L2BR_TABLE_EVENT_CB_MAX 2U
+
 #ifdef PFE_CFG_TARGET_OS_AUTOSAR
 #define ETH_43_PFE_START_SEC_CODE
 #include "Eth_43_PFE_MemMap.h"
@@ -41,10 +81,16 @@ pfe_l2br_table_t *pfe_l2br_table_create(addr_t cbus_base_va, pfe_l2br_table_type
 void pfe_l2br_table_destroy(pfe_l2br_table_t *l2br);
 errno_t pfe_l2br_table_init(pfe_l2br_table_t *l2br);
 errno_t pfe_l2br_table_flush(pfe_l2br_table_t *l2br);
+errno_t pfe_l2br_table_sync(pfe_l2br_table_t *l2br, uint32_t budget);
+errno_t pfe_l2br_table_register_event_cb(pfe_l2br_table_t *l2br, pfe_l2br_table_event_cb_t cb, void *arg);
+errno_t pfe_l2br_table_unregister_event_cb(pfe_l2br_table_t *l2br, pfe_l2br_table_event_cb_t cb, void *arg);
+uint32_t pfe_l2br_table_get_size(const pfe_l2br_table_t *l2br);
 errno_t pfe_l2br_table_add_entry(pfe_l2br_table_t *l2br, pfe_l2br_table_entry_t *entry);
 errno_t pfe_l2br_table_del_entry(pfe_l2br_table_t *l2br, pfe_l2br_table_entry_t *entry);
 errno_t pfe_l2br_table_update_entry(pfe_l2br_table_t *l2br, pfe_l2br_table_entry_t *entry);
 errno_t pfe_l2br_table_search_entry(pfe_l2br_table_t *l2br, pfe_l2br_table_entry_t *entry);
+errno_t pfe_l2br_table_batch(pfe_l2br_table_t *l2br, pfe_l2br_table_batch_op_t *ops, uint32_t count);
+errno_t pfe_l2br_table_flush_by_port(pfe_l2br_table_t *l2br, pfe_ct_phy_if_id_t port, uint16_t vlan);
 pfe_l2br_table_iterator_t *pfe_l2br_iterator_create(void);
 errno_t pfe_l2br_iterator_destroy(const pfe_l2br_table_iterator_t *inst);
 errno_t pfe_l2br_table_get_first(pfe_l2br_table_t *l2br, pfe_l2br_table_iterator_t *l2t_iter, pfe_l2br_table_get_criterion_t crit, pfe_l2br_table_entry_t *entry);
@@ -55,6 +101,7 @@ errno_t pfe_l2br_table_entry_destroy(const pfe_l2br_table_entry_t *entry);
 errno_t pfe_l2br_table_entry_set_mac_addr(pfe_l2br_table_entry_t *entry, const pfe_mac_addr_t mac_addr);
 errno_t pfe_l2br_table_entry_set_vlan(pfe_l2br_table_entry_t *entry, uint16_t vlan);
 __attribute__((pure)) uint32_t pfe_l2br_table_entry_get_vlan(const pfe_l2br_table_entry_t *entry);
+errno_t pfe_l2br_table_entry_get_mac_addr(const pfe_l2br_table_entry_t *entry, pfe_mac_addr_t mac_addr);
 errno_t pfe_l2br_table_entry_set_action_data(pfe_l2br_table_entry_t *entry, uint64_t action_data);
 __attribute__((pure)) uint64_t pfe_l2br_table_entry_get_action_data(const pfe_l2br_table_entry_t *entry);
 errno_t pfe_l2br_table_entry_set_fresh(const pfe_l2br_table_t *l2br, pfe_l2br_table_entry_t *entry, bool_t is_fresh);
@@ -63,6 +110,7 @@ errno_t pfe_l2br_table_entry_set_static(const pfe_l2br_table_t *l2br, pfe_l2br_t
 bool_t pfe_l2br_table_entry_is_static(const pfe_l2br_table_entry_t *entry) __attribute__((pure));
 
 uint32_t pfe_l2br_table_entry_to_str(const pfe_l2br_table_entry_t *entry, struct seq_file *seq);
+uint32_t pfe_l2br_table_get_text_statistics(const pfe_l2br_table_t *l2br, struct seq_file *seq, uint8_t verb_level);
 
 #ifdef PFE_CFG_TARGET_OS_AUTOSAR
 #define ETH_43_PFE_STOP_SEC_CODE
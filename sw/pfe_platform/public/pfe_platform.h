@@ -88,6 +88,7 @@ typedef struct
 	pfe_ct_phy_if_id_t local_hif; /* ID of the local interface */
 	uint32_t rtable_hash_size;	/* Size (number of entries) of hash area within routing table */
 	uint32_t rtable_collision_size;	/* Size (number of entries) of collision area within routing table */
+	uint32_t bmu2_buf_count;	/* Number of BMU2 buffers, power of 2. Zero selects PFE_CFG_BMU2_BUF_COUNT */
 	uint16_t vlan_id;	/* VLAN ID used for L2 Bridge configuration */
 	uint16_t vlan_stats_size;	/*VLAN stats size(number of vlan entry) used to collect info from firmware */
 	pfe_emac_mii_mode_t emac_mode[3]; /* MII mode per PFE EMAC */
@@ -180,6 +181,9 @@ pfe_phy_if_t *pfe_platform_get_phy_if_by_id(const pfe_platform_t *platform, pfe_
 void pfe_platform_idex_rpc_cbk(pfe_ct_phy_if_id_t sender, uint32_t id, void *buf, uint16_t buf_len, void *arg);
 #endif
 errno_t pfe_platform_get_fw_versions(const pfe_platform_t *platform, pfe_ct_version_t *class_fw, pfe_ct_version_t *util_fw);
+#if defined(PFE_CFG_RTABLE_ENABLE)
+errno_t pfe_platform_resize_rtable(pfe_platform_t *platform, uint32_t hash_size, uint32_t collision_size);
+#endif /* PFE_CFG_RTABLE_ENABLE */
 uint32_t pfe_fw_features_get_text_statistics(const pfe_platform_t *pfe, struct seq_file *seq, uint8_t verb_level);
 
 #ifdef PFE_CFG_TARGET_OS_AUTOSAR
@@ -17,8 +17,8 @@
 
 /**
  * @brief	Tick period for internal timer in seconds
- * @details	The timer is used to sample the active routing table entries and decrement
- * 			associated time-out values when entries are not being used by the firmware.
+ * @details	The timer advances the aging wheel. Entries reaching their expiry are
+ * 			checked for firmware activity and either re-armed or removed.
  */
 #define PFE_RTABLE_CFG_TICK_PERIOD_SEC			1U
 
@@ -103,16 +103,24 @@ typedef void (* pfe_rtable_callback_t)(pfe_rtable_entry_t *entry, pfe_rtable_cbk
 #include "Eth_43_PFE_MemMap.h"
 #endif /* PFE_CFG_TARGET_OS_AUTOSAR */
 
+errno_t pfe_rtable_entry_slab_init(void);
+void pfe_rtable_entry_slab_fini(void);
 pfe_rtable_t *pfe_rtable_create(pfe_class_t *class, pfe_l2br_t *bridge, pfe_rtable_cfg_t *config);
+errno_t pfe_rtable_resize(pfe_rtable_t *rtable, const pfe_rtable_cfg_t *config);
 errno_t pfe_rtable_add_entry(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry);
 errno_t pfe_rtable_del_entry(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry);
+errno_t pfe_rtable_add_entries(pfe_rtable_t *rtable, pfe_rtable_entry_t **entries, uint32_t count, errno_t *results);
+errno_t pfe_rtable_del_entries(pfe_rtable_t *rtable, pfe_rtable_entry_t **entries, uint32_t count, errno_t *results);
 void pfe_rtable_destroy(pfe_rtable_t *rtable);
 uint32_t pfe_rtable_get_entry_size(void);
 errno_t pfe_rtable_entry_to_5t(const pfe_rtable_entry_t *entry, pfe_5_tuple_t *tuple);
 errno_t pfe_rtable_entry_to_5t_out(const pfe_rtable_entry_t *entry, pfe_5_tuple_t *tuple);
 pfe_rtable_entry_t *pfe_rtable_get_first(pfe_rtable_t *rtable, pfe_rtable_get_criterion_t crit, void *arg);
 pfe_rtable_entry_t *pfe_rtable_get_next(pfe_rtable_t *rtable);
+errno_t pfe_rtable_update_route(pfe_rtable_t *rtable, uint32_t route_id, const pfe_phy_if_t *iface,
+								const pfe_mac_addr_t smac, const pfe_mac_addr_t dmac, uint32_t *count);
 uint32_t pfe_rtable_get_size(const pfe_rtable_t *rtable);
+uint32_t pfe_rtable_get_entry_count(const pfe_rtable_t *rtable);
 
 void pfe_rtable_entry_set_ttl_decrement(pfe_rtable_entry_t *entry);
 void pfe_rtable_entry_remove_ttl_decrement(pfe_rtable_entry_t *entry);
@@ -138,6 +146,7 @@ void pfe_rtable_entry_set_out_mac_addrs(pfe_rtable_entry_t *entry,const pfe_mac_
 void pfe_rtable_entry_set_out_vlan(pfe_rtable_entry_t *entry, uint16_t vlan, bool_t replace);
 uint16_t pfe_rtable_entry_get_out_vlan(const pfe_rtable_entry_t *entry);
 void pfe_rtable_entry_set_out_inner_vlan(pfe_rtable_entry_t *entry, uint16_t vlan);
+void pfe_rtable_entry_set_out_vlan_pop(pfe_rtable_entry_t *entry);
 void pfe_rtable_entry_set_out_pppoe_sid(pfe_rtable_entry_t *entry, uint16_t sid);
 pfe_ct_route_actions_t pfe_rtable_entry_get_action_flags(pfe_rtable_entry_t *entry);
 void pfe_rtable_entry_set_timeout(pfe_rtable_entry_t *entry, uint32_t timeout);
@@ -156,10 +165,13 @@ errno_t pfe_rtable_entry_get_id5t(const pfe_rtable_entry_t *entry, uint32_t *id5
 errno_t pfe_rtable_entry_set_dstif_id(pfe_rtable_entry_t *entry, pfe_ct_phy_if_id_t if_id);
 
 void pfe_rtable_do_timeouts(pfe_rtable_t *rtable);
+bool_t pfe_rtable_entry_is_active(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry);
 
 uint32_t pfe_rtable_get_text_statistics(const pfe_rtable_t *rtable, struct seq_file *seq, uint8_t verb_level);
 
 errno_t pfe_rtable_get_stats(const pfe_rtable_t *rtable, pfe_ct_conntrack_stats_t *stat, uint8_t conntrack_index);
+errno_t pfe_rtable_get_stats_bulk(const pfe_rtable_t *rtable, pfe_ct_conntrack_stats_t *stats, uint8_t first, uint32_t count);
+uint32_t pfe_rtable_get_stats_table_size(const pfe_rtable_t *rtable);
 
 #ifdef PFE_CFG_TARGET_OS_AUTOSAR
 #define ETH_43_PFE_STOP_SEC_CODE
@@ -14,6 +14,7 @@
 #include "pfe_cbus.h"
 #include "pfe_platform_cfg.h"
 #include "pfe_bmu.h"
+#include "pfe_hm.h"
 
 /* Configuration check */
 #if ((PFE_CFG_BMU1_LMEM_BASEADDR + PFE_CFG_BMU1_LMEM_SIZE) > CBUS_LMEM_SIZE)
@@ -33,6 +34,9 @@ struct pfe_bmu_tag
 #endif /* PFE_CFG_PARANOID_IRQ */
 	addr_t bmu_base_offset;	/*	BMU base offset within CBUS space */
 	uint32_t buf_size;
+	oal_mutex_t occ_lock;		/*	Occupancy telemetry protection */
+	pfe_bmu_occupancy_t occ;	/*	Occupancy telemetry */
+	bool_t below_low_wm;		/*	Last sample was below the low watermark */
 };
 
 #ifdef PFE_CFG_TARGET_OS_AUTOSAR
@@ -169,17 +173,26 @@ __attribute__((cold)) pfe_bmu_t *pfe_bmu_create(addr_t cbus_base_va, addr_t bmu_
 			bmu->pool_va_offset = bmu->pool_base_va - bmu->pool_base_pa;
 			bmu->pool_size = cfg->buf_size * cfg->max_buf_cnt;
 			bmu->buf_size = cfg->buf_size;
+			bmu->occ.buf_cnt = cfg->max_buf_cnt;
+			bmu->occ.free_min = cfg->max_buf_cnt;
 
+			if (EOK != oal_mutex_init(&bmu->occ_lock))
+			{
+				NXP_LOG_ERROR("Mutex initialization failed\n");
+				oal_mm_free(bmu);
+				bmu = NULL;
+			}
 	#ifdef PFE_CFG_PARANOID_IRQ
 			/*	Resource protection */
-			if (EOK != oal_mutex_init(&bmu->lock))
+			else if (EOK != oal_mutex_init(&bmu->lock))
 			{
 				NXP_LOG_ERROR("Mutex initialization failed\n");
+				(void)oal_mutex_destroy(&bmu->occ_lock);
 				oal_mm_free(bmu);
 				bmu = NULL;
 			}
-			else
 	#endif /* PFE_CFG_PARANOID_IRQ */
+			else
 			{
 				pfe_bmu_reset(bmu);
 
@@ -474,6 +487,11 @@ __attribute__((cold)) void pfe_bmu_destroy(pfe_bmu_t *bmu)
 		}
 #endif /* PFE_CFG_PARANOID_IRQ */
 
+		if (EOK != oal_mutex_destroy(&bmu->occ_lock))
+		{
+			NXP_LOG_ERROR("Mutex destroy failed\n");
+		}
+
 		oal_mm_free(bmu);
 	}
 }
@@ -486,8 +504,11 @@ __attribute__((cold)) void pfe_bmu_destroy(pfe_bmu_t *bmu)
  * @param[in]	verb_level 	Verbosity level
  * @return		Number of bytes written to the buffer
  */
-__attribute__((cold)) uint32_t pfe_bmu_get_text_statistics(const pfe_bmu_t *bmu, struct seq_file *seq, uint8_t verb_level)
+__attribute__((cold)) uint32_t pfe_bmu_get_text_statistics(pfe_bmu_t *bmu, struct seq_file *seq, uint8_t verb_level)
 {
+	pfe_bmu_occupancy_t occ;
+	uint32_t ii, cnt;
+
 #if defined(PFE_CFG_NULL_ARG_CHECK)
 	if (unlikely(NULL == bmu))
 	{
@@ -497,10 +518,134 @@ __attribute__((cold)) uint32_t pfe_bmu_get_text_statistics(const pfe_bmu_t *bmu,
 #endif /* PFE_CFG_NULL_ARG_CHECK */
 	{
 		pfe_bmu_cfg_get_text_stat(bmu->bmu_base_va, seq, verb_level);
+
+		if (EOK == pfe_bmu_get_occupancy(bmu, &occ))
+		{
+			seq_printf(seq, "Pool Size            : %u\n", (uint_t)occ.buf_cnt);
+			seq_printf(seq, "Free Min             : %u\n", (uint_t)occ.free_min);
+			seq_printf(seq, "Allocated Max        : %u\n", (uint_t)occ.used_max);
+			seq_printf(seq, "Low Watermark Hits   : %u\n", (uint_t)occ.low_wm_cnt);
+			seq_printf(seq, "Samples              : %u\n", (uint_t)occ.samples);
+
+			cnt = (occ.samples < PFE_BMU_OCC_HISTORY_LEN) ? occ.samples : PFE_BMU_OCC_HISTORY_LEN;
+			for (ii = 0U; ii < cnt; ii++)
+			{
+				seq_printf(seq, "Sample -%-2u free/used : %u/%u\n", (uint_t)ii,
+						(uint_t)occ.history[ii].free_cnt, (uint_t)occ.history[ii].used_cnt);
+			}
+		}
 	}
 	return 0;
 }
 
+/**
+ * @brief		Take a sample of the pool occupancy
+ * @details		Updates the occupancy history and min/max values and reports the HM event
+ *				when the number of free buffers drops below the low watermark. Intended
+ *				to be called periodically.
+ * @param[in]	bmu The BMU instance
+ */
+__attribute__((cold)) void pfe_bmu_sample_occupancy(pfe_bmu_t *bmu)
+{
+	uint32_t free_cnt, used_cnt, low_wm;
+	bool_t crossed = FALSE;
+
+#if defined(PFE_CFG_NULL_ARG_CHECK)
+	if (unlikely(NULL == bmu))
+	{
+		NXP_LOG_ERROR("NULL argument received\n");
+	}
+	else
+#endif /* PFE_CFG_NULL_ARG_CHECK */
+	{
+		pfe_bmu_cfg_get_occupancy(bmu->bmu_base_va, &free_cnt, &used_cnt, &low_wm);
+
+		if (EOK != oal_mutex_lock(&bmu->occ_lock))
+		{
+			NXP_LOG_ERROR("Mutex lock failed\n");
+		}
+
+		/*	Shift the history, newest sample is the first one */
+		(void)memmove(&bmu->occ.history[1], &bmu->occ.history[0],
+				(PFE_BMU_OCC_HISTORY_LEN - 1U) * sizeof(pfe_bmu_occ_sample_t));
+		bmu->occ.history[0].free_cnt = free_cnt;
+		bmu->occ.history[0].used_cnt = used_cnt;
+		bmu->occ.samples++;
+		bmu->occ.low_wm = low_wm;
+
+		if (free_cnt < bmu->occ.free_min)
+		{
+			bmu->occ.free_min = free_cnt;
+		}
+
+		if (used_cnt > bmu->occ.used_max)
+		{
+			bmu->occ.used_max = used_cnt;
+		}
+
+		/*	Report only the crossing, not every sample below the watermark */
+		if (free_cnt < low_wm)
+		{
+			if (FALSE == bmu->below_low_wm)
+			{
+				bmu->below_low_wm = TRUE;
+				bmu->occ.low_wm_cnt++;
+				crossed = TRUE;
+			}
+		}
+		else
+		{
+			bmu->below_low_wm = FALSE;
+		}
+
+		if (EOK != oal_mutex_unlock(&bmu->occ_lock))
+		{
+			NXP_LOG_ERROR("Mutex unlock failed\n");
+		}
+
+		if (TRUE == crossed)
+		{
+			pfe_hm_report_warning(HM_SRC_BMU, HM_EVT_BMU_LOW_WATERMARK, "(BMU @ p0x%p) %u free of %u buffers",
+					(void *)bmu->bmu_base_offset, (uint_t)free_cnt, (uint_t)bmu->occ.buf_cnt);
+		}
+	}
+}
+
+/**
+ * @brief		Get the pool occupancy telemetry
+ * @param[in]	bmu The BMU instance
+ * @param[out]	occ Occupancy data collected by pfe_bmu_sample_occupancy()
+ * @return		EOK if success, error code otherwise
+ */
+__attribute__((cold)) errno_t pfe_bmu_get_occupancy(pfe_bmu_t *bmu, pfe_bmu_occupancy_t *occ)
+{
+	errno_t ret = EOK;
+
+#if defined(PFE_CFG_NULL_ARG_CHECK)
+	if (unlikely((NULL == bmu) || (NULL == occ)))
+	{
+		NXP_LOG_ERROR("NULL argument received\n");
+		ret = EINVAL;
+	}
+	else
+#endif /* PFE_CFG_NULL_ARG_CHECK */
+	{
+		if (EOK != oal_mutex_lock(&bmu->occ_lock))
+		{
+			NXP_LOG_ERROR("Mutex lock failed\n");
+		}
+
+		(void)memcpy(occ, &bmu->occ, sizeof(pfe_bmu_occupancy_t));
+
+		if (EOK != oal_mutex_unlock(&bmu->occ_lock))
+		{
+			NXP_LOG_ERROR("Mutex unlock failed\n");
+		}
+	}
+
+	return ret;
+}
+
 #ifdef PFE_CFG_PFE_MASTER
 /**
  * @brief		BMU error polling
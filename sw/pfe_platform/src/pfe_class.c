@@ -945,6 +945,50 @@ errno_t pfe_class_set_rtable(pfe_class_t *class, addr_t rtable_pa, uint32_t rtab
 	return ret;
 }
 
+/**
+ * @brief		Switch the running classifier to another routing table
+ * @details		Unlike pfe_class_set_rtable() this can be used while the classifier
+ *				is enabled. The hardware routing table lookup is disabled before the
+ *				table registers are updated so no lookup is done with a mix of the
+ *				original and the new table parameters. Frames received meanwhile just
+ *				miss the routing table.
+ * @param[in]	class The classifier instance
+ * @param[in]	rtable_pa Physical address of the new routing table
+ * @param[in]	rtable_len Number of entries in the new table
+ * @param[in]	entry_size Routing table entry size in number of bytes
+ * @return		EOK if success, error code otherwise
+ * @note		The lookup is left disabled, it has to be enabled again by the caller
+ *				(see pfe_class_rtable_lookup_enable()).
+ */
+errno_t pfe_class_switch_rtable(pfe_class_t *class, addr_t rtable_pa, uint32_t rtable_len, uint32_t entry_size)
+{
+	errno_t ret;
+#if defined(PFE_CFG_NULL_ARG_CHECK)
+	if (unlikely((NULL == class) || (NULL_ADDR == rtable_pa)))
+	{
+		NXP_LOG_ERROR("NULL argument received\n");
+		ret = EINVAL;
+	}
+	else
+#endif /* PFE_CFG_NULL_ARG_CHECK */
+	{
+		if (EOK != oal_mutex_lock(&class->mutex))
+		{
+			NXP_LOG_ERROR("mutex lock failed\n");
+		}
+
+		pfe_class_cfg_rtable_lookup_disable(class->cbus_base_va);
+		ret = pfe_class_cfg_set_rtable(class->cbus_base_va, rtable_pa, rtable_len, entry_size);
+
+		if (EOK != oal_mutex_unlock(&class->mutex))
+		{
+			NXP_LOG_ERROR("mutex unlock failed\n");
+		}
+	}
+
+	return ret;
+}
+
 /**
  * @brief		Set default VLAN ID
  * @details		Every packet without VLAN tag set received via physical interface will
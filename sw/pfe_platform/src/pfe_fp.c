@@ -17,6 +17,9 @@
 #include "Eth_43_PFE_MemMap.h"
 #endif /* PFE_CFG_TARGET_OS_AUTOSAR */
 
+/* Number of rules of all existing tables, used for occupancy reporting */
+static uint32_t pfe_fp_rules_cnt = 0U;
+
 /**
 * @brief Initializes the module
 */
@@ -24,7 +27,8 @@
    one is not called from somewhere in the pfe_platform */
 void pfe_fp_init(void)
 {
-    ;
+    /* Tables do not survive the platform restart */
+    pfe_fp_rules_cnt = 0U;
 }
 
 /**
@@ -64,6 +68,10 @@ uint32_t pfe_fp_create_table(pfe_class_t *class, uint16_t rules_count)
             pfe_class_dmem_heap_free (class, addr);
             addr = 0U;
         }
+        else
+        {
+            pfe_fp_rules_cnt += rules_count;
+        }
     }
     /* Return the DMEM address */
     return addr;
@@ -107,12 +115,35 @@ uint32_t pfe_fp_table_write_rule(pfe_class_t *class, uint32_t table_address, con
 * @param[in] class Classifier used to create the table
 * @param[in] table_address Address returned by the pfe_fp_create_table()
 */
-void pfe_fp_destroy_table(const pfe_class_t *class, uint32_t table_address)
+void pfe_fp_destroy_table(pfe_class_t *class, uint32_t table_address)
 {
-    /* Just free the memory */
+    pfe_ct_fp_table_t temp;
+
+    /* Update the occupancy from the table header */
+    if (EOK == pfe_class_read_dmem(class, 0, (void *)&temp, table_address, sizeof(pfe_ct_fp_table_t)))
+    {
+        if (pfe_fp_rules_cnt >= temp.count)
+        {
+            pfe_fp_rules_cnt -= temp.count;
+        }
+        else
+        {
+            pfe_fp_rules_cnt = 0U;
+        }
+    }
+
     pfe_class_dmem_heap_free(class, table_address);
 }
 
+/**
+* @brief Returns number of rules of all existing flexible parser tables
+* @return Sum of rules_count of all tables created by pfe_fp_create_table()
+*/
+uint32_t pfe_fp_get_rules_count(void)
+{
+    return pfe_fp_rules_cnt;
+}
+
 errno_t pfe_fp_table_get_statistics(pfe_class_t *class, uint32_t pe_idx, uint32_t table_address, pfe_ct_class_flexi_parser_stats_t *stats)
 {
     pfe_ct_fp_table_t temp;
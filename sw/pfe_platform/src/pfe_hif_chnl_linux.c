@@ -329,7 +329,7 @@ __attribute__((cold)) pfe_hif_chnl_t *pfe_hif_chnl_create(addr_t cbus_base_va, u
 
 	if (id >= PFE_HIF_CHNL_NOCPY_ID)
 	{
-		NXP_LOG_ERROR("HIF NOCPY is not supported\n");
+		NXP_LOG_ERROR("HIF NOCPY is not supported (channel %u)\n", (uint_t)id);
 		return NULL;
 	}
 
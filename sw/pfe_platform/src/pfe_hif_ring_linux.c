@@ -813,7 +813,7 @@ __attribute__((cold)) pfe_hif_ring_t *pfe_hif_ring_create(bool_t rx, bool_t nocp
 {
 	if (TRUE == nocpy)
 	{
-		NXP_LOG_ERROR("HIF NOCPY not supported\n");
+		NXP_LOG_ERROR("HIF NOCPY not supported, only the standard BD format is implemented\n");
 		return NULL;
 	}
 
@@ -24,7 +24,7 @@ static struct {
 	uint32_t end;
 	uint32_t len;
 	oal_mutex_t mutex;
-	pfe_hm_cb_t event_cb;
+	pfe_hm_cb_t event_cb[PFE_HM_EVENT_CB_MAX];
 } pfe_hm;
 
 #ifdef PFE_CFG_HM_STRINGS_ENABLED
@@ -141,6 +141,7 @@ static const hm_string_t hm_evt_strings[] = {
 	{HM_EVT_BMU_FREE_ERR, "Failed to free buffer"},
 	{HM_EVT_BMU_FULL, "All buffers are allocated, pool depleted"},
 	{HM_EVT_BMU_MCAST, "BMU_MCAST_EMTPY_INT or BMU_MCAST_FULL_INT or BMU_MCAST_THRES_INT or BMU_MCAST_FREE_ERR_INT triggered"},
+	{HM_EVT_BMU_LOW_WATERMARK, "Free buffers dropped below the low watermark"},
 #endif
 
 	{HM_EVT_PE_STALL, "PE core stalled"},
@@ -188,7 +189,7 @@ errno_t pfe_hm_init(void)
 		pfe_hm.end = 0;
 		pfe_hm.len = 0;
 		pfe_hm.initialized = TRUE;
-		pfe_hm.event_cb = NULL;
+		(void)memset(pfe_hm.event_cb, 0, sizeof(pfe_hm.event_cb));
 	}
 	else
 	{
@@ -224,6 +225,7 @@ void pfe_hm_report(pfe_hm_src_t src, pfe_hm_type_t type, pfe_hm_evt_t id, pfe_hm
 		const char *format, ...)
 {
 	pfe_hm_item_t item;
+	uint32_t ii;
 #ifdef NXP_LOG_ENABLED
 	const char *separator = "";
 #ifdef PFE_CFG_HM_STRINGS_ENABLED
@@ -360,6 +362,15 @@ void pfe_hm_report(pfe_hm_src_t src, pfe_hm_type_t type, pfe_hm_evt_t id, pfe_hm
 				}
 			}
 
+			/*	Called with the mutex held so that no callback runs once unregistered */
+			for (ii = 0U; ii < ARRAY_LEN(pfe_hm.event_cb); ii++)
+			{
+				if (NULL != pfe_hm.event_cb[ii])
+				{
+					pfe_hm.event_cb[ii](&item);
+				}
+			}
+
 			if (EOK != oal_mutex_unlock(&pfe_hm.mutex))
 			{
 				NXP_LOG_RAW_ERROR("Mutex unlock failed\n");
@@ -369,11 +380,6 @@ void pfe_hm_report(pfe_hm_src_t src, pfe_hm_type_t type, pfe_hm_evt_t id, pfe_hm
 		{
 			NXP_LOG_RAW_ERROR("Mutex init or lock failed\n");
 		}
-
-		if (NULL != pfe_hm.event_cb)
-		{
-			pfe_hm.event_cb(&item);
-		}
 	}
 }
 
@@ -425,6 +431,8 @@ errno_t pfe_hm_get(pfe_hm_item_t *item)
 
 /**
  * @brief	Registers callback for new events
+ * @details	The callback is called from pfe_hm_report() with the HM mutex held. It must
+ *			not report HM events nor (un)register callbacks.
  *
  * @param[in]	cb Callback
  * @returns	Successfulness of the registration
@@ -432,15 +440,70 @@ errno_t pfe_hm_get(pfe_hm_item_t *item)
 bool_t pfe_hm_register_event_cb(pfe_hm_cb_t cb)
 {
 	bool_t ret = FALSE;
+	uint32_t ii;
 
-	if (NULL == pfe_hm.event_cb)
+	if (TRUE == pfe_hm.initialized)
 	{
-		pfe_hm.event_cb = cb;
-		ret = TRUE;
+		if (EOK != oal_mutex_lock(&pfe_hm.mutex))
+		{
+			NXP_LOG_RAW_ERROR("Mutex lock failed\n");
+		}
+		else
+		{
+			for (ii = 0U; ii < ARRAY_LEN(pfe_hm.event_cb); ii++)
+			{
+				if (NULL == pfe_hm.event_cb[ii])
+				{
+					pfe_hm.event_cb[ii] = cb;
+					ret = TRUE;
+					break;
+				}
+			}
+
+			if (EOK != oal_mutex_unlock(&pfe_hm.mutex))
+			{
+				NXP_LOG_RAW_ERROR("Mutex unlock failed\n");
+			}
+		}
 	}
+
 	return ret;
 }
 
+/**
+ * @brief	Unregisters callback previously registered by pfe_hm_register_event_cb()
+ * @details	The callback is not running anymore once the function returns.
+ *
+ * @param[in]	cb Callback
+ */
+void pfe_hm_unregister_event_cb(pfe_hm_cb_t cb)
+{
+	uint32_t ii;
+
+	if (TRUE == pfe_hm.initialized)
+	{
+		if (EOK != oal_mutex_lock(&pfe_hm.mutex))
+		{
+			NXP_LOG_RAW_ERROR("Mutex lock failed\n");
+		}
+		else
+		{
+			for (ii = 0U; ii < ARRAY_LEN(pfe_hm.event_cb); ii++)
+			{
+				if (cb == pfe_hm.event_cb[ii])
+				{
+					pfe_hm.event_cb[ii] = NULL;
+				}
+			}
+
+			if (EOK != oal_mutex_unlock(&pfe_hm.mutex))
+			{
+				NXP_LOG_RAW_ERROR("Mutex unlock failed\n");
+			}
+		}
+	}
+}
+
 #ifdef PFE_CFG_HM_STRINGS_ENABLED
 /**
  * @brief	Converts event ID to string representation
@@ -46,6 +46,11 @@
 #include "pfe_feature_mgr.h"
 #include "pfe_l2br.h"
 
+/**
+ * @brief	Number of MAC table entries deleted at once by the learned entries flush
+ */
+#define PFE_L2BR_CFG_FLUSH_BATCH_SIZE	16U
+
 /**
  * @brief	The L2 Bridge instance structure
  */
@@ -204,11 +209,11 @@ static errno_t pfe_l2br_set_static_entry(const pfe_l2br_t *bridge, uint16_t vlan
 static void pfe_l2br_create_domain(const pfe_class_t *class, pfe_l2br_t **bridge, uint16_t def_vlan, uint16_t def_aging_time);
 static errno_t pfe_l2br_flush_static_mac_table(pfe_l2br_t *bridge);
 static errno_t pfe_l2br_flush_all_mac_table(const pfe_l2br_t *bridge);
-static errno_t pfe_l2br_flush_learned_mac_table(const pfe_l2br_t *bridge, pfe_l2br_table_entry_t *entry, pfe_l2br_table_iterator_t *l2t_iter);
+static errno_t pfe_l2br_flush_learned_mac_table(const pfe_l2br_t *bridge, pfe_l2br_table_iterator_t *l2t_iter);
 static errno_t pfe_l2br_static_add_entry(pfe_l2br_t *bridge, uint16_t vlan, const pfe_mac_addr_t mac, uint32_t new_fw_list, pfe_l2br_static_entry_t *static_entry);
 static errno_t pfe_l2br_domain_destroy_instance(pfe_l2br_domain_t *domain);
 static errno_t pfe_l2br_domain_flush_by_if_static(const pfe_l2br_domain_t *domain, const pfe_l2br_t *bridge, uint32_t iface_bitflag);
-static errno_t pfe_l2br_domain_flush_by_if_dynamic_static(const pfe_l2br_domain_t *domain, const pfe_l2br_t *bridge, pfe_l2br_table_iterator_t *l2t_iter, pfe_l2br_table_entry_t *entry, uint32_t iface_bitflag);
+static errno_t pfe_l2br_domain_flush_by_if_dynamic_static(const pfe_l2br_domain_t *domain, const pfe_l2br_t *bridge, pfe_ct_phy_if_id_t iface_id);
 
 /**
  * @brief		Write bridge domain structure to classifier memory
@@ -1697,36 +1702,18 @@ static errno_t pfe_l2br_domain_flush_by_if_static(const pfe_l2br_domain_t *domai
 	return ret;
 }
 
-static errno_t pfe_l2br_domain_flush_by_if_dynamic_static(const pfe_l2br_domain_t *domain, const pfe_l2br_t *bridge, pfe_l2br_table_iterator_t *l2t_iter, pfe_l2br_table_entry_t *entry, uint32_t iface_bitflag)
+static errno_t pfe_l2br_domain_flush_by_if_dynamic_static(const pfe_l2br_domain_t *domain, const pfe_l2br_t *bridge, pfe_ct_phy_if_id_t iface_id)
 {
 	errno_t ret = EOK;
-    errno_t ret_query = EOK;
-	uint16_t entry_vlan = 0U;
-	pfe_ct_mac_table_result_t entry_action_data = {.val = 0U};
 
-	ret = pfe_l2br_domain_flush_by_if_static(domain, bridge, iface_bitflag);
+	ret = pfe_l2br_domain_flush_by_if_static(domain, bridge, (uint32_t)1U << (uint32_t)iface_id);
 	if (EOK == ret)
 	{
 		/*	Flush interface-related dynamic entries */
-		ret_query = pfe_l2br_table_get_first(bridge->mac_table, l2t_iter, L2BR_TABLE_CRIT_VALID, entry);
-		while (EOK == ret_query)
+		ret = pfe_l2br_table_flush_by_port(bridge->mac_table, iface_id, domain->vlan);
+		if (EOK != ret)
 		{
-			entry_vlan = (uint16_t)pfe_l2br_table_entry_get_vlan(entry);
-			entry_action_data.val = (uint32_t)pfe_l2br_table_entry_get_action_data(entry);
-
-			/*	Check entry */
-			if ((entry_vlan == domain->vlan) && (0U != (entry_action_data.item.forward_list & iface_bitflag)))
-			{
-				/*	Remove entry */
-				ret = pfe_l2br_table_del_entry(bridge->mac_table, entry);
-				if (EOK != ret)
-				{
-					NXP_LOG_ERROR("Could not delete MAC table entry: %d\n", ret);
-				}
-			}
-
-			/* Get the next entry */
-			ret_query = pfe_l2br_table_get_next(bridge->mac_table, l2t_iter, entry);
+			NXP_LOG_ERROR("Could not flush MAC table entries: %d\n", ret);
 		}
 
 		if (EOK != oal_mutex_unlock(bridge->mutex))
@@ -1748,9 +1735,6 @@ static errno_t pfe_l2br_domain_flush_by_if_dynamic_static(const pfe_l2br_domain_
 errno_t pfe_l2br_domain_flush_by_if(const pfe_l2br_domain_t *domain, const pfe_phy_if_t *iface)
 {
 	errno_t                    ret = EOK;
-	pfe_l2br_table_entry_t *   entry = NULL;
-	pfe_l2br_table_iterator_t *l2t_iter = NULL;
-	uint32_t                   iface_bitflag = 0U;
 	const pfe_l2br_t *         bridge = NULL;
 
 #if defined(PFE_CFG_NULL_ARG_CHECK)
@@ -1771,17 +1755,7 @@ errno_t pfe_l2br_domain_flush_by_if(const pfe_l2br_domain_t *domain, const pfe_p
 		}
 		else
 		{
-			/*	Initalize auxiliary tools for MAC table searching */
-			iface_bitflag = (uint32_t)1 << (uint32_t)pfe_phy_if_get_id(iface);
-			entry = pfe_l2br_table_entry_create(bridge->mac_table);
-			l2t_iter = pfe_l2br_iterator_create();
-
-			ret = pfe_l2br_domain_flush_by_if_dynamic_static(domain, bridge, l2t_iter, entry, iface_bitflag);
-			/*	Release entry storage */
-			(void)pfe_l2br_table_entry_destroy(entry);
-
-			/*  Release iterator */
-			(void)pfe_l2br_iterator_destroy(l2t_iter);
+			ret = pfe_l2br_domain_flush_by_if_dynamic_static(domain, bridge, pfe_phy_if_get_id(iface));
 		}
 	}
 	return ret;
@@ -2958,30 +2932,85 @@ static errno_t pfe_l2br_flush_all_mac_table(const pfe_l2br_t *bridge)
 
 /*
  * @brief		Flush learned MAC table entries
+ * @details		Entries are deleted in batches of PFE_L2BR_CFG_FLUSH_BATCH_SIZE. Deleting
+ *				an entry can move another entry of the same bucket so the table walk is
+ *				restarted after every batch.
  * @param[in]	bridge The bridge instance
- * @param[in]	entry Entry will be written at this location
+ * @param[in]	l2t_iter The iterator to be used
  * @return		EOK if success, error code otherwise
  */
-static errno_t pfe_l2br_flush_learned_mac_table(const pfe_l2br_t *bridge, pfe_l2br_table_entry_t *entry, pfe_l2br_table_iterator_t *l2t_iter)
+static errno_t pfe_l2br_flush_learned_mac_table(const pfe_l2br_t *bridge, pfe_l2br_table_iterator_t *l2t_iter)
 {
+	pfe_l2br_table_batch_op_t ops[PFE_L2BR_CFG_FLUSH_BATCH_SIZE];
 	errno_t ret = EOK;
 	errno_t query_ret;
+	uint32_t ii, count, deleted;
 
-	/*	Go through all entries */
-	query_ret = pfe_l2br_table_get_first(bridge->mac_table, l2t_iter, L2BR_TABLE_CRIT_VALID, entry);
-	while (EOK == query_ret)
+	/*	Create entry storage */
+	for (ii = 0U; ii < PFE_L2BR_CFG_FLUSH_BATCH_SIZE; ii++)
 	{
-		if (FALSE == pfe_l2br_table_entry_is_static(entry))
+		ops[ii].op = L2BR_TABLE_OP_DEL;
+		ops[ii].entry = pfe_l2br_table_entry_create(bridge->mac_table);
+		if (NULL == ops[ii].entry)
 		{
-			/*	Remove non-static entry from table */
-			ret = pfe_l2br_table_del_entry(bridge->mac_table, entry);
-			if (EOK != ret)
+			ret = ENOMEM;
+		}
+	}
+
+	if (EOK == ret)
+	{
+		/*	Learned entries must be visible */
+		(void)pfe_l2br_table_sync(bridge->mac_table, 0U);
+
+		do
+		{
+			/*	Collect the next batch of non-static entries */
+			count = 0U;
+			query_ret = pfe_l2br_table_get_first(bridge->mac_table, l2t_iter, L2BR_TABLE_CRIT_VALID, ops[count].entry);
+			while (EOK == query_ret)
 			{
-				NXP_LOG_ERROR("Could not delete MAC table entry: %d\n", ret);
+				if (FALSE == pfe_l2br_table_entry_is_static(ops[count].entry))
+				{
+					count++;
+					if (PFE_L2BR_CFG_FLUSH_BATCH_SIZE == count)
+					{
+						break;
+					}
+				}
+
+				query_ret = pfe_l2br_table_get_next(bridge->mac_table, l2t_iter, ops[count].entry);
 			}
-		}
 
-		query_ret = pfe_l2br_table_get_next(bridge->mac_table, l2t_iter, entry);
+			deleted = 0U;
+			if (0U != count)
+			{
+				(void)pfe_l2br_table_batch(bridge->mac_table, ops, count);
+				for (ii = 0U; ii < count; ii++)
+				{
+					if (EOK != ops[ii].ret)
+					{
+						NXP_LOG_ERROR("Could not delete MAC table entry: %d\n", ops[ii].ret);
+						ret = ops[ii].ret;
+					}
+					else
+					{
+						deleted++;
+					}
+				}
+			}
+
+			/*	A partial batch means the walk has reached the end of the table. Stop
+				also when nothing could be deleted not to collect the same entries
+				again. */
+		} while ((PFE_L2BR_CFG_FLUSH_BATCH_SIZE == count) && (0U != deleted));
+	}
+
+	for (ii = 0U; ii < PFE_L2BR_CFG_FLUSH_BATCH_SIZE; ii++)
+	{
+		if (NULL != ops[ii].entry)
+		{
+			(void)pfe_l2br_table_entry_destroy(ops[ii].entry);
+		}
 	}
 
 	return ret;
@@ -2996,7 +3025,6 @@ static errno_t pfe_l2br_flush_learned_mac_table(const pfe_l2br_t *bridge, pfe_l2
 static errno_t pfe_l2br_flush(pfe_l2br_t *bridge, pfe_l2br_flush_types type)
 {
 	errno_t                    ret = EOK;
-	pfe_l2br_table_entry_t *   entry;
 	pfe_l2br_table_iterator_t *l2t_iter;
 
 #if defined(PFE_CFG_NULL_ARG_CHECK)
@@ -3008,9 +3036,6 @@ static errno_t pfe_l2br_flush(pfe_l2br_t *bridge, pfe_l2br_flush_types type)
 	else
 #endif /* PFE_CFG_NULL_ARG_CHECK */
 	{
-		/*	Create entry storage */
-		entry = pfe_l2br_table_entry_create(bridge->mac_table);
-
 		/*	 Create iterator */
 		l2t_iter = pfe_l2br_iterator_create();
 
@@ -3038,7 +3063,7 @@ static errno_t pfe_l2br_flush(pfe_l2br_t *bridge, pfe_l2br_flush_types type)
 
 			case PFE_L2BR_FLUSH_LEARNED_MAC:
 			{
-				ret = pfe_l2br_flush_learned_mac_table(bridge, entry, l2t_iter);
+				ret = pfe_l2br_flush_learned_mac_table(bridge, l2t_iter);
 				break;
 			}
 
@@ -3055,9 +3080,6 @@ static errno_t pfe_l2br_flush(pfe_l2br_t *bridge, pfe_l2br_flush_types type)
 			NXP_LOG_ERROR("Mutex unlock failed\n");
 		}
 
-		/*	Release entry storage */
-		(void)pfe_l2br_table_entry_destroy(entry);
-
 		/*  Release iterator */
 		(void)pfe_l2br_iterator_destroy(l2t_iter);
 	}
@@ -3347,6 +3369,28 @@ __attribute__((pure)) pfe_l2br_domain_t *pfe_l2br_get_default_domain(const pfe_l
 	return default_domain;
 }
 
+/**
+ * @brief		Get the MAC table of the bridge
+ * @param[in]	bridge The bridge instance
+ * @return		The MAC table instance or NULL if failed
+ */
+__attribute__((pure)) pfe_l2br_table_t *pfe_l2br_get_mac_table(const pfe_l2br_t *bridge)
+{
+	pfe_l2br_table_t *mac_table;
+#if defined(PFE_CFG_NULL_ARG_CHECK)
+	if (unlikely(NULL == bridge))
+	{
+		NXP_LOG_ERROR("NULL argument received\n");
+		mac_table = NULL;
+	}
+	else
+#endif /* PFE_CFG_NULL_ARG_CHECK */
+	{
+		mac_table = bridge->mac_table;
+	}
+	return mac_table;
+}
+
 /**
  * @brief		Get the fall-back bridge domain instance
  * @param[in]	bridge The bridge instance
@@ -3605,9 +3649,6 @@ uint32_t pfe_l2br_get_text_statistics(const pfe_l2br_t *bridge, struct seq_file
     errno_t ret;
     uint32_t count = 0U;
 
-	/* We keep unused parameter verb_level for consistency with rest of the *_get_text_statistics() functions */
-	(void)verb_level;
-
     /* Get memory */
     entry = pfe_l2br_table_entry_create(bridge->mac_table);
     /* Get the first entry */
@@ -3623,6 +3664,8 @@ uint32_t pfe_l2br_get_text_statistics(const pfe_l2br_t *bridge, struct seq_file
         ret = pfe_l2br_table_get_next(bridge->mac_table, l2t_iter, entry);
     }
     seq_printf(seq, "\n MAC entries count: %u\n", count);
+    (void)pfe_l2br_table_get_text_statistics(bridge->mac_table, seq, verb_level);
+    (void)pfe_l2br_table_get_text_statistics(bridge->vlan_table, seq, verb_level);
     /* Free memory */
     (void)pfe_l2br_table_entry_destroy(entry);
     (void)pfe_l2br_iterator_destroy(l2t_iter);
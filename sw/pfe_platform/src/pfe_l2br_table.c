@@ -8,6 +8,7 @@
  * ========================================================================= */
 
 #include "pfe_cfg.h"
+#include "linked_list.h"
 #include "oal.h"
 #include "hal.h"
 
@@ -19,6 +20,62 @@
 /*	MAC address type must be 48-bits long */
 ct_assert((sizeof(pfe_mac_addr_t) * 8) == 48);
 
+/**
+ * @brief	Number of buckets reconciled with the hardware by every pfe_l2br_table_get_first()
+ *			and by every period of the MAC table worker
+ * @details	Entries learned or aged by the hardware are picked up by the host copy of the
+ *			table gradually. See pfe_l2br_table_sync().
+ */
+#define PFE_L2BR_TABLE_CFG_SYNC_BUDGET		64U
+
+/**
+ * @brief	Period of the background reconciliation of the MAC table in milliseconds
+ */
+#define PFE_L2BR_TABLE_CFG_SYNC_PERIOD_MS	1000U
+
+/**
+ * @brief	Bounds of the number of status register reads done before the command
+ *			completion wait starts to sleep
+ * @details	The actual limit adapts to the observed command latency: it is doubled
+ *			whenever a command has not completed while spinning and it slowly decays
+ *			while commands complete quickly.
+ */
+#define PFE_L2BR_TABLE_CFG_SPIN_MIN			16U
+#define PFE_L2BR_TABLE_CFG_SPIN_MAX			512U
+
+/**
+ * @brief	Number of 10us sleeps before the command is considered timed-out
+ */
+#define PFE_L2BR_TABLE_CFG_SLEEP_POLLS		100U
+
+/**
+ * @brief	Number of buckets of the command latency histograms. Bucket N counts
+ *			commands completed within 2^N polls, the last one collects the rest.
+ */
+#define PFE_L2BR_TABLE_CMD_HIST_SIZE		10U
+
+/**
+ * @brief	Number of hash space addresses reachable by pfe_l2br_entry_get_hash()
+ */
+#define PFE_L2BR_TABLE_HASH_SPACE_MAX		256U
+
+/**
+ * @brief	Index of the per-port list holding MAC table entries with zero or multiple
+ *			ports in the forward list. Lists 0..PFE_PHY_IF_ID_MAX hold entries forwarding
+ *			to the single port of given ID.
+ */
+#define PFE_L2BR_TABLE_PORT_INDEX_MULTI		((uint32_t)PFE_PHY_IF_ID_MAX + 1U)
+#define PFE_L2BR_TABLE_PORT_INDEX_SIZE		(PFE_L2BR_TABLE_PORT_INDEX_MULTI + 1U)
+
+/**
+ * @brief	Per-port index item, one per table address
+ */
+typedef struct
+{
+	LLIST_t list_entry;							/*!< Entry of the l2br->port_index[] list */
+	uint32_t addr;								/*!< Table address */
+} pfe_l2br_table_port_node_t;
+
 /**
  * @brief HASH registers associated with a table
  */
@@ -38,6 +95,28 @@ typedef struct
 	addr_t free_tail_ptr_reg;	/* FREE LIST TAIL PTR */
 } pfe_mac_table_regs_t;
 
+/**
+ * @brief	Command completion statistics
+ */
+typedef struct
+{
+	uint32_t spin_limit;							/*!< Current spin limit (number of status reads)	*/
+	uint32_t spin_hist[PFE_L2BR_TABLE_CMD_HIST_SIZE];	/*!< Commands completed while spinning			*/
+	uint32_t sleep_hist[PFE_L2BR_TABLE_CMD_HIST_SIZE];	/*!< Commands completed after sleeping			*/
+	uint32_t timeouts;								/*!< Commands timed-out							*/
+} pfe_l2br_table_cmd_stats_t;
+
+typedef struct __pfe_l2br_table_event_item_tag pfe_l2br_table_event_item_t;
+
+/**
+ * @brief	Registered table change callback
+ */
+typedef struct
+{
+	pfe_l2br_table_event_cb_t cb;				/*!< The callback, NULL if the slot is free		*/
+	void *arg;									/*!< Argument passed to the callback			*/
+} pfe_l2br_table_event_cb_item_t;
+
 /**
  * @brief	The L2 Bridge table instance structure
  */
@@ -49,6 +128,27 @@ struct __pfe_l2br_table_tag
 	pfe_mac_table_regs_t regs;					/*!< Registers (VA)								*/
 	uint16_t hash_space_depth;					/*!< Hash space depth in number of entries		*/
 	uint16_t coll_space_depth;					/*!< Collision space depth in number of entries */
+	pfe_l2br_table_entry_t *shadow;				/*!< Host copy of the table indexed by address. Protected by reg_lock. */
+	uint32_t sync_addr;							/*!< Next bucket to be reconciled by pfe_l2br_table_sync() */
+	pfe_l2br_table_cmd_stats_t cmd_stats;		/*!< Command completion statistics. Protected by reg_lock. */
+	LLIST_t port_index[PFE_L2BR_TABLE_PORT_INDEX_SIZE];	/*!< Valid MAC table entries by egress port. Protected by reg_lock. */
+	pfe_l2br_table_port_node_t *port_nodes;		/*!< Index items indexed by address (MAC table only) */
+	pfe_l2br_table_entry_t *chain;				/*!< Copy of a bucket taken before its refresh. Protected by reg_lock. */
+	uint32_t *chain_addr;						/*!< Addresses of the bucket entries before and after refresh. Protected by reg_lock. */
+	pfe_l2br_table_entry_t *displaced;			/*!< Entries of other buckets overwritten by a bucket refresh. Protected by reg_lock. */
+	uint32_t displaced_cnt;						/*!< Number of items in 'displaced'				*/
+	pfe_l2br_table_event_cb_item_t event_cb[PFE_L2BR_TABLE_EVENT_CB_MAX];	/*!< Table change callbacks. Protected by reg_lock. */
+	uint32_t event_cb_cnt;						/*!< Number of registered callbacks				*/
+	pfe_l2br_table_event_item_t *evt_queue;		/*!< Events waiting for delivery. Protected by reg_lock. */
+	uint32_t evt_queue_size;					/*!< Capacity of the event queue				*/
+	uint32_t evt_head;							/*!< Index of the next event to be delivered	*/
+	uint32_t evt_count;							/*!< Number of events in the queue				*/
+	uint32_t evt_dropped;						/*!< Number of events lost due to full queue	*/
+	oal_mutex_t evt_lock;						/*!< Lock serializing the event delivery		*/
+#if !defined(PFE_CFG_TARGET_OS_AUTOSAR)
+	oal_thread_t *worker;						/*!< Worker thread reconciling the MAC table	*/
+	oal_mbox_t *mbox;							/*!< Message box to communicate with the worker thread */
+#endif /* !defined(PFE_CFG_TARGET_OS_AUTOSAR) */
 };
 
 struct __pfe_l2br_table_iterator_tag
@@ -159,6 +259,28 @@ struct __pfe_l2br_table_entry_tag
 	bool_t vlan_set;
 };
 
+/**
+ * @brief	Table change event waiting for delivery
+ */
+struct __pfe_l2br_table_event_item_tag
+{
+	pfe_l2br_table_event_t event;				/*!< The event									*/
+	pfe_l2br_table_entry_t entry;				/*!< Copy of the affected entry					*/
+};
+
+#if !defined(PFE_CFG_TARGET_OS_AUTOSAR)
+/**
+ * @brief	Worker thread signals
+ * @details	Driver is sending signals to the worker thread to request specific
+ *			operations.
+ */
+enum pfe_l2br_table_worker_signals
+{
+	SIG_WORKER_STOP,	/*	!< Stop the thread */
+	SIG_TIMER_TICK		/*	!< Pulse from timer */
+};
+#endif /* !defined(PFE_CFG_TARGET_OS_AUTOSAR) */
+
 #ifdef PFE_CFG_TARGET_OS_AUTOSAR
 #define ETH_43_PFE_START_SEC_CODE
 #include "Eth_43_PFE_MemMap.h"
@@ -167,7 +289,8 @@ struct __pfe_l2br_table_entry_tag
 static errno_t pfe_l2br_table_init_cmd(pfe_l2br_table_t *l2br);
 static errno_t pfe_l2br_table_write_cmd(pfe_l2br_table_t *l2br, uint32_t addr, pfe_l2br_table_entry_t *entry);
 static errno_t pfe_l2br_table_read_cmd(pfe_l2br_table_t *l2br, uint32_t addr, pfe_l2br_table_entry_t *entry);
-static errno_t pfe_l2br_wait_for_cmd_done(const pfe_l2br_table_t *l2br, uint32_t *status_val);
+static errno_t pfe_l2br_wait_for_cmd_done(pfe_l2br_table_t *l2br, uint32_t *status_val);
+static uint32_t pfe_l2br_table_cmd_hist_bucket(uint32_t polls);
 static errno_t pfe_l2br_entry_to_cmd_args(const pfe_l2br_table_t *l2br, pfe_l2br_table_entry_t *entry);
 static uint32_t pfe_l2br_table_get_col_ptr(const pfe_l2br_table_entry_t *entry);
 static void pfe_l2br_get_data(const pfe_l2br_table_t *l2br, pfe_l2br_table_entry_t *entry);
@@ -180,6 +303,25 @@ static errno_t pfe_l2br_table_flush_cmd(pfe_l2br_table_t *l2br);
 static uint8_t pfe_l2br_entry_get_hash(const pfe_l2br_table_entry_t *entry);
 static void pfe_l2br_iterator_save_macvlan(pfe_l2br_table_iterator_t *l2t_iter, const pfe_l2br_table_entry_t *entry);
 static bool_t pfe_l2br_iterator_is_macvlan_match(const pfe_l2br_table_iterator_t *l2t_iter, const pfe_l2br_table_entry_t *entry);
+static errno_t pfe_l2br_table_shadow_read(pfe_l2br_table_t *l2br, uint32_t addr, pfe_l2br_table_entry_t *entry);
+static errno_t pfe_l2br_table_shadow_fetch_bucket(pfe_l2br_table_t *l2br, uint32_t hash);
+static errno_t pfe_l2br_table_shadow_refresh_bucket(pfe_l2br_table_t *l2br, uint32_t hash);
+static bool_t pfe_l2br_table_shadow_is_valid(const pfe_l2br_table_t *l2br, const pfe_l2br_table_entry_t *entry);
+static bool_t pfe_l2br_table_shadow_is_owner(const pfe_l2br_table_t *l2br, uint32_t addr, uint32_t hash);
+static void pfe_l2br_table_entry_set_invalid(const pfe_l2br_table_t *l2br, pfe_l2br_table_entry_t *entry);
+static void pfe_l2br_table_shadow_invalidate(pfe_l2br_table_t *l2br, uint32_t addr);
+static bool_t pfe_l2br_table_entry_same_key(const pfe_l2br_table_t *l2br, const pfe_l2br_table_entry_t *entry1, const pfe_l2br_table_entry_t *entry2);
+static bool_t pfe_l2br_table_entry_same_data(const pfe_l2br_table_t *l2br, const pfe_l2br_table_entry_t *entry1, const pfe_l2br_table_entry_t *entry2);
+static void pfe_l2br_table_event_post(pfe_l2br_table_t *l2br, pfe_l2br_table_event_t event, const pfe_l2br_table_entry_t *entry);
+static void pfe_l2br_table_event_deliver(pfe_l2br_table_t *l2br);
+static bool_t pfe_l2br_table_shadow_find(const pfe_l2br_table_t *l2br, pfe_l2br_table_entry_t *entry);
+static void pfe_l2br_table_port_index_init(pfe_l2br_table_t *l2br);
+static void pfe_l2br_table_port_index_update(pfe_l2br_table_t *l2br, uint32_t addr);
+static bool_t pfe_l2br_table_entry_is_aging(const pfe_l2br_table_t *l2br, const pfe_l2br_table_entry_t *entry);
+#if !defined(PFE_CFG_TARGET_OS_AUTOSAR)
+static void *pfe_l2br_table_worker_func(void *arg);
+static void pfe_l2br_table_worker_stop(pfe_l2br_table_t *l2br);
+#endif /* !defined(PFE_CFG_TARGET_OS_AUTOSAR) */
 
 /**
  * @brief		Match entry with latest criterion provided via pfe_l2br_table_get_first()
@@ -688,12 +830,19 @@ errno_t pfe_l2br_table_update_entry(pfe_l2br_table_t *l2br, pfe_l2br_table_entry
 	}
 
 	ret = pfe_l2br_table_do_update_entry_nolock(l2br, entry);
+	if (EINVAL != ret)
+	{
+		/*	Keep the host copy of the table up to date */
+		(void)pfe_l2br_table_shadow_fetch_bucket(l2br, pfe_l2br_entry_get_hash(entry));
+	}
 
 	if (EOK != oal_mutex_unlock(&l2br->reg_lock))
 	{
 		NXP_LOG_ERROR("Mutex unlock failed\n");
 	}
 
+	pfe_l2br_table_event_deliver(l2br);
+
 	return ret;
 }
 
@@ -717,12 +866,19 @@ errno_t pfe_l2br_table_del_entry(pfe_l2br_table_t *l2br, pfe_l2br_table_entry_t
 	}
 
 	ret = pfe_l2br_table_do_del_entry_nolock(l2br, entry);
+	if (EINVAL != ret)
+	{
+		/*	Keep the host copy of the table up to date */
+		(void)pfe_l2br_table_shadow_fetch_bucket(l2br, pfe_l2br_entry_get_hash(entry));
+	}
 
 	if (EOK != oal_mutex_unlock(&l2br->reg_lock))
 	{
 		NXP_LOG_ERROR("Mutex unlock failed\n");
 	}
 
+	pfe_l2br_table_event_deliver(l2br);
+
 	return ret;
 }
 
@@ -745,17 +901,123 @@ errno_t pfe_l2br_table_add_entry(pfe_l2br_table_t *l2br, pfe_l2br_table_entry_t
 	}
 
 	ret = pfe_l2br_table_do_add_entry_nolock(l2br, entry);
+	if (EINVAL != ret)
+	{
+		/*	Keep the host copy of the table up to date */
+		(void)pfe_l2br_table_shadow_fetch_bucket(l2br, pfe_l2br_entry_get_hash(entry));
+	}
+
+	if (EOK != oal_mutex_unlock(&l2br->reg_lock))
+	{
+		NXP_LOG_ERROR("Mutex unlock failed\n");
+	}
+
+	pfe_l2br_table_event_deliver(l2br);
+
+	return ret;
+}
+
+/**
+ * @brief			Execute multiple table operations at once
+ * @details			The operations are issued back-to-back in given order while the table
+ *					lock is held only once. The host copy of the table is refreshed once per
+ *					affected bucket after the last operation instead of after every command.
+ * @param[in]		l2br The L2 Bridge Table instance
+ * @param[in,out]	ops Array of operations. The 'ret' member of each item is set to the
+ *						result of the operation.
+ * @param[in]		count Number of items in the array
+ * @retval			EOK All operations succeeded
+ * @retval			EINVAL Invalid/missing argument
+ * @return			Otherwise the result of the first failed operation
+ */
+errno_t pfe_l2br_table_batch(pfe_l2br_table_t *l2br, pfe_l2br_table_batch_op_t *ops, uint32_t count)
+{
+	uint32_t touched[(PFE_L2BR_TABLE_HASH_SPACE_MAX + 31U) / 32U] = {0U};
+	uint32_t ii, hash;
+	errno_t ret = EOK;
+
+#if defined(PFE_CFG_NULL_ARG_CHECK)
+	if (unlikely((NULL == l2br) || ((NULL == ops) && (0U != count))))
+	{
+		NXP_LOG_ERROR("NULL argument received\n");
+		return EINVAL;
+	}
+#endif /* PFE_CFG_NULL_ARG_CHECK */
+
+	if (EOK != oal_mutex_lock(&l2br->reg_lock))
+	{
+		NXP_LOG_ERROR("Mutex lock failed\n");
+	}
+
+	for (ii = 0U; ii < count; ii++)
+	{
+		switch (ops[ii].op)
+		{
+			case L2BR_TABLE_OP_ADD:
+			{
+				ops[ii].ret = pfe_l2br_table_do_add_entry_nolock(l2br, ops[ii].entry);
+				break;
+			}
+
+			case L2BR_TABLE_OP_UPDATE:
+			{
+				ops[ii].ret = pfe_l2br_table_do_update_entry_nolock(l2br, ops[ii].entry);
+				break;
+			}
+
+			case L2BR_TABLE_OP_DEL:
+			{
+				ops[ii].ret = pfe_l2br_table_do_del_entry_nolock(l2br, ops[ii].entry);
+				break;
+			}
+
+			default:
+			{
+				NXP_LOG_ERROR("Invalid operation: %d\n", (int_t)ops[ii].op);
+				ops[ii].ret = EINVAL;
+				break;
+			}
+		}
+
+		if (EINVAL != ops[ii].ret)
+		{
+			/*	Remember the bucket to be refreshed */
+			hash = pfe_l2br_entry_get_hash(ops[ii].entry);
+			touched[hash / 32U] |= (1UL << (hash % 32U));
+		}
+
+		if ((EOK == ret) && (EOK != ops[ii].ret))
+		{
+			ret = ops[ii].ret;
+		}
+	}
+
+	/*	Keep the host copy of the table up to date */
+	for (hash = 0U; hash < PFE_L2BR_TABLE_HASH_SPACE_MAX; hash++)
+	{
+		if (0U != (touched[hash / 32U] & (1UL << (hash % 32U))))
+		{
+			(void)pfe_l2br_table_shadow_fetch_bucket(l2br, hash);
+		}
+	}
 
 	if (EOK != oal_mutex_unlock(&l2br->reg_lock))
 	{
 		NXP_LOG_ERROR("Mutex unlock failed\n");
 	}
 
+	pfe_l2br_table_event_deliver(l2br);
+
 	return ret;
 }
 
 /**
  * @brief			Search entry in table
+ * @details			Static entries and VLAN table entries are only modified by the driver
+ *					and are served from the host copy of the table. Other MAC table entries
+ *					can be learned, moved or aged by the hardware at any time so they are
+ *					always looked up in the hardware and the host copy of their bucket is
+ *					refreshed by the result.
  * @param[in]		l2br The L2 Bridge Table instance
  * @param[in,out]	data Reference entry to be used for lookup. This entry will be updated by
  * 						 values read from the table.
@@ -766,6 +1028,8 @@ errno_t pfe_l2br_table_add_entry(pfe_l2br_table_t *l2br, pfe_l2br_table_entry_t
  */
 errno_t pfe_l2br_table_search_entry(pfe_l2br_table_t *l2br, pfe_l2br_table_entry_t *entry)
 {
+	pfe_l2br_table_entry_t cached;
+	bool_t found, mismatch;
 	errno_t ret = EOK;
 
 	if (EOK != oal_mutex_lock(&l2br->reg_lock))
@@ -773,13 +1037,41 @@ errno_t pfe_l2br_table_search_entry(pfe_l2br_table_t *l2br, pfe_l2br_table_entry
 		NXP_LOG_ERROR("Mutex lock failed\n");
 	}
 
-	ret = pfe_l2br_table_do_search_entry_nolock(l2br, entry);
+	found = pfe_l2br_table_shadow_find(l2br, entry);
+	if ((TRUE == found) && (FALSE == pfe_l2br_table_entry_is_aging(l2br, entry)))
+	{
+		/*	Static entries are maintained by the host only */
+		ret = EOK;
+	}
+	else
+	{
+		/*	Might be learned, moved or aged by the hardware since the last reconciliation.
+			Verify the host copy by the SEARCH command and re-read the bucket only when
+			the hardware disagrees. */
+		(void)memcpy(&cached, entry, sizeof(pfe_l2br_table_entry_t));
+		ret = pfe_l2br_table_do_search_entry_nolock(l2br, entry);
+		if (EOK == ret)
+		{
+			mismatch = (FALSE == found) || (FALSE == pfe_l2br_table_entry_same_data(l2br, entry, &cached));
+		}
+		else
+		{
+			mismatch = (ENOENT == ret) && (TRUE == found);
+		}
+
+		if (TRUE == mismatch)
+		{
+			(void)pfe_l2br_table_shadow_fetch_bucket(l2br, pfe_l2br_entry_get_hash(entry));
+		}
+	}
 
 	if (EOK != oal_mutex_unlock(&l2br->reg_lock))
 	{
 		NXP_LOG_ERROR("Mutex unlock failed\n");
 	}
 
+	pfe_l2br_table_event_deliver(l2br);
+
 	return ret;
 }
 
@@ -917,111 +1209,1025 @@ static bool_t pfe_l2br_iterator_is_macvlan_match(const pfe_l2br_table_iterator_t
 }
 
 /**
- * @brief			Get first entry from table
- * @param[in]		l2br The L2 Bridge Table instance
- * @param[in]		crit Get criterion
- * @param[out]		entry Entry will be written at this location
- * @retval			EOK Success
- * @retval			EINVAL Invalid/missing argument
- * @retval			ENOENT Entry not found
- * @retval			ETIMEDOUT Command timed-out
+ * @brief		Get entry from the host copy of the table
+ * @details		Counterpart of pfe_l2br_table_read_cmd() served from memory.
+ * @param[in]	l2br The L2 Bridge table instance
+ * @param[in]	addr Address within the table (index of entry to be read)
+ * @param[out]	entry Entry will be written at this location
+ * @retval		EOK Success
+ * @retval		EINVAL Address is out of range
  */
-errno_t pfe_l2br_table_get_first(pfe_l2br_table_t *l2br, pfe_l2br_table_iterator_t *l2t_iter, pfe_l2br_table_get_criterion_t crit, pfe_l2br_table_entry_t *entry)
+static errno_t pfe_l2br_table_shadow_read(pfe_l2br_table_t *l2br, uint32_t addr, pfe_l2br_table_entry_t *entry)
 {
-	errno_t ret = ENOENT;
-
-#if defined(PFE_CFG_NULL_ARG_CHECK)
-	if (unlikely((NULL == l2br) || (NULL == entry)))
+	if (addr >= ((uint32_t)l2br->hash_space_depth + l2br->coll_space_depth))
 	{
-		NXP_LOG_ERROR("NULL argument received\n");
+		NXP_LOG_ERROR("Hash table address 0x%x is out of range\n", (uint_t)addr);
 		return EINVAL;
 	}
-#endif /* PFE_CFG_NULL_ARG_CHECK */
 
-	/*	Remember criterion and argument for possible subsequent pfe_l2br_table_get_next() calls */
-	l2t_iter->cur_crit = crit;
+	if (EOK != oal_mutex_lock(&l2br->reg_lock))
+	{
+		NXP_LOG_ERROR("Mutex lock failed\n");
+	}
 
-	/*	Get entries from address 0x0 */
-	memset(&l2t_iter->cur_macvlan, 0U, sizeof(l2t_iter->cur_macvlan)); 
-	for (l2t_iter->cur_hash_addr=0U, l2t_iter->cur_coll_addr=0U; l2t_iter->cur_hash_addr<l2br->hash_space_depth; l2t_iter->cur_hash_addr++)
+	(void)memcpy(entry, &l2br->shadow[addr], sizeof(pfe_l2br_table_entry_t));
+
+	if (EOK != oal_mutex_unlock(&l2br->reg_lock))
 	{
-		ret = pfe_l2br_table_read_cmd(l2br, l2t_iter->cur_hash_addr, entry);
-		if (EOK != ret)
-		{
-			NXP_LOG_ERROR("Can not read table entry from location %d\n", (int_t)l2t_iter->cur_hash_addr);
-			break;
-		}
-		else
+		NXP_LOG_ERROR("Mutex unlock failed\n");
+	}
+
+	return EOK;
+}
+
+/**
+ * @brief		Refresh the host copy of a bucket
+ * @details		Reads the hash space slot and the collision chain following it. To be
+ *				called after every command modifying the table. Collision space entries
+ *				which are not part of the chain anymore are marked invalid and the
+ *				differences against the previous content of the bucket are reported
+ *				as table change events.
+ * @details		The hardware learning and aging can hand a collision slot over to another
+ *				bucket between two refreshes. When the refreshed bucket takes over a slot
+ *				the host copy still holds for another bucket, that bucket is refreshed
+ *				too so that its entry is either found at the new place or reported
+ *				as removed.
+ * @param[in]	l2br The L2 Bridge table instance
+ * @param[in]	hash The bucket (hash of the MAC/VLAN)
+ * @retval		EOK Success
+ * @retval		ETIMEDOUT Command timed-out
+ * @warning		This function shouldn't be called directly. Call with register lock.
+ */
+static errno_t pfe_l2br_table_shadow_fetch_bucket(pfe_l2br_table_t *l2br, uint32_t hash)
+{
+	uint32_t ii;
+	errno_t ret;
+
+	l2br->displaced_cnt = 0U;
+	ret = pfe_l2br_table_shadow_refresh_bucket(l2br, hash);
+
+	/*	Every refresh consumes the displaced entries of its bucket and may add new
+		ones. The list is bounded by the collision space. */
+	for (ii = 0U; (EOK == ret) && (ii < l2br->displaced_cnt); ii++)
+	{
+		if (TRUE == pfe_l2br_table_shadow_is_valid(l2br, &l2br->displaced[ii]))
 		{
-			l2t_iter->cur_coll_addr = l2t_iter->cur_hash_addr; /* cur_coll_addr is utilized to store address of previous valid MAC entry from HW, regardless of hash/coll space */
-			pfe_l2br_iterator_save_macvlan(l2t_iter, entry);
-			if (TRUE == pfe_l2br_table_entry_match_criterion(l2br, l2t_iter, entry))
-			{
-				/*	Remember entry to be processed next */
-				l2t_iter->next_coll_addr = pfe_l2br_table_get_col_ptr(entry);
-				l2t_iter->cur_hash_addr++;
-				return EOK;
-			}
+			ret = pfe_l2br_table_shadow_refresh_bucket(l2br, pfe_l2br_entry_get_hash(&l2br->displaced[ii]));
 		}
 	}
 
-	return ENOENT;
+	l2br->displaced_cnt = 0U;
+
+	return ret;
 }
 
 /**
- * @brief			Get next entry from table
- * @param[in]		l2br The L2 Bridge Table instance
- * @param[in]		addr Address within the table to read entry from
- * @param[out]		entry Entry will be written at this location
- * @retval			EOK Success
- * @retval			EINVAL Invalid/missing argument
- * @retval			ENOENT Entry not found
- * @retval			ETIMEDOUT Command timed-out
+ * @brief		Refresh the host copy of a single bucket
+ * @details		See pfe_l2br_table_shadow_fetch_bucket().
+ * @param[in]	l2br The L2 Bridge table instance
+ * @param[in]	hash The bucket (hash of the MAC/VLAN)
+ * @retval		EOK Success
+ * @retval		ETIMEDOUT Command timed-out
+ * @warning		This function shouldn't be called directly. Call with register lock.
  */
-errno_t pfe_l2br_table_get_next(pfe_l2br_table_t *l2br, pfe_l2br_table_iterator_t *l2t_iter, pfe_l2br_table_entry_t *entry)
+static errno_t pfe_l2br_table_shadow_refresh_bucket(pfe_l2br_table_t *l2br, uint32_t hash)
 {
-	errno_t ret;
+	const uint32_t size = (uint32_t)l2br->hash_space_depth + l2br->coll_space_depth;
+	uint32_t *old_addr = &l2br->chain_addr[0];
+	uint32_t *new_addr = &l2br->chain_addr[(uint32_t)l2br->coll_space_depth + 1U];
+	uint32_t old_cnt = 0U, new_cnt = 0U;
+	uint32_t addr, ii, jj;
+	const pfe_l2br_table_entry_t *item;
+	bool_t found;
+	errno_t ret = EOK;
 
-#if defined(PFE_CFG_NULL_ARG_CHECK)
-	if (unlikely((NULL == l2br) || (NULL == entry)))
+	/*	Remember the current content of the bucket. The chain pointers of the host
+		copy may be stale and lead to a slot already taken over by another bucket,
+		the walk stops at the first slot not holding an entry of this bucket. */
+	addr = hash;
+	for (ii = 0U; ii <= l2br->coll_space_depth; ii++)
 	{
-		NXP_LOG_ERROR("NULL argument received\n");
-		return EINVAL;
+		if ((addr != hash) && (FALSE == pfe_l2br_table_shadow_is_owner(l2br, addr, hash)))
+		{
+			break;
+		}
+
+		old_addr[old_cnt] = addr;
+		(void)memcpy(&l2br->chain[old_cnt], &l2br->shadow[addr], sizeof(pfe_l2br_table_entry_t));
+		old_cnt++;
+
+		addr = pfe_l2br_table_get_col_ptr(&l2br->shadow[addr]);
+		if ((addr < l2br->hash_space_depth) || (addr >= size))
+		{
+			/*	End of the chain */
+			break;
+		}
 	}
-#endif /* PFE_CFG_NULL_ARG_CHECK */
 
-	/*	Get entries from last address */
-	while ((l2t_iter->cur_hash_addr < l2br->hash_space_depth) || (0U != l2t_iter->next_coll_addr) )
+	/*	Entries of this bucket overwritten by refresh of another bucket. Their slots
+		belong to the other bucket now and must not be invalidated. */
+	for (ii = 0U; (ii < l2br->displaced_cnt) && (old_cnt <= l2br->coll_space_depth); ii++)
 	{
-		if (0U == l2t_iter->next_coll_addr)
+		if ((TRUE == pfe_l2br_table_shadow_is_valid(l2br, &l2br->displaced[ii]))
+				&& (hash == pfe_l2br_entry_get_hash(&l2br->displaced[ii])))
 		{
-			/*	Read from hash space */
-			ret = pfe_l2br_table_read_cmd(l2br, l2t_iter->cur_hash_addr, entry);
-			if (EOK == ret)
-			{
-				/*	candidate MAC entry found */
-				l2t_iter->cur_coll_addr = l2t_iter->cur_hash_addr; /* cur_coll_addr is utilized to store address of previous valid MAC entry from HW, regardless of hash/coll space */
-				l2t_iter->cur_hash_addr++;
-				pfe_l2br_iterator_save_macvlan(l2t_iter, entry);
-			}
+			old_addr[old_cnt] = size;
+			(void)memcpy(&l2br->chain[old_cnt], &l2br->displaced[ii], sizeof(pfe_l2br_table_entry_t));
+			old_cnt++;
+			pfe_l2br_table_entry_set_invalid(l2br, &l2br->displaced[ii]);
 		}
-		else
+	}
+
+	/*	Read the bucket. Chain can't be longer than the collision space. */
+	addr = hash;
+	for (ii = 0U; ii <= l2br->coll_space_depth; ii++)
+	{
+		if ((addr != hash) && (l2br->displaced_cnt < l2br->coll_space_depth)
+				&& (TRUE == pfe_l2br_table_shadow_is_valid(l2br, &l2br->shadow[addr]))
+				&& (FALSE == pfe_l2br_table_shadow_is_owner(l2br, addr, hash)))
 		{
-			/*	Read from collision space */
-			ret = pfe_l2br_table_read_cmd(l2br, l2t_iter->next_coll_addr, entry);
-			if (EOK == ret)
+			/*	Slot has been taken over from another bucket. Keep its entry until
+				the owning bucket is refreshed. */
+			(void)memcpy(&l2br->displaced[l2br->displaced_cnt], &l2br->shadow[addr], sizeof(pfe_l2br_table_entry_t));
+			l2br->displaced_cnt++;
+		}
+
+		ret = pfe_l2br_table_read_cmd(l2br, addr, &l2br->shadow[addr]);
+		if (EOK != ret)
+		{
+			break;
+		}
+
+		new_addr[new_cnt] = addr;
+		new_cnt++;
+		pfe_l2br_table_port_index_update(l2br, addr);
+
+		addr = pfe_l2br_table_get_col_ptr(&l2br->shadow[addr]);
+		if ((addr < l2br->hash_space_depth) || (addr >= size))
+		{
+			/*	End of the chain */
+			break;
+		}
+	}
+
+	if (EOK == ret)
+	{
+		/*	Collision space entries which have left the chain are free now. Drop
+			them from the host copy (and from the per-port index) as they are not
+			reachable by any later bucket refresh. */
+		for (ii = 0U; ii < old_cnt; ii++)
+		{
+			found = (old_addr[ii] >= size);
+			for (jj = 0U; (FALSE == found) && (jj < new_cnt); jj++)
 			{
-				/*	check hash ; by design of the lookup routine, iterator's actual cur_hash_addr is already +1 ahead */
-				if ((l2t_iter->cur_hash_addr - 1U) == pfe_l2br_entry_get_hash(entry))
+				if (old_addr[ii] == new_addr[jj])
 				{
-					/*	=== hash OK === ; candidate MAC entry found */
-					l2t_iter->cur_coll_addr = l2t_iter->next_coll_addr; /* cur_coll_addr is utilized to store address of previous valid MAC entry from HW, regardless of hash/coll space */
-					pfe_l2br_iterator_save_macvlan(l2t_iter, entry);
+					found = TRUE;
+					break;
 				}
-				else
+			}
+
+			if (FALSE == found)
+			{
+				pfe_l2br_table_shadow_invalidate(l2br, old_addr[ii]);
+			}
+		}
+
+		if (0U != l2br->event_cb_cnt)
+		{
+			/*	New and changed entries */
+			for (ii = 0U; ii < new_cnt; ii++)
+			{
+				item = &l2br->shadow[new_addr[ii]];
+				if (TRUE == pfe_l2br_table_shadow_is_valid(l2br, item))
+				{
+					found = FALSE;
+					for (jj = 0U; jj < old_cnt; jj++)
+					{
+						if ((TRUE == pfe_l2br_table_shadow_is_valid(l2br, &l2br->chain[jj]))
+								&& (TRUE == pfe_l2br_table_entry_same_key(l2br, item, &l2br->chain[jj])))
+						{
+							found = TRUE;
+							break;
+						}
+					}
+
+					if (FALSE == found)
+					{
+						pfe_l2br_table_event_post(l2br, L2BR_TABLE_EVT_ADDED, item);
+					}
+					else if (FALSE == pfe_l2br_table_entry_same_data(l2br, item, &l2br->chain[jj]))
+					{
+						pfe_l2br_table_event_post(l2br, L2BR_TABLE_EVT_CHANGED, item);
+					}
+					else
+					{
+						;	/*	No change */
+					}
+				}
+			}
+
+			/*	Removed entries */
+			for (jj = 0U; jj < old_cnt; jj++)
+			{
+				if (TRUE == pfe_l2br_table_shadow_is_valid(l2br, &l2br->chain[jj]))
+				{
+					found = FALSE;
+					for (ii = 0U; ii < new_cnt; ii++)
+					{
+						item = &l2br->shadow[new_addr[ii]];
+						if ((TRUE == pfe_l2br_table_shadow_is_valid(l2br, item))
+								&& (TRUE == pfe_l2br_table_entry_same_key(l2br, item, &l2br->chain[jj])))
+						{
+							found = TRUE;
+							break;
+						}
+					}
+
+					if (FALSE == found)
+					{
+						pfe_l2br_table_event_post(l2br, L2BR_TABLE_EVT_REMOVED, &l2br->chain[jj]);
+					}
+				}
+			}
+		}
+	}
+
+	return ret;
+}
+
+/**
+ * @brief		Check whether entry of the host copy of the table is valid
+ * @param[in]	l2br The L2 Bridge table instance
+ * @param[in]	entry The entry
+ * @return		TRUE if the entry is valid, FALSE otherwise
+ */
+static bool_t pfe_l2br_table_shadow_is_valid(const pfe_l2br_table_t *l2br, const pfe_l2br_table_entry_t *entry)
+{
+	bool_t valid;
+
+	if (PFE_L2BR_TABLE_MAC2F == l2br->type)
+	{
+		valid = (0U != (entry->u.mac2f_entry.flags & (uint32_t)MAC2F_ENTRY_VALID_FLAG));
+	}
+	else
+	{
+		valid = (0U != (entry->u.vlan_entry.flags & (uint32_t)VLAN_ENTRY_VALID_FLAG));
+	}
+
+	return valid;
+}
+
+/**
+ * @brief		Check whether slot of the host copy of the table holds entry of given bucket
+ * @param[in]	l2br The L2 Bridge table instance
+ * @param[in]	addr Address within the table
+ * @param[in]	hash The bucket
+ * @return		TRUE if the slot holds a valid entry hashing to the bucket, FALSE otherwise
+ */
+static bool_t pfe_l2br_table_shadow_is_owner(const pfe_l2br_table_t *l2br, uint32_t addr, uint32_t hash)
+{
+	return (TRUE == pfe_l2br_table_shadow_is_valid(l2br, &l2br->shadow[addr]))
+				&& (hash == (uint32_t)pfe_l2br_entry_get_hash(&l2br->shadow[addr]));
+}
+
+/**
+ * @brief		Mark entry invalid
+ * @param[in]	l2br The L2 Bridge table instance
+ * @param[in]	entry The entry
+ */
+static void pfe_l2br_table_entry_set_invalid(const pfe_l2br_table_t *l2br, pfe_l2br_table_entry_t *entry)
+{
+	if (PFE_L2BR_TABLE_MAC2F == l2br->type)
+	{
+		entry->u.mac2f_entry.flags &= ~(uint32_t)MAC2F_ENTRY_VALID_FLAG;
+	}
+	else
+	{
+		entry->u.vlan_entry.flags &= ~(uint32_t)VLAN_ENTRY_VALID_FLAG;
+	}
+}
+
+/**
+ * @brief		Mark entry of the host copy of the table invalid
+ * @param[in]	l2br The L2 Bridge table instance
+ * @param[in]	addr Address within the table
+ * @warning		This function shouldn't be called directly. Call with register lock.
+ */
+static void pfe_l2br_table_shadow_invalidate(pfe_l2br_table_t *l2br, uint32_t addr)
+{
+	pfe_l2br_table_entry_set_invalid(l2br, &l2br->shadow[addr]);
+	pfe_l2br_table_port_index_update(l2br, addr);
+}
+
+/**
+ * @brief		Check whether two entries have the same key (MAC+VLAN or VLAN)
+ * @param[in]	l2br The L2 Bridge table instance
+ * @param[in]	entry1 The first entry
+ * @param[in]	entry2 The second entry
+ * @return		TRUE if keys match, FALSE otherwise
+ */
+static bool_t pfe_l2br_table_entry_same_key(const pfe_l2br_table_t *l2br, const pfe_l2br_table_entry_t *entry1, const pfe_l2br_table_entry_t *entry2)
+{
+	bool_t match;
+
+	if (PFE_L2BR_TABLE_MAC2F == l2br->type)
+	{
+		match = (entry1->u.mac2f_entry.field_valids == entry2->u.mac2f_entry.field_valids)
+					&& (entry1->u.mac2f_entry.vlan == entry2->u.mac2f_entry.vlan)
+					&& (0 == memcmp(entry1->u.mac2f_entry.mac, entry2->u.mac2f_entry.mac, sizeof(pfe_mac_addr_t)));
+	}
+	else
+	{
+		match = (entry1->u.vlan_entry.vlan == entry2->u.vlan_entry.vlan);
+	}
+
+	return match;
+}
+
+/**
+ * @brief		Check whether two entries have the same action data
+ * @details		The 'fresh' flag of MAC table entries is maintained by the aging process
+ *				and is not considered.
+ * @param[in]	l2br The L2 Bridge table instance
+ * @param[in]	entry1 The first entry
+ * @param[in]	entry2 The second entry
+ * @return		TRUE if action data match, FALSE otherwise
+ */
+static bool_t pfe_l2br_table_entry_same_data(const pfe_l2br_table_t *l2br, const pfe_l2br_table_entry_t *entry1, const pfe_l2br_table_entry_t *entry2)
+{
+	uint32_t action_data1, action_data2;
+	pfe_ct_mac_table_result_t *mac_entry1 = (pfe_ct_mac_table_result_t *)&action_data1;
+	pfe_ct_mac_table_result_t *mac_entry2 = (pfe_ct_mac_table_result_t *)&action_data2;
+	bool_t match;
+
+	if (PFE_L2BR_TABLE_MAC2F == l2br->type)
+	{
+		action_data1 = entry1->u.mac2f_entry.action_data;
+		action_data2 = entry2->u.mac2f_entry.action_data;
+		mac_entry1->item.fresh_flag = 0U;
+		mac_entry2->item.fresh_flag = 0U;
+		match = (action_data1 == action_data2);
+	}
+	else
+	{
+		match = (entry1->u.vlan_entry.action_data == entry2->u.vlan_entry.action_data);
+	}
+
+	return match;
+}
+
+/**
+ * @brief		Queue table change event for delivery
+ * @details		Events are delivered by pfe_l2br_table_event_deliver() once the register
+ *				lock is released. The event is lost when the queue is full.
+ * @param[in]	l2br The L2 Bridge table instance
+ * @param[in]	event The event
+ * @param[in]	entry The affected entry
+ * @warning		This function shouldn't be called directly. Call with register lock.
+ */
+static void pfe_l2br_table_event_post(pfe_l2br_table_t *l2br, pfe_l2br_table_event_t event, const pfe_l2br_table_entry_t *entry)
+{
+	pfe_l2br_table_event_item_t *item;
+
+	if (l2br->evt_queue_size == l2br->evt_count)
+	{
+		l2br->evt_dropped++;
+	}
+	else
+	{
+		item = &l2br->evt_queue[(l2br->evt_head + l2br->evt_count) % l2br->evt_queue_size];
+		item->event = event;
+		(void)memcpy(&item->entry, entry, sizeof(pfe_l2br_table_entry_t));
+		l2br->evt_count++;
+	}
+}
+
+/**
+ * @brief		Deliver queued table change events
+ * @details		The callback is called without the register lock being held. Delivery
+ *				is serialized so the events are seen in the order they were generated.
+ * @param[in]	l2br The L2 Bridge table instance
+ */
+static void pfe_l2br_table_event_deliver(pfe_l2br_table_t *l2br)
+{
+	pfe_l2br_table_event_item_t item;
+	pfe_l2br_table_event_cb_item_t cbs[PFE_L2BR_TABLE_EVENT_CB_MAX];
+	bool_t pending = TRUE;
+	uint32_t ii;
+
+	if (0U == l2br->event_cb_cnt)
+	{
+		/*	Nothing is queued without a callback */
+		return;
+	}
+
+	if (EOK != oal_mutex_lock(&l2br->evt_lock))
+	{
+		NXP_LOG_ERROR("Mutex lock failed\n");
+	}
+
+	while (TRUE == pending)
+	{
+		if (EOK != oal_mutex_lock(&l2br->reg_lock))
+		{
+			NXP_LOG_ERROR("Mutex lock failed\n");
+		}
+
+		pending = (0U != l2br->evt_count);
+		if (TRUE == pending)
+		{
+			(void)memcpy(&item, &l2br->evt_queue[l2br->evt_head], sizeof(pfe_l2br_table_event_item_t));
+			l2br->evt_head = (l2br->evt_head + 1U) % l2br->evt_queue_size;
+			l2br->evt_count--;
+		}
+
+		(void)memcpy(cbs, l2br->event_cb, sizeof(cbs));
+
+		if (EOK != oal_mutex_unlock(&l2br->reg_lock))
+		{
+			NXP_LOG_ERROR("Mutex unlock failed\n");
+		}
+
+		if (TRUE == pending)
+		{
+			for (ii = 0U; ii < PFE_L2BR_TABLE_EVENT_CB_MAX; ii++)
+			{
+				if (NULL != cbs[ii].cb)
+				{
+					cbs[ii].cb(cbs[ii].arg, item.event, &item.entry);
+				}
+			}
+		}
+	}
+
+	if (EOK != oal_mutex_unlock(&l2br->evt_lock))
+	{
+		NXP_LOG_ERROR("Mutex unlock failed\n");
+	}
+}
+
+/**
+ * @brief		Register table change callback
+ * @details		The callback is called for every entry added, removed or changed in the
+ *				table, including changes done by the hardware (learning, aging) which
+ *				are discovered by pfe_l2br_table_sync(). Up to PFE_L2BR_TABLE_EVENT_CB_MAX
+ *				callbacks can be registered, each of them sees all the events.
+ *				The callback must not call the L2 bridge table API. Only the MAC table
+ *				supports the events.
+ * @param[in]	l2br The L2 Bridge table instance
+ * @param[in]	cb The callback
+ * @param[in]	arg Argument passed to the callback
+ * @retval		EOK Success
+ * @retval		EINVAL Invalid/missing argument or not a MAC table
+ * @retval		ENOSPC All callback slots are in use
+ */
+errno_t pfe_l2br_table_register_event_cb(pfe_l2br_table_t *l2br, pfe_l2br_table_event_cb_t cb, void *arg)
+{
+	uint32_t ii;
+	errno_t ret = ENOSPC;
+
+#if defined(PFE_CFG_NULL_ARG_CHECK)
+	if (unlikely((NULL == l2br) || (NULL == cb)))
+	{
+		NXP_LOG_ERROR("NULL argument received\n");
+		return EINVAL;
+	}
+#endif /* PFE_CFG_NULL_ARG_CHECK */
+
+	if (NULL == l2br->evt_queue)
+	{
+		NXP_LOG_ERROR("Table does not support events\n");
+		return EINVAL;
+	}
+
+	if (EOK != oal_mutex_lock(&l2br->reg_lock))
+	{
+		NXP_LOG_ERROR("Mutex lock failed\n");
+	}
+
+	for (ii = 0U; ii < PFE_L2BR_TABLE_EVENT_CB_MAX; ii++)
+	{
+		if (NULL == l2br->event_cb[ii].cb)
+		{
+			l2br->event_cb[ii].cb = cb;
+			l2br->event_cb[ii].arg = arg;
+			l2br->event_cb_cnt++;
+			ret = EOK;
+			break;
+		}
+	}
+
+	if (EOK != oal_mutex_unlock(&l2br->reg_lock))
+	{
+		NXP_LOG_ERROR("Mutex unlock failed\n");
+	}
+
+	if (EOK != ret)
+	{
+		NXP_LOG_ERROR("No free event callback slot\n");
+	}
+
+	return ret;
+}
+
+/**
+ * @brief		Unregister table change callback
+ * @details		Waits until the events being delivered are processed so the callback
+ *				is not running once the function returns.
+ * @param[in]	l2br The L2 Bridge table instance
+ * @param[in]	cb The callback passed to pfe_l2br_table_register_event_cb()
+ * @param[in]	arg The argument passed to pfe_l2br_table_register_event_cb()
+ * @retval		EOK Success
+ * @retval		EINVAL Invalid/missing argument or not a MAC table
+ * @retval		ENOENT The callback is not registered
+ */
+errno_t pfe_l2br_table_unregister_event_cb(pfe_l2br_table_t *l2br, pfe_l2br_table_event_cb_t cb, void *arg)
+{
+	uint32_t ii;
+	errno_t ret = ENOENT;
+
+#if defined(PFE_CFG_NULL_ARG_CHECK)
+	if (unlikely((NULL == l2br) || (NULL == cb)))
+	{
+		NXP_LOG_ERROR("NULL argument received\n");
+		return EINVAL;
+	}
+#endif /* PFE_CFG_NULL_ARG_CHECK */
+
+	if (NULL == l2br->evt_queue)
+	{
+		NXP_LOG_ERROR("Table does not support events\n");
+		return EINVAL;
+	}
+
+	/*	Wait until pending events are delivered */
+	if (EOK != oal_mutex_lock(&l2br->evt_lock))
+	{
+		NXP_LOG_ERROR("Mutex lock failed\n");
+	}
+
+	if (EOK != oal_mutex_lock(&l2br->reg_lock))
+	{
+		NXP_LOG_ERROR("Mutex lock failed\n");
+	}
+
+	for (ii = 0U; ii < PFE_L2BR_TABLE_EVENT_CB_MAX; ii++)
+	{
+		if ((cb == l2br->event_cb[ii].cb) && (arg == l2br->event_cb[ii].arg))
+		{
+			l2br->event_cb[ii].cb = NULL;
+			l2br->event_cb[ii].arg = NULL;
+			l2br->event_cb_cnt--;
+			ret = EOK;
+			break;
+		}
+	}
+
+	if (0U == l2br->event_cb_cnt)
+	{
+		/*	Nobody is interested in the events left in the queue */
+		l2br->evt_head = 0U;
+		l2br->evt_count = 0U;
+	}
+
+	if (EOK != oal_mutex_unlock(&l2br->reg_lock))
+	{
+		NXP_LOG_ERROR("Mutex unlock failed\n");
+	}
+
+	if (EOK != oal_mutex_unlock(&l2br->evt_lock))
+	{
+		NXP_LOG_ERROR("Mutex unlock failed\n");
+	}
+
+	return ret;
+}
+
+/**
+ * @brief			Search entry in the host copy of the table
+ * @param[in]		l2br The L2 Bridge table instance
+ * @param[in,out]	entry Reference entry to be used for lookup. Action data are updated
+ *						  by values from the table if found.
+ * @retval			TRUE Entry found
+ * @retval			FALSE Entry not found
+ * @warning			This function shouldn't be called directly. Call with register lock.
+ */
+static bool_t pfe_l2br_table_shadow_find(const pfe_l2br_table_t *l2br, pfe_l2br_table_entry_t *entry)
+{
+	const pfe_l2br_table_entry_t *item;
+	uint32_t addr = pfe_l2br_entry_get_hash(entry);
+	uint32_t ii;
+	bool_t match = FALSE;
+
+	for (ii = 0U; ii <= l2br->coll_space_depth; ii++)
+	{
+		item = &l2br->shadow[addr];
+		if (PFE_L2BR_TABLE_MAC2F == l2br->type)
+		{
+			match = (0U != (item->u.mac2f_entry.flags & (uint32_t)MAC2F_ENTRY_VALID_FLAG))
+						&& (item->u.mac2f_entry.field_valids == entry->u.mac2f_entry.field_valids)
+						&& (0 == memcmp(item->u.mac2f_entry.mac, entry->u.mac2f_entry.mac, sizeof(pfe_mac_addr_t)))
+						&& (item->u.mac2f_entry.vlan == entry->u.mac2f_entry.vlan);
+			if (TRUE == match)
+			{
+				entry->u.mac2f_entry.action_data = item->u.mac2f_entry.action_data;
+			}
+		}
+		else
+		{
+			match = (0U != (item->u.vlan_entry.flags & (uint32_t)VLAN_ENTRY_VALID_FLAG))
+						&& (item->u.vlan_entry.vlan == entry->u.vlan_entry.vlan);
+			if (TRUE == match)
+			{
+				entry->u.vlan_entry.action_data = item->u.vlan_entry.action_data;
+			}
+		}
+
+		if (TRUE == match)
+		{
+			break;
+		}
+
+		addr = pfe_l2br_table_get_col_ptr(item);
+		if ((addr < l2br->hash_space_depth) || (addr >= ((uint32_t)l2br->hash_space_depth + l2br->coll_space_depth)))
+		{
+			/*	End of the chain */
+			break;
+		}
+	}
+
+	return match;
+}
+
+/**
+ * @brief		Reset the per-port index
+ * @details		To be called when the host copy of the table has been reset.
+ * @param[in]	l2br The L2 Bridge table instance
+ */
+static void pfe_l2br_table_port_index_init(pfe_l2br_table_t *l2br)
+{
+	uint32_t ii;
+
+	if (NULL != l2br->port_nodes)
+	{
+		for (ii = 0U; ii < PFE_L2BR_TABLE_PORT_INDEX_SIZE; ii++)
+		{
+			LLIST_Init(&l2br->port_index[ii]);
+		}
+
+		for (ii = 0U; ii < ((uint32_t)l2br->hash_space_depth + l2br->coll_space_depth); ii++)
+		{
+			l2br->port_nodes[ii].list_entry.prNext = NULL;
+			l2br->port_nodes[ii].list_entry.prPrev = NULL;
+			l2br->port_nodes[ii].addr = ii;
+		}
+	}
+}
+
+/**
+ * @brief		Re-index entry of the host copy of the table
+ * @details		To be called whenever the host copy of given address has changed.
+ * @param[in]	l2br The L2 Bridge table instance
+ * @param[in]	addr Address within the table
+ * @warning		This function shouldn't be called directly. Call with register lock.
+ */
+static void pfe_l2br_table_port_index_update(pfe_l2br_table_t *l2br, uint32_t addr)
+{
+	pfe_l2br_table_port_node_t *node;
+	const pfe_l2br_table_entry_t *item;
+	uint32_t action_data;
+	const pfe_ct_mac_table_result_t *mac_entry = (pfe_ct_mac_table_result_t *)&action_data;
+	uint32_t fwd_list, port;
+
+	if (NULL == l2br->port_nodes)
+	{
+		/*	Not indexed */
+		return;
+	}
+
+	node = &l2br->port_nodes[addr];
+	item = &l2br->shadow[addr];
+
+	if (NULL != node->list_entry.prNext)
+	{
+		LLIST_Remove(&node->list_entry);
+	}
+
+	if (0U != (item->u.mac2f_entry.flags & (uint32_t)MAC2F_ENTRY_VALID_FLAG))
+	{
+		action_data = item->u.mac2f_entry.action_data;
+		fwd_list = mac_entry->item.forward_list;
+
+		port = PFE_L2BR_TABLE_PORT_INDEX_MULTI;
+		if ((0U != fwd_list) && (0U == (fwd_list & (fwd_list - 1U))))
+		{
+			/*	Single port, get its ID */
+			for (port = 0U; 0U == (fwd_list & ((uint32_t)1U << port)); port++)
+			{
+				;
+			}
+
+			if (port > (uint32_t)PFE_PHY_IF_ID_MAX)
+			{
+				port = PFE_L2BR_TABLE_PORT_INDEX_MULTI;
+			}
+		}
+
+		LLIST_AddAtEnd(&node->list_entry, &l2br->port_index[port]);
+	}
+}
+
+/**
+ * @brief		Check whether entry is subject of the hardware learning and aging
+ * @param[in]	l2br The L2 Bridge table instance
+ * @param[in]	entry The entry
+ * @return		TRUE if the entry is a non-static MAC table entry, FALSE otherwise
+ */
+static bool_t pfe_l2br_table_entry_is_aging(const pfe_l2br_table_t *l2br, const pfe_l2br_table_entry_t *entry)
+{
+	uint32_t action_data;
+	const pfe_ct_mac_table_result_t *mac_entry = (pfe_ct_mac_table_result_t *)&action_data;
+	bool_t aging = FALSE;
+
+	if (PFE_L2BR_TABLE_MAC2F == l2br->type)
+	{
+		action_data = entry->u.mac2f_entry.action_data;
+		aging = (0U == mac_entry->item.static_flag);
+	}
+
+	return aging;
+}
+
+/**
+ * @brief		Delete all MAC table entries of given VLAN forwarding to given port
+ * @details		Only entries indexed under the port (and entries with multiple ports
+ *				in the forward list) are visited instead of looking up every table entry.
+ *				The index follows the hardware learning and aging through the periodic
+ *				pfe_l2br_table_sync(). Only buckets of the indexed entries are re-read
+ *				before the flush, entries learned for the port since the last
+ *				reconciliation are picked up by the next one.
+ * @param[in]	l2br The L2 Bridge table instance (MAC table)
+ * @param[in]	port The port (physical interface ID)
+ * @param[in]	vlan The VLAN
+ * @retval		EOK Success
+ * @retval		EINVAL Invalid argument
+ * @retval		ENOMEM Out of memory
+ * @return		Otherwise result of the first failed delete command
+ */
+errno_t pfe_l2br_table_flush_by_port(pfe_l2br_table_t *l2br, pfe_ct_phy_if_id_t port, uint16_t vlan)
+{
+	pfe_l2br_table_entry_t *victims = NULL;
+	const pfe_l2br_table_port_node_t *node;
+	const pfe_l2br_table_entry_t *item;
+	LLIST_t *lists[2];
+	LLIST_t *cur;
+	uint32_t action_data;
+	const pfe_ct_mac_table_result_t *mac_entry = (pfe_ct_mac_table_result_t *)&action_data;
+	uint32_t touched[(PFE_L2BR_TABLE_HASH_SPACE_MAX + 31U) / 32U] = {0U};
+	uint32_t count = 0U, ii, hash;
+	errno_t ret = EOK, del_ret;
+
+#if defined(PFE_CFG_NULL_ARG_CHECK)
+	if (unlikely(NULL == l2br))
+	{
+		NXP_LOG_ERROR("NULL argument received\n");
+		return EINVAL;
+	}
+#endif /* PFE_CFG_NULL_ARG_CHECK */
+
+	if ((NULL == l2br->port_nodes) || ((uint32_t)port > (uint32_t)PFE_PHY_IF_ID_MAX))
+	{
+		return EINVAL;
+	}
+
+	if (EOK != oal_mutex_lock(&l2br->reg_lock))
+	{
+		NXP_LOG_ERROR("Mutex lock failed\n");
+	}
+
+	lists[0] = &l2br->port_index[port];
+	lists[1] = &l2br->port_index[PFE_L2BR_TABLE_PORT_INDEX_MULTI];
+
+	/*	Entries might have been moved or aged by the hardware since the last
+		reconciliation. Re-read buckets of the indexed entries. */
+	for (ii = 0U; ii < 2U; ii++)
+	{
+		LLIST_ForEach(cur, lists[ii])
+		{
+			node = LLIST_Data(cur, pfe_l2br_table_port_node_t, list_entry);
+			hash = pfe_l2br_entry_get_hash(&l2br->shadow[node->addr]);
+			touched[hash / 32U] |= (1UL << (hash % 32U));
+		}
+	}
+
+	for (hash = 0U; hash < PFE_L2BR_TABLE_HASH_SPACE_MAX; hash++)
+	{
+		if (0U != (touched[hash / 32U] & (1UL << (hash % 32U))))
+		{
+			if (EOK != pfe_l2br_table_shadow_fetch_bucket(l2br, hash))
+			{
+				NXP_LOG_WARNING("Could not reconcile MAC table bucket %u\n", (uint_t)hash);
+			}
+		}
+	}
+
+	(void)memset(touched, 0, sizeof(touched));
+
+	for (ii = 0U; ii < 2U; ii++)
+	{
+		LLIST_ForEach(cur, lists[ii])
+		{
+			count++;
+		}
+	}
+
+	if (0U != count)
+	{
+		/*	Deleting modifies the index, take copies of the entries first */
+		victims = oal_mm_malloc(count * sizeof(pfe_l2br_table_entry_t));
+		if (NULL == victims)
+		{
+			NXP_LOG_ERROR("Unable to allocate memory\n");
+			ret = ENOMEM;
+		}
+		else
+		{
+			count = 0U;
+			for (ii = 0U; ii < 2U; ii++)
+			{
+				LLIST_ForEach(cur, lists[ii])
+				{
+					node = LLIST_Data(cur, pfe_l2br_table_port_node_t, list_entry);
+					item = &l2br->shadow[node->addr];
+					action_data = item->u.mac2f_entry.action_data;
+					if ((vlan == item->u.mac2f_entry.vlan)
+							&& (0U != (mac_entry->item.forward_list & ((uint32_t)1U << (uint32_t)port))))
+					{
+						(void)memcpy(&victims[count], item, sizeof(pfe_l2br_table_entry_t));
+						count++;
+					}
+				}
+			}
+
+			for (ii = 0U; ii < count; ii++)
+			{
+				del_ret = pfe_l2br_table_do_del_entry_nolock(l2br, &victims[ii]);
+				if (EINVAL != del_ret)
+				{
+					/*	Remember the bucket to be refreshed */
+					hash = pfe_l2br_entry_get_hash(&victims[ii]);
+					touched[hash / 32U] |= (1UL << (hash % 32U));
+				}
+
+				if (EOK != del_ret)
+				{
+					NXP_LOG_ERROR("Could not delete MAC table entry: %d\n", del_ret);
+					if (EOK == ret)
+					{
+						ret = del_ret;
+					}
+				}
+			}
+
+			oal_mm_free(victims);
+
+			/*	Keep the host copy of the table up to date */
+			for (hash = 0U; hash < PFE_L2BR_TABLE_HASH_SPACE_MAX; hash++)
+			{
+				if (0U != (touched[hash / 32U] & (1UL << (hash % 32U))))
+				{
+					(void)pfe_l2br_table_shadow_fetch_bucket(l2br, hash);
+				}
+			}
+		}
+	}
+
+	if (EOK != oal_mutex_unlock(&l2br->reg_lock))
+	{
+		NXP_LOG_ERROR("Mutex unlock failed\n");
+	}
+
+	pfe_l2br_table_event_deliver(l2br);
+
+	return ret;
+}
+
+/**
+ * @brief			Get first entry from table
+ * @details			Entries are served from the host copy of the table. Entries learned
+ *					or aged by the hardware appear there after reconciliation, see
+ *					pfe_l2br_table_sync().
+ * @param[in]		l2br The L2 Bridge Table instance
+ * @param[in]		crit Get criterion
+ * @param[out]		entry Entry will be written at this location
+ * @retval			EOK Success
+ * @retval			EINVAL Invalid/missing argument
+ * @retval			ENOENT Entry not found
+ * @retval			ETIMEDOUT Command timed-out
+ */
+errno_t pfe_l2br_table_get_first(pfe_l2br_table_t *l2br, pfe_l2br_table_iterator_t *l2t_iter, pfe_l2br_table_get_criterion_t crit, pfe_l2br_table_entry_t *entry)
+{
+	errno_t ret = ENOENT;
+
+#if defined(PFE_CFG_NULL_ARG_CHECK)
+	if (unlikely((NULL == l2br) || (NULL == entry)))
+	{
+		NXP_LOG_ERROR("NULL argument received\n");
+		return EINVAL;
+	}
+#endif /* PFE_CFG_NULL_ARG_CHECK */
+
+	/*	Pick up part of the changes done by the hardware */
+	if (EOK != pfe_l2br_table_sync(l2br, PFE_L2BR_TABLE_CFG_SYNC_BUDGET))
+	{
+		NXP_LOG_WARNING("Table reconciliation failed\n");
+	}
+
+	/*	Remember criterion and argument for possible subsequent pfe_l2br_table_get_next() calls */
+	l2t_iter->cur_crit = crit;
+
+	/*	Get entries from address 0x0 */
+	memset(&l2t_iter->cur_macvlan, 0U, sizeof(l2t_iter->cur_macvlan)); 
+	for (l2t_iter->cur_hash_addr=0U, l2t_iter->cur_coll_addr=0U; l2t_iter->cur_hash_addr<l2br->hash_space_depth; l2t_iter->cur_hash_addr++)
+	{
+		ret = pfe_l2br_table_shadow_read(l2br, l2t_iter->cur_hash_addr, entry);
+		if (EOK != ret)
+		{
+			NXP_LOG_ERROR("Can not read table entry from location %d\n", (int_t)l2t_iter->cur_hash_addr);
+			break;
+		}
+		else
+		{
+			l2t_iter->cur_coll_addr = l2t_iter->cur_hash_addr; /* cur_coll_addr is utilized to store address of previous valid MAC entry from HW, regardless of hash/coll space */
+			pfe_l2br_iterator_save_macvlan(l2t_iter, entry);
+			if (TRUE == pfe_l2br_table_entry_match_criterion(l2br, l2t_iter, entry))
+			{
+				/*	Remember entry to be processed next */
+				l2t_iter->next_coll_addr = pfe_l2br_table_get_col_ptr(entry);
+				l2t_iter->cur_hash_addr++;
+				return EOK;
+			}
+		}
+	}
+
+	return ENOENT;
+}
+
+/**
+ * @brief			Get next entry from table
+ * @param[in]		l2br The L2 Bridge Table instance
+ * @param[in]		addr Address within the table to read entry from
+ * @param[out]		entry Entry will be written at this location
+ * @retval			EOK Success
+ * @retval			EINVAL Invalid/missing argument
+ * @retval			ENOENT Entry not found
+ * @retval			ETIMEDOUT Command timed-out
+ */
+errno_t pfe_l2br_table_get_next(pfe_l2br_table_t *l2br, pfe_l2br_table_iterator_t *l2t_iter, pfe_l2br_table_entry_t *entry)
+{
+	errno_t ret;
+
+#if defined(PFE_CFG_NULL_ARG_CHECK)
+	if (unlikely((NULL == l2br) || (NULL == entry)))
+	{
+		NXP_LOG_ERROR("NULL argument received\n");
+		return EINVAL;
+	}
+#endif /* PFE_CFG_NULL_ARG_CHECK */
+
+	/*	Get entries from last address */
+	while ((l2t_iter->cur_hash_addr < l2br->hash_space_depth) || (0U != l2t_iter->next_coll_addr) )
+	{
+		if (0U == l2t_iter->next_coll_addr)
+		{
+			/*	Read from hash space */
+			ret = pfe_l2br_table_shadow_read(l2br, l2t_iter->cur_hash_addr, entry);
+			if (EOK == ret)
+			{
+				/*	candidate MAC entry found */
+				l2t_iter->cur_coll_addr = l2t_iter->cur_hash_addr; /* cur_coll_addr is utilized to store address of previous valid MAC entry from HW, regardless of hash/coll space */
+				l2t_iter->cur_hash_addr++;
+				pfe_l2br_iterator_save_macvlan(l2t_iter, entry);
+			}
+		}
+		else
+		{
+			/*	Read from collision space */
+			ret = pfe_l2br_table_shadow_read(l2br, l2t_iter->next_coll_addr, entry);
+			if (EOK == ret)
+			{
+				/*	check hash ; by design of the lookup routine, iterator's actual cur_hash_addr is already +1 ahead */
+				if ((l2t_iter->cur_hash_addr - 1U) == pfe_l2br_entry_get_hash(entry))
+				{
+					/*	=== hash OK === ; candidate MAC entry found */
+					l2t_iter->cur_coll_addr = l2t_iter->next_coll_addr; /* cur_coll_addr is utilized to store address of previous valid MAC entry from HW, regardless of hash/coll space */
+					pfe_l2br_iterator_save_macvlan(l2t_iter, entry);
+				}
+				else
 				{
 					/*	=== hash NOT OK === ; try to re-read previous valid MAC entry */
-					ret = pfe_l2br_table_read_cmd(l2br, l2t_iter->cur_coll_addr, entry);
+					ret = pfe_l2br_table_shadow_read(l2br, l2t_iter->cur_coll_addr, entry);
 					if (EOK == ret)
 					{
 						/*	check hash ; by design of the lookup routine, iterator's actual cur_hash_addr is already +1 ahead */
@@ -1077,9 +2283,11 @@ errno_t pfe_l2br_table_get_next(pfe_l2br_table_t *l2br, pfe_l2br_table_iterator_
  * @retval		EOK Success
  * @retval		ETIMEDOUT Timed out
  */
-static errno_t pfe_l2br_wait_for_cmd_done(const pfe_l2br_table_t *l2br, uint32_t *status_val)
+static errno_t pfe_l2br_wait_for_cmd_done(pfe_l2br_table_t *l2br, uint32_t *status_val)
 {
-	uint32_t ii = 100U;
+	pfe_l2br_table_cmd_stats_t *stats;
+	uint32_t polls = 0U, sleeps = 0U;
+	bool_t done;
 
 #if defined(PFE_CFG_NULL_ARG_CHECK)
 	if (unlikely(NULL == l2br))
@@ -1089,16 +2297,22 @@ static errno_t pfe_l2br_wait_for_cmd_done(const pfe_l2br_table_t *l2br, uint32_t
 	}
 #endif /* PFE_CFG_NULL_ARG_CHECK */
 
-	/*	Wait for command completion */
-	while (0U == (hal_read32(l2br->regs.status_reg) & STATUS_REG_CMD_DONE))
+	stats = &l2br->cmd_stats;
+
+	/*	Wait for command completion. Spin first, the command usually completes
+		within few register reads. */
+	do
 	{
-		ii--;
-		oal_time_usleep(10);
+		polls++;
+		done = (0U != (hal_read32(l2br->regs.status_reg) & STATUS_REG_CMD_DONE));
+	} while ((FALSE == done) && (polls < stats->spin_limit));
 
-		if (0U == ii)
-		{
-			break;
-		}
+	/*	Then give up the CPU */
+	while ((FALSE == done) && (sleeps < PFE_L2BR_TABLE_CFG_SLEEP_POLLS))
+	{
+		oal_time_usleep(10);
+		sleeps++;
+		done = (0U != (hal_read32(l2br->regs.status_reg) & STATUS_REG_CMD_DONE));
 	}
 
 	if (NULL != status_val)
@@ -1109,14 +2323,44 @@ static errno_t pfe_l2br_wait_for_cmd_done(const pfe_l2br_table_t *l2br, uint32_t
 	/*	Clear the STATUS register */
 	hal_write32(0xffffffffU, l2br->regs.status_reg);
 
-	if (0U == ii)
+	/*	Update statistics and adapt the spin limit */
+	if (FALSE == done)
 	{
+		stats->timeouts++;
 		return ETIMEDOUT;
 	}
+	else if (0U == sleeps)
+	{
+		stats->spin_hist[pfe_l2br_table_cmd_hist_bucket(polls)]++;
+		if (((polls * 4U) < stats->spin_limit) && (stats->spin_limit > PFE_L2BR_TABLE_CFG_SPIN_MIN))
+		{
+			stats->spin_limit--;
+		}
+	}
 	else
 	{
-		return EOK;
+		stats->sleep_hist[pfe_l2br_table_cmd_hist_bucket(sleeps)]++;
+		stats->spin_limit = ((stats->spin_limit * 2U) < PFE_L2BR_TABLE_CFG_SPIN_MAX) ? (stats->spin_limit * 2U) : PFE_L2BR_TABLE_CFG_SPIN_MAX;
+	}
+
+	return EOK;
+}
+
+/**
+ * @brief		Get index of the latency histogram bucket
+ * @param[in]	polls Number of polls the command needed to complete
+ * @return		Index of the bucket
+ */
+static uint32_t pfe_l2br_table_cmd_hist_bucket(uint32_t polls)
+{
+	uint32_t ii = 0U;
+
+	while (((1UL << ii) < polls) && (ii < (PFE_L2BR_TABLE_CMD_HIST_SIZE - 1U)))
+	{
+		ii++;
 	}
+
+	return ii;
 }
 
 /**
@@ -1288,6 +2532,18 @@ static errno_t pfe_l2br_table_init_cmd(pfe_l2br_table_t *l2br)
 		return ENOEXEC;
 	}
 
+	/*	The table is empty now */
+	(void)memset(l2br->shadow, 0, ((uint32_t)l2br->hash_space_depth + l2br->coll_space_depth) * sizeof(pfe_l2br_table_entry_t));
+	for (ii=0U; ii<((uint32_t)l2br->hash_space_depth + l2br->coll_space_depth); ii++)
+	{
+		l2br->shadow[ii].type = l2br->type;
+		l2br->shadow[ii].mac_addr_set = (PFE_L2BR_TABLE_MAC2F == l2br->type);
+		l2br->shadow[ii].vlan_set = TRUE;
+		l2br->shadow[ii].action_data_set = TRUE;
+	}
+
+	pfe_l2br_table_port_index_init(l2br);
+
 	hal_write32(0U, l2br->regs.mac1_addr_reg);
 	hal_write32(0U, l2br->regs.mac2_addr_reg);
 	hal_write32(0U, l2br->regs.mac3_addr_reg);
@@ -1318,6 +2574,8 @@ static errno_t pfe_l2br_table_init_cmd(pfe_l2br_table_t *l2br)
 			NXP_LOG_ERROR("Init failed: %d\n", ret);
 			return ret;
 		}
+
+		(void)memcpy(&l2br->shadow[l2br->hash_space_depth + ii].u, &entry.u, sizeof(entry.u));
 	}
 
 	hal_write32(l2br->hash_space_depth, l2br->regs.free_head_ptr_reg);
@@ -1397,11 +2655,21 @@ pfe_l2br_table_t *pfe_l2br_table_create(addr_t cbus_base_va, pfe_l2br_table_type
 		(void)memset(l2br, 0, sizeof(pfe_l2br_table_t));
 		l2br->cbus_base_va = cbus_base_va;
 		l2br->type = type;
+		l2br->cmd_stats.spin_limit = PFE_L2BR_TABLE_CFG_SPIN_MIN;
+	}
+
+	if (EOK != oal_mutex_init(&l2br->reg_lock))
+	{
+			NXP_LOG_ERROR("Mutex initialization failed.\n");
+			oal_mm_free(l2br);
+			l2br = NULL;
+			return l2br;
 	}
 
-	if (EOK != oal_mutex_init(&l2br->reg_lock))
+	if (EOK != oal_mutex_init(&l2br->evt_lock))
 	{
 			NXP_LOG_ERROR("Mutex initialization failed.\n");
+			(void)oal_mutex_destroy(&l2br->reg_lock);
 			oal_mm_free(l2br);
 			l2br = NULL;
 			return l2br;
@@ -1450,12 +2718,65 @@ pfe_l2br_table_t *pfe_l2br_table_create(addr_t cbus_base_va, pfe_l2br_table_type
 		default:
 		{
 			NXP_LOG_ERROR("Invalid table type\n");
-			oal_mm_free(l2br);
+			pfe_l2br_table_destroy(l2br);
 			l2br = NULL;
             break;
 		}
 	}
 
+    if (NULL != l2br)
+    {
+        /*	Create the host copy of the table */
+        l2br->shadow = oal_mm_malloc(((uint32_t)l2br->hash_space_depth + l2br->coll_space_depth) * sizeof(pfe_l2br_table_entry_t));
+        if (NULL == l2br->shadow)
+        {
+            NXP_LOG_ERROR("Unable to allocate memory\n");
+            pfe_l2br_table_destroy(l2br);
+            l2br = NULL;
+        }
+    }
+
+    if ((NULL != l2br) && (PFE_L2BR_TABLE_MAC2F == type))
+    {
+        /*	Create the per-port index */
+        l2br->port_nodes = oal_mm_malloc(((uint32_t)l2br->hash_space_depth + l2br->coll_space_depth) * sizeof(pfe_l2br_table_port_node_t));
+        if (NULL == l2br->port_nodes)
+        {
+            NXP_LOG_ERROR("Unable to allocate memory\n");
+            pfe_l2br_table_destroy(l2br);
+            l2br = NULL;
+        }
+    }
+
+    if (NULL != l2br)
+    {
+        /*	Create the bucket refresh buffers */
+        l2br->chain = oal_mm_malloc(((uint32_t)l2br->coll_space_depth + 1U) * sizeof(pfe_l2br_table_entry_t));
+        l2br->chain_addr = oal_mm_malloc(2U * ((uint32_t)l2br->coll_space_depth + 1U) * sizeof(uint32_t));
+        l2br->displaced = oal_mm_malloc((uint32_t)l2br->coll_space_depth * sizeof(pfe_l2br_table_entry_t));
+        if ((NULL == l2br->chain) || (NULL == l2br->chain_addr) || (NULL == l2br->displaced))
+        {
+            NXP_LOG_ERROR("Unable to allocate memory\n");
+            pfe_l2br_table_destroy(l2br);
+            l2br = NULL;
+        }
+    }
+
+    if ((NULL != l2br) && (PFE_L2BR_TABLE_MAC2F == type))
+    {
+        /*	Create the event queue. Only the MAC table reports changes. Every entry
+            can be removed and another one added at its address within a single
+            reconciliation pass so the queue holds two events per table entry. */
+        l2br->evt_queue_size = 2U * ((uint32_t)l2br->hash_space_depth + l2br->coll_space_depth);
+        l2br->evt_queue = oal_mm_malloc(l2br->evt_queue_size * sizeof(pfe_l2br_table_event_item_t));
+        if (NULL == l2br->evt_queue)
+        {
+            NXP_LOG_ERROR("Unable to allocate memory\n");
+            pfe_l2br_table_destroy(l2br);
+            l2br = NULL;
+        }
+    }
+
     if (NULL != l2br)
     {
         /*	Initialize the table */
@@ -1463,10 +2784,44 @@ pfe_l2br_table_t *pfe_l2br_table_create(addr_t cbus_base_va, pfe_l2br_table_type
         if (EOK != ret)
         {
             NXP_LOG_ERROR("Table initialization failed: %d\n", ret);
-            oal_mm_free(l2br);
+            pfe_l2br_table_destroy(l2br);
+            l2br = NULL;
+        }
+    }
+
+#if !defined(PFE_CFG_TARGET_OS_AUTOSAR)
+    if ((NULL != l2br) && (PFE_L2BR_TABLE_MAC2F == type))
+    {
+        /*	Entries learned and aged by the hardware are reconciled in background */
+        l2br->mbox = oal_mbox_create();
+        if (NULL == l2br->mbox)
+        {
+            NXP_LOG_ERROR("Mbox creation failed\n");
+            pfe_l2br_table_destroy(l2br);
             l2br = NULL;
         }
+        else
+        {
+            l2br->worker = oal_thread_create(&pfe_l2br_table_worker_func, l2br, "l2br table worker", 0);
+            if (NULL == l2br->worker)
+            {
+                NXP_LOG_ERROR("Couldn't start worker thread\n");
+                pfe_l2br_table_destroy(l2br);
+                l2br = NULL;
+            }
+            else if (EOK != oal_mbox_attach_timer(l2br->mbox, PFE_L2BR_TABLE_CFG_SYNC_PERIOD_MS, SIG_TIMER_TICK))
+            {
+                NXP_LOG_ERROR("Unable to attach timer\n");
+                pfe_l2br_table_destroy(l2br);
+                l2br = NULL;
+            }
+            else
+            {
+                ; /*	Worker is running */
+            }
+        }
     }
+#endif /* !defined(PFE_CFG_TARGET_OS_AUTOSAR) */
 
 	return l2br;
 }
@@ -1479,6 +2834,8 @@ pfe_l2br_table_t *pfe_l2br_table_create(addr_t cbus_base_va, pfe_l2br_table_type
  */
 errno_t pfe_l2br_table_init(pfe_l2br_table_t *l2br)
 {
+	errno_t ret;
+
 #if defined(PFE_CFG_NULL_ARG_CHECK)
 	if (unlikely(NULL == l2br))
 	{
@@ -1487,7 +2844,19 @@ errno_t pfe_l2br_table_init(pfe_l2br_table_t *l2br)
 	}
 #endif /* PFE_CFG_NULL_ARG_CHECK */
 
-	return pfe_l2br_table_init_cmd(l2br);
+	if (EOK != oal_mutex_lock(&l2br->reg_lock))
+	{
+		NXP_LOG_ERROR("Mutex lock failed\n");
+	}
+
+	ret = pfe_l2br_table_init_cmd(l2br);
+
+	if (EOK != oal_mutex_unlock(&l2br->reg_lock))
+	{
+		NXP_LOG_ERROR("Mutex unlock failed\n");
+	}
+
+	return ret;
 }
 
 /**
@@ -1498,6 +2867,60 @@ errno_t pfe_l2br_table_init(pfe_l2br_table_t *l2br)
  */
 errno_t pfe_l2br_table_flush(pfe_l2br_table_t *l2br)
 {
+	errno_t ret;
+
+#if defined(PFE_CFG_NULL_ARG_CHECK)
+	if (unlikely(NULL == l2br))
+	{
+		NXP_LOG_ERROR("NULL argument received\n");
+		return EINVAL;
+	}
+#endif /* PFE_CFG_NULL_ARG_CHECK */
+
+	if (EOK != oal_mutex_lock(&l2br->reg_lock))
+	{
+		NXP_LOG_ERROR("Mutex lock failed\n");
+	}
+
+	ret = pfe_l2br_table_flush_cmd(l2br);
+
+	if (EOK != oal_mutex_unlock(&l2br->reg_lock))
+	{
+		NXP_LOG_ERROR("Mutex unlock failed\n");
+	}
+
+	if (EOK == ret)
+	{
+		/*	Re-read the whole table */
+		ret = pfe_l2br_table_sync(l2br, 0U);
+	}
+
+	return ret;
+}
+
+/**
+ * @brief		Reconcile the host copy of the table with the hardware
+ * @details		Entries learned and aged by the hardware are not visible to the driver
+ *				otherwise. The call refreshes given number of buckets starting where
+ *				the previous call has finished so that repeated calls with small budget
+ *				scan the table incrementally. Discovered changes are reported via
+ *				the callbacks registered by pfe_l2br_table_register_event_cb(). The register lock
+ *				is held for the whole call so a full refresh gives a consistent
+ *				snapshot of the table.
+ *				The MAC table is reconciled by its worker thread every
+ *				PFE_L2BR_TABLE_CFG_SYNC_PERIOD_MS. Where no worker thread is available
+ *				(AUTOSAR) the function shall be called periodically by the integration.
+ * @param[in]	l2br The L2 bridge table instance
+ * @param[in]	budget Number of buckets to be refreshed, 0 to refresh the whole table
+ * @retval		EOK Success
+ * @retval		EINVAL Invalid/missing argument
+ * @retval		ETIMEDOUT Command timed-out
+ */
+errno_t pfe_l2br_table_sync(pfe_l2br_table_t *l2br, uint32_t budget)
+{
+	uint32_t ii;
+	errno_t ret = EOK;
+
 #if defined(PFE_CFG_NULL_ARG_CHECK)
 	if (unlikely(NULL == l2br))
 	{
@@ -1506,7 +2929,152 @@ errno_t pfe_l2br_table_flush(pfe_l2br_table_t *l2br)
 	}
 #endif /* PFE_CFG_NULL_ARG_CHECK */
 
-	return pfe_l2br_table_flush_cmd(l2br);
+	if ((0U == budget) || (budget > l2br->hash_space_depth))
+	{
+		budget = l2br->hash_space_depth;
+	}
+
+	if (EOK != oal_mutex_lock(&l2br->reg_lock))
+	{
+		NXP_LOG_ERROR("Mutex lock failed\n");
+	}
+
+	for (ii = 0U; ii < budget; ii++)
+	{
+		ret = pfe_l2br_table_shadow_fetch_bucket(l2br, l2br->sync_addr);
+		if (EOK != ret)
+		{
+			break;
+		}
+
+		l2br->sync_addr = (l2br->sync_addr + 1U) % l2br->hash_space_depth;
+	}
+
+	if (EOK != oal_mutex_unlock(&l2br->reg_lock))
+	{
+		NXP_LOG_ERROR("Mutex unlock failed\n");
+	}
+
+	pfe_l2br_table_event_deliver(l2br);
+
+	return ret;
+}
+
+#if !defined(PFE_CFG_TARGET_OS_AUTOSAR)
+/**
+ * @brief		Worker function running within internal thread
+ * @details		Reconciles a part of the MAC table on every timer tick.
+ */
+static void *pfe_l2br_table_worker_func(void *arg)
+{
+	pfe_l2br_table_t *l2br = (pfe_l2br_table_t *)arg;
+	errno_t err;
+	oal_mbox_msg_t msg;
+
+#if defined(PFE_CFG_NULL_ARG_CHECK)
+	if (unlikely(NULL == l2br))
+	{
+		NXP_LOG_ERROR("NULL argument received\n");
+		return NULL;
+	}
+#endif /* PFE_CFG_NULL_ARG_CHECK */
+
+	while (2)
+	{
+		err = oal_mbox_receive(l2br->mbox, &msg);
+		if (EOK != err)
+		{
+			NXP_LOG_ERROR("mbox: Problem receiving message: %d", err);
+		}
+		else
+		{
+			switch (msg.payload.code)
+			{
+				case (int32_t)SIG_WORKER_STOP:
+				{
+					/* Exit the thread */
+					oal_mbox_ack_msg(&msg);
+					return NULL;
+				}
+
+				case (int32_t)SIG_TIMER_TICK:
+				{
+					err = pfe_l2br_table_sync(l2br, PFE_L2BR_TABLE_CFG_SYNC_BUDGET);
+					if (EOK != err)
+					{
+						NXP_LOG_WARNING("MAC table reconciliation failed: %d\n", err);
+					}
+
+					break;
+				}
+
+				default:
+				{
+					/*Do Nothing*/
+					break;
+				}
+			}
+		}
+
+		oal_mbox_ack_msg(&msg);
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief		Stop the worker thread and release its resources
+ * @param[in]	l2br The L2 bridge table instance
+ */
+static void pfe_l2br_table_worker_stop(pfe_l2br_table_t *l2br)
+{
+	errno_t err;
+
+	if (NULL != l2br->mbox)
+	{
+		oal_mbox_detach_timer(l2br->mbox);
+
+		if (NULL != l2br->worker)
+		{
+			err = oal_mbox_send_signal(l2br->mbox, SIG_WORKER_STOP);
+			if (EOK != err)
+			{
+				NXP_LOG_ERROR("Signal failed: %d\n", err);
+			}
+			else
+			{
+				err = oal_thread_join(l2br->worker, NULL);
+				if (EOK != err)
+				{
+					NXP_LOG_ERROR("Can't join the worker thread: %d\n", err);
+				}
+			}
+
+			l2br->worker = NULL;
+		}
+
+		oal_mbox_destroy(l2br->mbox);
+		l2br->mbox = NULL;
+	}
+}
+#endif /* !defined(PFE_CFG_TARGET_OS_AUTOSAR) */
+
+/**
+ * @brief		Get table capacity
+ * @param[in]	l2br The L2 bridge table instance
+ * @return		Number of entries of hash and collision space together
+ */
+uint32_t pfe_l2br_table_get_size(const pfe_l2br_table_t *l2br)
+{
+#if defined(PFE_CFG_NULL_ARG_CHECK)
+	if (unlikely(NULL == l2br))
+	{
+		NXP_LOG_ERROR("NULL argument received\n");
+		return 0U;
+	}
+#endif /* PFE_CFG_NULL_ARG_CHECK */
+
+	return (uint32_t)l2br->hash_space_depth + (uint32_t)l2br->coll_space_depth;
 }
 
 /**
@@ -1517,10 +3085,56 @@ void pfe_l2br_table_destroy(pfe_l2br_table_t *l2br)
 {
 	if (NULL != l2br)
 	{
+#if !defined(PFE_CFG_TARGET_OS_AUTOSAR)
+		pfe_l2br_table_worker_stop(l2br);
+#endif /* !defined(PFE_CFG_TARGET_OS_AUTOSAR) */
+
 		if (EOK != oal_mutex_destroy(&l2br->reg_lock))
 		{
 			NXP_LOG_ERROR("Could not destroy mutex\n");
 		}
+
+		if (EOK != oal_mutex_destroy(&l2br->evt_lock))
+		{
+			NXP_LOG_ERROR("Could not destroy mutex\n");
+		}
+
+		if (NULL != l2br->shadow)
+		{
+			oal_mm_free(l2br->shadow);
+			l2br->shadow = NULL;
+		}
+
+		if (NULL != l2br->port_nodes)
+		{
+			oal_mm_free(l2br->port_nodes);
+			l2br->port_nodes = NULL;
+		}
+
+		if (NULL != l2br->chain)
+		{
+			oal_mm_free(l2br->chain);
+			l2br->chain = NULL;
+		}
+
+		if (NULL != l2br->chain_addr)
+		{
+			oal_mm_free(l2br->chain_addr);
+			l2br->chain_addr = NULL;
+		}
+
+		if (NULL != l2br->displaced)
+		{
+			oal_mm_free(l2br->displaced);
+			l2br->displaced = NULL;
+		}
+
+		if (NULL != l2br->evt_queue)
+		{
+			oal_mm_free(l2br->evt_queue);
+			l2br->evt_queue = NULL;
+		}
+
 		oal_mm_free(l2br);
 	}
 }
@@ -1670,6 +3284,34 @@ __attribute__((pure)) uint32_t pfe_l2br_table_entry_get_vlan(const pfe_l2br_tabl
     return entry->u.mac2f_entry.vlan;
 }
 
+/**
+ * @brief		Get MAC address from L2 table entry
+ * @param[in]	entry The entry
+ * @param[out]	mac_addr Buffer where the MAC address shall be written
+ * @retval		EOK Success
+ * @retval		EINVAL Invalid/missing argument or entry is not a MAC table entry
+ */
+errno_t pfe_l2br_table_entry_get_mac_addr(const pfe_l2br_table_entry_t *entry, pfe_mac_addr_t mac_addr)
+{
+#if defined(PFE_CFG_NULL_ARG_CHECK)
+	if (unlikely((NULL == entry) || (NULL == mac_addr)))
+	{
+		NXP_LOG_ERROR("NULL argument received\n");
+		return EINVAL;
+	}
+#endif /* PFE_CFG_NULL_ARG_CHECK */
+
+	if (PFE_L2BR_TABLE_MAC2F != entry->type)
+	{
+		NXP_LOG_WARNING("Invalid entry type\n");
+		return EINVAL;
+	}
+
+	(void)memcpy(mac_addr, entry->u.mac2f_entry.mac, sizeof(pfe_mac_addr_t));
+
+	return EOK;
+}
+
 /**
  * @brief		Associate action data with table entry
  * @details		Action data vector is available as output of entry match event.
@@ -1924,6 +3566,50 @@ uint32_t pfe_l2br_table_entry_to_str(const pfe_l2br_table_entry_t *entry, struct
 	return 0;
 }
 
+/**
+ * @brief		Return table command statistics in text form
+ * @details		Writes the command completion latency histograms into the seq_file.
+ * @param[in]	l2br		The L2 bridge table instance
+ * @param[in]	seq			Pointer to debugfs seq_file
+ * @param[in]	verb_level	Verbosity level
+ * @return		Number of bytes written to the buffer
+ */
+uint32_t pfe_l2br_table_get_text_statistics(const pfe_l2br_table_t *l2br, struct seq_file *seq, uint8_t verb_level)
+{
+	const pfe_l2br_table_cmd_stats_t *stats;
+	uint32_t ii;
+
+#if defined(PFE_CFG_NULL_ARG_CHECK)
+	if (unlikely(NULL == l2br))
+	{
+		NXP_LOG_ERROR("NULL argument received\n");
+		return 0U;
+	}
+#endif /* PFE_CFG_NULL_ARG_CHECK */
+
+	/* We keep unused parameter verb_level for consistency with rest of the *_get_text_statistics() functions */
+	(void)verb_level;
+
+	stats = &l2br->cmd_stats;
+
+	seq_printf(seq, "%s table change events dropped: %u\n",
+			(PFE_L2BR_TABLE_MAC2F == l2br->type) ? "MAC" : "VLAN", (uint_t)l2br->evt_dropped);
+	seq_printf(seq, "%s table commands (spin limit: %u, timeouts: %u)\n",
+			(PFE_L2BR_TABLE_MAC2F == l2br->type) ? "MAC" : "VLAN",
+			(uint_t)stats->spin_limit, (uint_t)stats->timeouts);
+	for (ii = 0U; ii < (PFE_L2BR_TABLE_CMD_HIST_SIZE - 1U); ii++)
+	{
+		seq_printf(seq, "  <=%4u polls: %-10u <=%5u us: %u\n",
+				(uint_t)(1UL << ii), (uint_t)stats->spin_hist[ii],
+				(uint_t)(10UL << ii), (uint_t)stats->sleep_hist[ii]);
+	}
+	seq_printf(seq, "  > %4u polls: %-10u > %5u us: %u\n",
+			(uint_t)(1UL << (ii - 1U)), (uint_t)stats->spin_hist[ii],
+			(uint_t)(10UL << (ii - 1U)), (uint_t)stats->sleep_hist[ii]);
+
+	return 0U;
+}
+
 #ifdef PFE_CFG_TARGET_OS_AUTOSAR
 #define ETH_43_PFE_STOP_SEC_CODE
 #include "Eth_43_PFE_MemMap.h"
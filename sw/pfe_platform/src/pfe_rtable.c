@@ -35,6 +35,63 @@
  */
 #define PFE_RTABLE_CFG_PARANOID_ENTRY_UPDATE	TRUE
 
+/**
+ * @brief	Aging wheel geometry
+ * @details	Entries with time-out are kept in a two-level timing wheel keyed on their
+ *			expiry tick. The first level has (1 << L0_BITS) slots of one tick, the
+ *			second level (1 << L1_BITS) slots of one first level revolution each.
+ */
+#define PFE_RTABLE_CFG_AGING_L0_BITS			8U
+#define PFE_RTABLE_CFG_AGING_L1_BITS			6U
+#define PFE_RTABLE_AGING_L0_SIZE				(1UL << PFE_RTABLE_CFG_AGING_L0_BITS)
+#define PFE_RTABLE_AGING_L1_SIZE				(1UL << PFE_RTABLE_CFG_AGING_L1_BITS)
+
+/**
+ * @brief	Maximum number of entries examined by the aging per tick
+ */
+#define PFE_RTABLE_CFG_AGING_BUDGET			512U
+
+/**
+ * @brief	Maximum number of entries within a single hash bucket (0 = unlimited)
+ * @details	The firmware walks the whole chain of the bucket selected by the hash of
+ *			the frame's 5-tuple so the lookup time of every packet grows with the chain
+ *			length. The bucket is fixed by the hash computed by the firmware, entries
+ *			can't be placed elsewhere. If non-zero, new entries which would make the
+ *			chain longer are refused and the flow stays with the slow path.
+ *			Can be overridden by PFE_CFG_RT_MAX_CHAIN_LEN.
+ */
+#if defined(PFE_CFG_RT_MAX_CHAIN_LEN)
+#define PFE_RTABLE_CFG_MAX_CHAIN_LEN			(PFE_CFG_RT_MAX_CHAIN_LEN)
+#else
+#define PFE_RTABLE_CFG_MAX_CHAIN_LEN			8U
+#endif /* PFE_CFG_RT_MAX_CHAIN_LEN */
+
+/**
+ * @brief	Number of chain length histogram bins (the last one counts longer chains)
+ */
+#define PFE_RTABLE_CHAIN_HIST_SIZE				8U
+
+/**
+ * @brief	Number of buckets of the route ID index (power of 2)
+ * @details	Active entries with valid route ID are kept in per-route lists so that
+ *			all conntracks depending on a route can be found without walking
+ *			the whole table.
+ */
+#define PFE_RTABLE_ROUTE_INDEX_SIZE			256U
+
+/**
+ * @brief	Routing table resize plan item
+ * @details	Describes the placement of one active entry within the new table
+ * @see pfe_rtable_resize()
+ */
+typedef struct
+{
+	pfe_rtable_entry_t *entry;	/*	The API entry */
+	addr_t va;					/*	Location of the physical entry within the new table */
+	uint32_t hash;				/*	Bucket within the new table */
+	uint32_t prev;				/*	Index + 1 of the preceding item within the bucket, 0 for the bucket head */
+} pfe_rtable_resize_item_t;
+
 /**
  * @brief	Select criterion argument type
  * @details	Used to store and pass argument to the pfe_rtable_match_criterion()
@@ -60,6 +117,7 @@ struct pfe_rtable_tag
 	addr_t htable_end_va;					/*	Hash table: End of hash table, virtual */
 	addr_t htable_va_pa_offset;				/*	Offset = VA - PA */
 	uint32_t htable_size;					/*	Hash table: Number of entries */
+	pfe_rtable_entry_t **htable_entries;	/*	Hash table: API entries occupying the hash table slots (bucket heads) */
 
 	addr_t pool_base_pa;						/*	Pool: Base physical address */
 	addr_t pool_base_va;						/*	Pool: Base virtual address */
@@ -70,6 +128,9 @@ struct pfe_rtable_tag
 	fifo_t *pool_va;						/*	Pool of entries (virtual addresses) */
 
 	LLIST_t active_entries;					/*	List of active entries. Need to be protected by mutex */
+	LLIST_t *tuple_index;					/*	Host-side 5-tuple index of active entries (bucket heads). Need to be protected by mutex */
+	uint32_t tuple_index_size;				/*	Number of buckets within the 5-tuple index (power of 2) */
+	LLIST_t route_index[PFE_RTABLE_ROUTE_INDEX_SIZE];	/*	Host-side route ID index of active entries (bucket heads). Need to be protected by mutex */
 
 	oal_mutex_t *lock;						/*	Mutex to protect the table and related resources from concurrent accesses */
 #if !defined(PFE_CFG_TARGET_OS_AUTOSAR)
@@ -79,12 +140,19 @@ struct pfe_rtable_tag
 
 	pfe_rtable_get_criterion_t cur_crit;	/*	Current criterion */
 	LLIST_t *cur_item;						/*	Current entry to be returned. See ...get_first() and ...get_next() */
+	LLIST_t *cur_head;						/*	Head of the list ...get_next() is walking */
 	pfe_rtable_criterion_arg_t cur_crit_arg;/*	Current criterion argument */
 	pfe_l2br_t *bridge; /* Bridge pointer */
 	pfe_class_t *class;						/*	Classifier */
 	uint32_t active_entries_count;			/*	Counter of active RTable entries, needed for enabling/disabling of RTable lookup */
 	uint32_t conntrack_stats_table_addr;
 	uint16_t conntrack_stats_table_size;
+	uint32_t *stats_index_map;				/*	Conntrack stats table index allocation bitmap. Need to be protected by mutex */
+	uint32_t stats_index_hint;				/*	Lowest bitmap word which may contain a free index */
+	uint32_t aging_now;						/*	Aging wheel: Current tick */
+	LLIST_t aging_wheel_l0[PFE_RTABLE_AGING_L0_SIZE];	/*	Aging wheel: First level slots. Need to be protected by mutex */
+	LLIST_t aging_wheel_l1[PFE_RTABLE_AGING_L1_SIZE];	/*	Aging wheel: Second level slots. Need to be protected by mutex */
+	uint32_t chain_full_count;				/*	Number of entries refused due to PFE_RTABLE_CFG_MAX_CHAIN_LEN */
 };
 
 /**
@@ -103,17 +171,34 @@ struct pfe_rtable_entry_tag
 	struct pfe_rtable_entry_tag *prev_ble;		/*	!< Pointer to the previous entry from the same hash bucket */
 	struct pfe_rtable_entry_tag *child;		/*	!< Entry associated with this one (used to identify entries for 'reply' direction) */
 	uint32_t timeout;							/*	!< Timeout value in seconds */
-	uint32_t curr_timeout;						/*	!< Current timeout value */
+	uint32_t expiry;							/*	!< Aging wheel tick of the next activity check */
+	uint32_t idle_since;						/*	!< Aging wheel tick the entry has been armed or last seen active at */
 	uint32_t route_id;							/*	!< User-defined route ID */
 	bool_t route_id_valid;						/*	!< If TRUE then 'route_id' is valid */
+	bool_t link_pending;						/*	!< Entry written but not linked to its hash chain yet (bulk add) */
 	int8_t ref_counter;							/*	!< Count of leased references (pointers) to this entry */
+	oal_mm_slab_t *slab;						/*	!< Slab the entry has been allocated from, NULL if allocated by oal_mm_malloc() */
 	void *refptr;								/*	!< User-defined value */
 	pfe_rtable_callback_t callback;				/*	!< User-defined callback function */
 	void *callback_arg;							/*	!< User-defined callback argument */
 	LLIST_t list_entry;							/*	!< Linked list element */
 	LLIST_t list_to_remove_entry;				/*	!< Linked list element */
+	LLIST_t tuple_index_entry;					/*	!< 5-tuple index bucket element */
+	LLIST_t route_index_entry;					/*	!< Route ID index bucket element, unlinked if prNext is NULL */
+	LLIST_t aging_entry;						/*	!< Aging wheel slot element */
 };
 
+/**
+ * @brief	Routing table entry allocation unit
+ * @details	The API entry and its physical entry cache are allocated together. The
+ *			API entry is the first member so both share the same address.
+ */
+typedef struct
+{
+	pfe_rtable_entry_t entry;
+	pfe_ct_rtable_entry_t phys_entry_cache;
+} pfe_rtable_entry_obj_t;
+
 /**
  * @brief	IP version type
  */
@@ -142,13 +227,34 @@ enum pfe_rtable_worker_signals
 #include "Eth_43_PFE_MemMap.h"
 #endif /* PFE_CFG_TARGET_OS_AUTOSAR */
 
-static uint8_t stats_tbl_index[PFE_CFG_CONN_STATS_SIZE + 1];
 static bool_t rtable_in_lmem;
 
 #ifdef PFE_CFG_TARGET_OS_AUTOSAR
 #define ETH_43_PFE_STOP_SEC_VAR_CLEARED_8
 #include "Eth_43_PFE_MemMap.h"
 
+#define ETH_43_PFE_START_SEC_VAR_CLEARED_32
+#include "Eth_43_PFE_MemMap.h"
+#endif /* PFE_CFG_TARGET_OS_AUTOSAR */
+
+/*	Slice-by-4 lookup tables for pfe_get_crc32_be(). See pfe_crc32_be_init(). */
+static uint32_t crc32_be_tbl[4U][256U];
+
+#ifdef PFE_CFG_TARGET_OS_AUTOSAR
+#define ETH_43_PFE_STOP_SEC_VAR_CLEARED_32
+#include "Eth_43_PFE_MemMap.h"
+
+#define ETH_43_PFE_START_SEC_VAR_CLEARED_UNSPECIFIED
+#include "Eth_43_PFE_MemMap.h"
+#endif /* PFE_CFG_TARGET_OS_AUTOSAR */
+
+/*	Cache of pfe_rtable_entry_obj_t objects. See pfe_rtable_entry_slab_init(). */
+static oal_mm_slab_t *rtable_entry_slab;
+
+#ifdef PFE_CFG_TARGET_OS_AUTOSAR
+#define ETH_43_PFE_STOP_SEC_VAR_CLEARED_UNSPECIFIED
+#include "Eth_43_PFE_MemMap.h"
+
 #define ETH_43_PFE_START_SEC_CONST_UNSPECIFIED
 #include "Eth_43_PFE_MemMap.h"
 #endif /* PFE_CFG_TARGET_OS_AUTOSAR */
@@ -164,6 +270,7 @@ static const pfe_ct_conntrack_stats_t pfe_rtable_clear_stats_stat = {0};
 #include "Eth_43_PFE_MemMap.h"
 #endif /* PFE_CFG_TARGET_OS_AUTOSAR */
 
+static void pfe_crc32_be_init(void);
 static uint32_t pfe_get_crc32_be(uint32_t crc, uint8_t *data, uint16_t len);
 static void pfe_rtable_invalidate(pfe_rtable_t *rtable);
 static uint32_t pfe_rtable_entry_get_hash(pfe_ct_rtable_entry_t *phys_entry_cache, pfe_ipv_type_t iptype, uint32_t hash_mask);
@@ -171,15 +278,31 @@ static bool_t pfe_rtable_phys_entry_is_htable(const pfe_rtable_t *rtable, addr_t
 static bool_t pfe_rtable_phys_entry_is_pool(const pfe_rtable_t *rtable, addr_t phys_entry_addr);
 static addr_t pfe_rtable_phys_entry_get_pa(pfe_rtable_t *rtable, addr_t phys_entry_va);
 static addr_t pfe_rtable_phys_entry_get_va(pfe_rtable_t *rtable, addr_t phys_entry_pa);
-static errno_t pfe_rtable_del_entry_nolock(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry);
+static errno_t pfe_rtable_del_entry_nolock(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry, bool_t sync);
+static void pfe_rtable_chain_set_valid(pfe_rtable_t *rtable, uint32_t bucket);
 static bool_t pfe_rtable_match_criterion(pfe_rtable_get_criterion_t crit, const pfe_rtable_criterion_arg_t *arg, pfe_rtable_entry_t *entry);
 static bool_t pfe_rtable_entry_is_in_table(const pfe_rtable_entry_t *entry);
-static pfe_rtable_entry_t *pfe_rtable_get_by_phys_entry_va(const pfe_rtable_t *rtable, addr_t phys_entry_va);
+static void pfe_rtable_entry_prepare(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry, pfe_ipv_type_t ipv_type, addr_t phys_entry_pa);
+static void pfe_rtable_entry_commit(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry, uint32_t hash, pfe_rtable_entry_t *prev_ble);
+static pfe_rtable_entry_t *pfe_rtable_get_bucket_tail(const pfe_rtable_t *rtable, uint32_t hash);
+static uint32_t pfe_rtable_get_bucket_len(const pfe_rtable_t *rtable, uint32_t hash);
+static bool_t pfe_rtable_bucket_is_full(pfe_rtable_t *rtable, uint32_t hash);
+static uint32_t pfe_rtable_timeout_to_ticks(uint32_t timeout);
+static void pfe_rtable_aging_insert(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry);
+static void pfe_rtable_aging_arm(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry, uint32_t ticks);
+static void pfe_rtable_aging_remove(pfe_rtable_entry_t *entry);
+static void pfe_rtable_aging_take(LLIST_t *dst, LLIST_t *src);
+static void pfe_rtable_aging_expire(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry);
 static uint32_t pfe_rtable_create_stats_table(pfe_class_t *class, uint16_t conntrack_count);
-static uint8_t pfe_rtable_get_free_stats_index(const pfe_rtable_t *rtable);
-static void pfe_rtable_free_stats_index(uint8_t index);
+static uint8_t pfe_rtable_get_free_stats_index(pfe_rtable_t *rtable);
+static void pfe_rtable_free_stats_index(pfe_rtable_t *rtable, uint8_t index);
 static errno_t pfe_rtable_destroy_stats_table(pfe_class_t *class, uint32_t table_address);
 static bool_t pfe_rtable_entry_is_duplicate(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry);
+static uint32_t pfe_rtable_tuple_index_hash(const pfe_5_tuple_t *tuple);
+static pfe_rtable_entry_t *pfe_rtable_tuple_index_find(const pfe_rtable_t *rtable, const pfe_5_tuple_t *tuple);
+static LLIST_t *pfe_rtable_route_index_bucket(pfe_rtable_t *rtable, uint32_t route_id);
+static void pfe_rtable_route_index_insert(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry);
+static void pfe_rtable_route_index_remove(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry);
 static errno_t pfe_rtable_add_entry_by_hash(pfe_rtable_t *rtable, uint32_t hash, void **new_phys_entry_va, void **last_phys_entry_va, addr_t *new_phys_entry_pa);
 static void pfe_rtable_entry_free_nolock(pfe_rtable_entry_t *entry, bool_t decrement_reference);
 
@@ -257,102 +380,131 @@ static void pfe_rtable_clear_phys_entry(addr_t phys_entry)
 
 /**
  * @brief		Get the next free index in the conntrack stats table
- * @return		The index
+ * @details		Searches the allocation bitmap starting at the lowest word which
+ *				may contain a free index.
+ * @param[in]	rtable The routing table instance
+ * @return		The index, 0 (the default index) if there is no free one
  */
-static uint8_t pfe_rtable_get_free_stats_index(const pfe_rtable_t *rtable)
+static uint8_t pfe_rtable_get_free_stats_index(pfe_rtable_t *rtable)
 {
 	/* Index 0 is the default one. All conntracks that have no space
 	   in the table will be counted on default index */
-	uint8_t index = 1U;
+	uint32_t words = ((uint32_t)rtable->conntrack_stats_table_size + 31U) >> 5U;
+	uint32_t word, bit, index = 0U;
 
-	while (index < rtable->conntrack_stats_table_size)
+	for (word = rtable->stats_index_hint; word < words; word++)
 	{
-		if (stats_tbl_index[index] == 0U)
+		if (0xffffffffU != rtable->stats_index_map[word])
 		{
-			stats_tbl_index[index] = 1U;
+			for (bit = 0U; bit < 32U; bit++)
+			{
+				if (0U == (rtable->stats_index_map[word] & (1UL << bit)))
+				{
+					break;
+				}
+			}
+
+			index = (word << 5U) + bit;
 			break;
 		}
-		index ++;
 	}
 
+	rtable->stats_index_hint = word;
+
 	/* conntrack outside stats range. */
-	if (index == rtable->conntrack_stats_table_size)
+	if (index >= rtable->conntrack_stats_table_size)
+	{
+		index = 0U;
+	}
+	else
 	{
-		index = 0;
+		rtable->stats_index_map[index >> 5U] |= (uint32_t)(1UL << (index & 31U));
 	}
 
-	return index;
+	return (uint8_t)index;
 }
 
 /**
  * @brief		Free the index in the stats table
- * @param[in]		Index of the table
+ * @param[in]	rtable The routing table instance
+ * @param[in]	index Index to be released
  */
-static void pfe_rtable_free_stats_index(uint8_t index)
+static void pfe_rtable_free_stats_index(pfe_rtable_t *rtable, uint8_t index)
 {
-	if (index < (PFE_CFG_CONN_STATS_SIZE + 1U))
+	/* Index 0 is the default one, it is never released */
+	if ((0U != index) && (index < rtable->conntrack_stats_table_size))
 	{
-		stats_tbl_index[index] = 0U;
+		rtable->stats_index_map[index >> 5U] &= ~(uint32_t)(1UL << (index & 31U));
+		if (((uint32_t)index >> 5U) < rtable->stats_index_hint)
+		{
+			rtable->stats_index_hint = (uint32_t)index >> 5U;
+		}
 	}
 }
 
-static pfe_rtable_entry_t *pfe_rtable_get_by_phys_entry_va(const pfe_rtable_t *rtable, addr_t phys_entry_va)
+/**
+ * @brief		Build the CRC32 (big-endian, non-reflected) lookup tables
+ * @details		Table 0 is the classic byte-wise table. Table N holds the CRC of
+ *				a byte followed by N zero bytes so four bytes can be folded in
+ *				a single step.
+ */
+static void pfe_crc32_be_init(void)
 {
-	LLIST_t *item;
-	pfe_rtable_entry_t *entry;
-	bool_t match = FALSE;
+	uint32_t ii, jj, tempcrc;
 
-	/* There is no protection for the multiple accesses to the table because the function is called
-	   from the code which has already locked the table */
-
-	/*	Search for first matching entry */
-	if (FALSE == LLIST_IsEmpty(&rtable->active_entries))
+	for (ii = 0U; ii < 256U; ii++)
 	{
-		/*	Get first matching entry */
-		LLIST_ForEach(item, &rtable->active_entries)
-		{
-			/*	Get data */
-			entry = LLIST_Data(item, pfe_rtable_entry_t, list_entry);
+		tempcrc = ii << 24U;
 
-			/*	Remember current item to know where to start later */
-			if (NULL != entry)
-			{
-				if (phys_entry_va == entry->phys_entry_va)
-				{
-					match = TRUE;
-					break;
-				}
-			}
+		for (jj = 0U; jj < 8U; jj++)
+		{
+			tempcrc = (tempcrc << 1U) ^ ((0U != (tempcrc & 0x80000000U)) ? CRCPOLY_BE : 0U);
 		}
-	}
 
-	if (TRUE == match)
-	{
-		return entry;
+		crc32_be_tbl[0U][ii] = tempcrc;
 	}
-	else
+
+	for (jj = 1U; jj < 4U; jj++)
 	{
-		return NULL;
+		for (ii = 0U; ii < 256U; ii++)
+		{
+			tempcrc = crc32_be_tbl[jj - 1U][ii];
+			crc32_be_tbl[jj][ii] = (tempcrc << 8U) ^ crc32_be_tbl[0U][tempcrc >> 24U];
+		}
 	}
 }
 
+/**
+ * @brief		Compute CRC32 (big-endian, non-reflected)
+ * @details		Table driven (slice-by-4), bit-exact with the bit-wise algorithm
+ *				the firmware uses to compute the routing table hash.
+ * @param[in]	crc Initial CRC value
+ * @param[in]	data Data to be processed
+ * @param[in]	len Number of bytes
+ * @return		The CRC value
+ */
 static uint32_t pfe_get_crc32_be(uint32_t crc, uint8_t *data, uint16_t len)
 {
-	uint8_t i;
 	uint16_t length = len;
 	uint32_t tempcrc = crc;
 	const uint8_t *tempdata = data;
 
+	while (length >= 4U)
+	{
+		tempcrc ^= ((uint32_t)tempdata[0] << 24U) | ((uint32_t)tempdata[1] << 16U)
+					| ((uint32_t)tempdata[2] << 8U) | (uint32_t)tempdata[3];
+		tempcrc = crc32_be_tbl[3U][tempcrc >> 24U]
+					^ crc32_be_tbl[2U][(tempcrc >> 16U) & 0xffU]
+					^ crc32_be_tbl[1U][(tempcrc >> 8U) & 0xffU]
+					^ crc32_be_tbl[0U][tempcrc & 0xffU];
+		tempdata += 4U;
+		length -= 4U;
+	}
+
 	while (length > 0U)
 	{
-		tempcrc ^= ((uint32_t)(*tempdata) << 24U);
+		tempcrc = (tempcrc << 8U) ^ crc32_be_tbl[0U][((tempcrc >> 24U) ^ (uint32_t)(*tempdata)) & 0xffU];
 		tempdata++;
-
-		for (i = 0U; i < 8U; i++)
-		{
-			tempcrc = (tempcrc << 1U) ^ ((0U != (tempcrc & 0x80000000U)) ? CRCPOLY_BE : 0U);
-		}
-
 		length--;
 	}
 
@@ -612,6 +764,47 @@ static addr_t pfe_rtable_phys_entry_get_va(pfe_rtable_t *rtable, addr_t phys_ent
 	return va;
 }
 
+/**
+ * @brief		Create the routing table entry cache
+ * @details		Entries are created and released by the users of the routing table
+ *				(FCI, flow offload) and can outlive the table instance. The cache
+ *				therefore exists for the whole lifetime of the driver: it shall be
+ *				created once before the first routing table instance and destroyed
+ *				by pfe_rtable_entry_slab_fini() after all entries have been released.
+ *				Entries are allocated by oal_mm_malloc() if there is no cache.
+ * @return		EOK if success, error code otherwise
+ */
+errno_t pfe_rtable_entry_slab_init(void)
+{
+	errno_t ret = EOK;
+
+	if (NULL == rtable_entry_slab)
+	{
+		rtable_entry_slab = oal_mm_slab_create("pfe_rtable_entry", sizeof(pfe_rtable_entry_obj_t));
+		if (NULL == rtable_entry_slab)
+		{
+			NXP_LOG_WARNING("Couldn't create routing table entry slab\n");
+			ret = ENOMEM;
+		}
+	}
+
+	return ret;
+}
+
+/**
+ * @brief		Destroy the routing table entry cache
+ * @details		Counterpart of pfe_rtable_entry_slab_init(). All entries shall be
+ *				released before the call.
+ */
+void pfe_rtable_entry_slab_fini(void)
+{
+	if (NULL != rtable_entry_slab)
+	{
+		oal_mm_slab_destroy(rtable_entry_slab);
+		rtable_entry_slab = NULL;
+	}
+}
+
 /**
  * @brief		Create routing table entry instance
  * @details		Instance is intended to be used to construct the entry before it is
@@ -620,43 +813,49 @@ static addr_t pfe_rtable_phys_entry_get_va(pfe_rtable_t *rtable, addr_t phys_ent
  */
 pfe_rtable_entry_t *pfe_rtable_entry_create(void)
 {
-	pfe_rtable_entry_t *entry;
+	pfe_rtable_entry_obj_t *obj;
+	pfe_rtable_entry_t *entry = NULL;
+	oal_mm_slab_t *slab = rtable_entry_slab;
 
-	entry = oal_mm_malloc(sizeof(pfe_rtable_entry_t));
-	if (NULL == entry)
+	/*	Entry and its intermediate 'physical' entry storage are allocated at once,
+		from the slab if it has been created */
+	if (NULL != slab)
 	{
-		NXP_LOG_ERROR("Unable to allocate memory\n");
+		obj = oal_mm_slab_alloc(slab);
 	}
 	else
 	{
-		(void)memset(entry, 0, sizeof(pfe_rtable_entry_t));
-
-		/*	allocate intermediate 'physical' entry storage */
-		entry->phys_entry_cache = oal_mm_malloc(sizeof(pfe_ct_rtable_entry_t));
-		if (NULL == entry->phys_entry_cache)
+		obj = oal_mm_malloc(sizeof(pfe_rtable_entry_obj_t));
+		if (NULL != obj)
 		{
-			NXP_LOG_ERROR("Unable to allocate memory\n");
-			oal_mm_free(entry);
-			entry = NULL;
+			(void)memset(obj, 0, sizeof(pfe_rtable_entry_obj_t));
 		}
-		else
-		{
-			(void)memset(entry->phys_entry_cache, 0, sizeof(pfe_ct_rtable_entry_t));
+	}
+
+	if (NULL == obj)
+	{
+		NXP_LOG_ERROR("Unable to allocate memory\n");
+	}
+	else
+	{
+		entry = &obj->entry;
+		entry->slab = slab;
+		entry->phys_entry_cache = &obj->phys_entry_cache;
 
-			/*	Set defaults */
-			entry->rtable = NULL;
-			entry->timeout = 0xffffffffU;
-			entry->curr_timeout = entry->timeout;
-			entry->route_id = 0U;
-			entry->route_id_valid = FALSE;
-			entry->ref_counter = 0;
-			entry->callback = NULL;
-			entry->callback_arg = NULL;
-			entry->refptr = NULL;
-			entry->child = NULL;
+		/*	Set defaults */
+		entry->rtable = NULL;
+		entry->timeout = 0xffffffffU;
+		entry->expiry = 0U;
+		entry->idle_since = 0U;
+		entry->route_id = 0U;
+		entry->route_id_valid = FALSE;
+		entry->ref_counter = 0;
+		entry->callback = NULL;
+		entry->callback_arg = NULL;
+		entry->refptr = NULL;
+		entry->child = NULL;
 
-			entry->phys_entry_cache->flag_ipv6 = (uint8_t)IPV_INVALID;
-		}
+		entry->phys_entry_cache->flag_ipv6 = (uint8_t)IPV_INVALID;
 	}
 
 	return entry;
@@ -697,14 +896,15 @@ static void pfe_rtable_entry_free_nolock(pfe_rtable_entry_t *entry, bool_t decre
 					entry->child->child = NULL;
 				}
 
-				/* deallocate intermediate 'physical' entry storage */
-				if (NULL != entry->phys_entry_cache)
+				/* deallocate the entry together with the intermediate 'physical' entry storage */
+				if (NULL != entry->slab)
 				{
-					oal_mm_free(entry->phys_entry_cache);
+					oal_mm_slab_free(entry->slab, entry);
+				}
+				else
+				{
+					oal_mm_free(entry);
 				}
-
-				/* deallocate the entry */
-				oal_mm_free(entry);
 			}
 		}
 	}
@@ -1439,6 +1639,37 @@ void pfe_rtable_entry_remove_ttl_decrement(pfe_rtable_entry_t *entry)
 	}
 }
 
+/**
+ * @brief		Request removal of the outer VLAN header
+ * @details		Outer VLAN tag of the matching frames will be removed (RT_ACT_DEL_VLAN_HDR).
+ *				Any previously requested VLAN addition/replacement is cancelled.
+ * @param[in]	entry The routing table entry instance
+ */
+void pfe_rtable_entry_set_out_vlan_pop(pfe_rtable_entry_t *entry)
+{
+#if defined(PFE_CFG_NULL_ARG_CHECK)
+	if (unlikely(NULL == entry))
+	{
+		NXP_LOG_ERROR("NULL argument received\n");
+	}
+	else
+#endif /* PFE_CFG_NULL_ARG_CHECK */
+	{
+		if (NULL_ADDR != entry->phys_entry_va)
+		{
+			pfe_rtable_read_phys_entry(entry->phys_entry_va, entry->phys_entry_cache);
+		}
+
+		entry->phys_entry_cache->actions &= ~oal_htonl(RT_ACT_MOD_VLAN_HDR|RT_ACT_ADD_VLAN_HDR);
+		entry->phys_entry_cache->actions |= oal_htonl(RT_ACT_DEL_VLAN_HDR);
+
+		if (NULL_ADDR != entry->phys_entry_va)
+		{
+			pfe_rtable_write_phys_entry(entry->phys_entry_va, entry->phys_entry_cache);
+		}
+	}
+}
+
 /**
  * @brief		Set output source and destination MAC address
  * @details		MAC address set using this call will be used to add/replace the original MAC
@@ -1726,7 +1957,7 @@ pfe_ct_route_actions_t pfe_rtable_entry_get_action_flags(pfe_rtable_entry_t *ent
  */
 void pfe_rtable_entry_set_timeout(pfe_rtable_entry_t *entry, uint32_t timeout)
 {
-	uint32_t elapsed;
+	uint32_t start;
 
 #if defined(PFE_CFG_NULL_ARG_CHECK)
 	if (unlikely(NULL == entry))
@@ -1744,23 +1975,24 @@ void pfe_rtable_entry_set_timeout(pfe_rtable_entry_t *entry, uint32_t timeout)
 			}
 		}
 
-		if (0xffffffffU == entry->timeout)
-		{
-			entry->curr_timeout = timeout;
-		}
-		else
+		if (NULL != entry->rtable)
 		{
-			elapsed = entry->timeout - entry->curr_timeout;
-
-			if (elapsed >= timeout)
+			if (0xffffffffU == entry->timeout)
 			{
-				/*	This will cause entry timeout with next tick */
-				entry->curr_timeout = 0U;
+				start = entry->rtable->aging_now;
 			}
 			else
 			{
-				/*	Adjust current timeout by elapsed time of original timeout */
-				entry->curr_timeout = timeout - elapsed;
+				start = entry->idle_since;
+			}
+
+			pfe_rtable_aging_remove(entry);
+
+			if (0xffffffffU != timeout)
+			{
+				/*	Idle time elapsed so far counts towards the new timeout */
+				entry->idle_since = start;
+				pfe_rtable_aging_arm(entry->rtable, entry, pfe_rtable_timeout_to_ticks(timeout));
 			}
 		}
 
@@ -1791,8 +2023,29 @@ void pfe_rtable_entry_set_route_id(pfe_rtable_entry_t *entry, uint32_t route_id)
 	else
 #endif /* PFE_CFG_NULL_ARG_CHECK */
 	{
-		entry->route_id = route_id;
-		entry->route_id_valid = TRUE;
+		if (NULL != entry->rtable)
+		{
+			if (unlikely(EOK != oal_mutex_lock(entry->rtable->lock)))
+			{
+				NXP_LOG_ERROR("Mutex lock failed\n");
+			}
+
+			/*	Move the entry to the bucket of the new route */
+			pfe_rtable_route_index_remove(entry->rtable, entry);
+			entry->route_id = route_id;
+			entry->route_id_valid = TRUE;
+			pfe_rtable_route_index_insert(entry->rtable, entry);
+
+			if (unlikely(EOK != oal_mutex_unlock(entry->rtable->lock)))
+			{
+				NXP_LOG_ERROR("Mutex unlock failed\n");
+			}
+		}
+		else
+		{
+			entry->route_id = route_id;
+			entry->route_id_valid = TRUE;
+		}
 	}
 }
 
@@ -2068,10 +2321,8 @@ static bool_t pfe_rtable_entry_is_in_table(const pfe_rtable_entry_t *entry)
  */
 static bool_t pfe_rtable_entry_is_duplicate(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry)
 {
-	pfe_rtable_entry_t *entry2;
 	pfe_rtable_criterion_arg_t arg;
 	bool_t match = FALSE;
-	LLIST_t *item;
 
 #if defined(PFE_CFG_NULL_ARG_CHECK)
 	if (unlikely((NULL == rtable) || (NULL == entry)))
@@ -2090,22 +2341,7 @@ static bool_t pfe_rtable_entry_is_duplicate(pfe_rtable_t *rtable, pfe_rtable_ent
 		}
 		else
 		{
-			/*	Search for first matching entry */
-			if (FALSE == LLIST_IsEmpty(&rtable->active_entries))
-			{
-				/*	Get first matching entry */
-				LLIST_ForEach(item, &rtable->active_entries)
-				{
-					/*	Get data */
-					entry2 = LLIST_Data(item, pfe_rtable_entry_t, list_entry);
-
-					if (TRUE == pfe_rtable_match_criterion(RTABLE_CRIT_BY_5_TUPLE, &arg, entry2))
-					{
-						match = TRUE;
-						break;
-					}
-				}
-			}
+			match = (NULL != pfe_rtable_tuple_index_find(rtable, &arg.five_tuple));
 		}
 	}
 
@@ -2113,64 +2349,189 @@ static bool_t pfe_rtable_entry_is_duplicate(pfe_rtable_t *rtable, pfe_rtable_ent
 }
 
 /**
- * @brief		Add entry in the physical hash table
- * @param[in]	rtable The routing table instance
- * @param[in]	hash 5-tuple hash used for physical entry creation
- * @param[out]	new_phys_entry_va The VA of the new entry location in the physical table
- * @param[out]	last_phys_entry_va The VA of the last entry in the hash bucket prior to adding the new entry;
- * 				   it's the same as the new entry VA if the bucket is empty.
- * @param[out]	new_phys_entry_pa The PA (physical bus address) of the new entry location in the physical table.
- * @retval		EOK Success
- * @retval		ENOENT Routing table is full
+ * @brief		Compute the host-side 5-tuple index hash
+ * @details		FNV-1a over the address, port and protocol fields. Only used to
+ *				index the driver's own bookkeeping, it is not related to the hash
+ *				the firmware uses to place entries into the physical table.
+ * @param[in]	tuple The 5-tuple
+ * @return		The hash value
  */
-static errno_t pfe_rtable_add_entry_by_hash(pfe_rtable_t *rtable, uint32_t hash, void **new_phys_entry_va, void **last_phys_entry_va, addr_t *new_phys_entry_pa)
+static uint32_t pfe_rtable_tuple_index_hash(const pfe_5_tuple_t *tuple)
 {
-	pfe_ct_rtable_entry_t *hash_table_va = (pfe_ct_rtable_entry_t *)rtable->htable_base_va;
-	pfe_ct_rtable_entry_t phys_entry_cache_tmp;
-#if (TRUE == PFE_RTABLE_CFG_PARANOID_ENTRY_UPDATE)
-	pfe_ct_rtable_flags_t valid_tmp;
-#endif /* PFE_RTABLE_CFG_PARANOID_ENTRY_UPDATE */
-	bool_t in_pool = FALSE;
-	errno_t ret = EOK;
-	addr_t pa, va;
+	const uint8_t *data;
+	uint32_t hash = 0x811c9dc5U;
+	uint32_t len, ii;
 
-	pfe_rtable_read_phys_entry((addr_t)(&hash_table_va[hash]), &phys_entry_cache_tmp);
-	/*	Allocate 'real' entry from hash heads or pool */
-	if (0U == (oal_ntohl(phys_entry_cache_tmp.flags) & (uint32_t)RT_FL_VALID))
+	if (TRUE == tuple->src_ip.is_ipv4)
 	{
-		*new_phys_entry_va = &hash_table_va[hash];
+		data = &tuple->src_ip.v4.v4[0];
+		len = 4U;
 	}
 	else
 	{
-		/*	First-level entry is already occupied. Create entry within the pool. Get
-			some free entry from the pool first. */
-		*new_phys_entry_va = fifo_get(rtable->pool_va);
-		if (NULL == *new_phys_entry_va)
-		{
-			ret = ENOENT;
-		}
-		in_pool = TRUE;
-		NXP_LOG_WARNING("Routing table hash [0x%x] collision detected. New entry will be added to linked list leading to performance penalty during lookup.\n", (uint_t)hash);
+		data = (const uint8_t *)&tuple->src_ip.v6.v6[0];
+		len = 16U;
 	}
 
-	if (EOK == ret)
+	for (ii = 0U; ii < len; ii++)
 	{
-		/*	Find last entry in the chain */
-		*last_phys_entry_va = &hash_table_va[hash];
+		hash = (hash ^ data[ii]) * 0x01000193U;
+	}
 
-		/*	Make sure the new entry is invalid */
-		pfe_rtable_read_phys_entry((addr_t)*new_phys_entry_va, &phys_entry_cache_tmp);
-		phys_entry_cache_tmp.flags = RT_FL_NONE;
-		if (FALSE == in_pool)
+	data = (TRUE == tuple->dst_ip.is_ipv4) ? &tuple->dst_ip.v4.v4[0] : (const uint8_t *)&tuple->dst_ip.v6.v6[0];
+	for (ii = 0U; ii < len; ii++)
+	{
+		hash = (hash ^ data[ii]) * 0x01000193U;
+	}
+
+	hash = (hash ^ ((uint32_t)tuple->sport & 0xffU)) * 0x01000193U;
+	hash = (hash ^ ((uint32_t)tuple->sport >> 8U)) * 0x01000193U;
+	hash = (hash ^ ((uint32_t)tuple->dport & 0xffU)) * 0x01000193U;
+	hash = (hash ^ ((uint32_t)tuple->dport >> 8U)) * 0x01000193U;
+	hash = (hash ^ (uint32_t)tuple->proto) * 0x01000193U;
+
+	return hash;
+}
+
+/**
+ * @brief		Find an active entry by 5-tuple using the host-side index
+ * @param[in]	rtable The routing table instance
+ * @param[in]	tuple The 5-tuple to search for
+ * @return		The entry or NULL if not found
+ * @warning		Function is accessing routing table without protection from concurrent accesses.
+ *				Caller shall ensure proper protection.
+ */
+static pfe_rtable_entry_t *pfe_rtable_tuple_index_find(const pfe_rtable_t *rtable, const pfe_5_tuple_t *tuple)
+{
+	pfe_rtable_criterion_arg_t arg;
+	pfe_rtable_entry_t *entry;
+	LLIST_t *bucket, *item;
+
+	(void)memcpy(&arg.five_tuple, tuple, sizeof(pfe_5_tuple_t));
+	bucket = &rtable->tuple_index[pfe_rtable_tuple_index_hash(tuple) & (rtable->tuple_index_size - 1U)];
+
+	LLIST_ForEach(item, bucket)
+	{
+		entry = LLIST_Data(item, pfe_rtable_entry_t, tuple_index_entry);
+		if (TRUE == pfe_rtable_match_criterion(RTABLE_CRIT_BY_5_TUPLE, &arg, entry))
 		{
-			phys_entry_cache_tmp.next = 0U;
+			return entry;
 		}
-		pfe_rtable_write_phys_entry((addr_t)*new_phys_entry_va, &phys_entry_cache_tmp);
+	}
 
-		/*	Get physical address */
-		va = (addr_t)*new_phys_entry_va;
-		pa = pfe_rtable_phys_entry_get_pa(rtable, va);
-		if (NULL_ADDR == pa)
+	return NULL;
+}
+
+/**
+ * @brief		Get the route ID index bucket of a route
+ * @param[in]	rtable The routing table instance
+ * @param[in]	route_id The route ID (as stored within entries)
+ * @return		The bucket head
+ */
+static LLIST_t *pfe_rtable_route_index_bucket(pfe_rtable_t *rtable, uint32_t route_id)
+{
+	/*	Fold all bytes so that the byte order of the ID does not matter */
+	uint32_t hash = route_id ^ (route_id >> 8U) ^ (route_id >> 16U) ^ (route_id >> 24U);
+
+	return &rtable->route_index[hash & (PFE_RTABLE_ROUTE_INDEX_SIZE - 1U)];
+}
+
+/**
+ * @brief		Add an active entry to the route ID index
+ * @details		Entries without valid route ID are not indexed.
+ * @param[in]	rtable The routing table instance
+ * @param[in]	entry The entry
+ * @warning		Function is accessing routing table without protection from concurrent accesses.
+ *				Caller shall ensure proper protection.
+ */
+static void pfe_rtable_route_index_insert(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry)
+{
+	if (TRUE == entry->route_id_valid)
+	{
+		LLIST_AddAtEnd(&entry->route_index_entry, pfe_rtable_route_index_bucket(rtable, entry->route_id));
+	}
+}
+
+/**
+ * @brief		Remove an entry from the route ID index
+ * @details		Keeps get_first() and get_next() calls walking the index consistent.
+ * @param[in]	rtable The routing table instance
+ * @param[in]	entry The entry
+ * @warning		Function is accessing routing table without protection from concurrent accesses.
+ *				Caller shall ensure proper protection.
+ */
+static void pfe_rtable_route_index_remove(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry)
+{
+	if (NULL != entry->route_index_entry.prNext)
+	{
+		if (&entry->route_index_entry == rtable->cur_item)
+		{
+			rtable->cur_item = rtable->cur_item->prNext;
+		}
+
+		LLIST_Remove(&entry->route_index_entry);
+	}
+}
+
+/**
+ * @brief		Add entry in the physical hash table
+ * @param[in]	rtable The routing table instance
+ * @param[in]	hash 5-tuple hash used for physical entry creation
+ * @param[out]	new_phys_entry_va The VA of the new entry location in the physical table
+ * @param[out]	last_phys_entry_va The VA of the last entry in the hash bucket prior to adding the new entry;
+ * 				   it's the same as the new entry VA if the bucket is empty.
+ * @param[out]	new_phys_entry_pa The PA (physical bus address) of the new entry location in the physical table.
+ * @retval		EOK Success
+ * @retval		ENOENT Routing table is full
+ */
+static errno_t pfe_rtable_add_entry_by_hash(pfe_rtable_t *rtable, uint32_t hash, void **new_phys_entry_va, void **last_phys_entry_va, addr_t *new_phys_entry_pa)
+{
+	pfe_ct_rtable_entry_t *hash_table_va = (pfe_ct_rtable_entry_t *)rtable->htable_base_va;
+	pfe_ct_rtable_entry_t phys_entry_cache_tmp;
+#if (TRUE == PFE_RTABLE_CFG_PARANOID_ENTRY_UPDATE)
+	pfe_ct_rtable_flags_t valid_tmp;
+#endif /* PFE_RTABLE_CFG_PARANOID_ENTRY_UPDATE */
+	bool_t in_pool = FALSE;
+	errno_t ret = EOK;
+	addr_t pa, va;
+
+	pfe_rtable_read_phys_entry((addr_t)(&hash_table_va[hash]), &phys_entry_cache_tmp);
+	/*	Allocate 'real' entry from hash heads or pool */
+	if (0U == (oal_ntohl(phys_entry_cache_tmp.flags) & (uint32_t)RT_FL_VALID))
+	{
+		*new_phys_entry_va = &hash_table_va[hash];
+	}
+	else
+	{
+		/*	First-level entry is already occupied. Create entry within the pool. Get
+			some free entry from the pool first. */
+		*new_phys_entry_va = fifo_get(rtable->pool_va);
+		if (NULL == *new_phys_entry_va)
+		{
+			ret = ENOENT;
+		}
+		in_pool = TRUE;
+		NXP_LOG_WARNING("Routing table hash [0x%x] collision detected. New entry will be added to linked list leading to performance penalty during lookup.\n", (uint_t)hash);
+	}
+
+	if (EOK == ret)
+	{
+		/*	Find last entry in the chain */
+		*last_phys_entry_va = &hash_table_va[hash];
+
+		/*	Make sure the new entry is invalid */
+		pfe_rtable_read_phys_entry((addr_t)*new_phys_entry_va, &phys_entry_cache_tmp);
+		phys_entry_cache_tmp.flags = RT_FL_NONE;
+		if (FALSE == in_pool)
+		{
+			phys_entry_cache_tmp.next = 0U;
+		}
+		pfe_rtable_write_phys_entry((addr_t)*new_phys_entry_va, &phys_entry_cache_tmp);
+
+		/*	Get physical address */
+		va = (addr_t)*new_phys_entry_va;
+		pa = pfe_rtable_phys_entry_get_pa(rtable, va);
+		if (NULL_ADDR == pa)
 		{
 			NXP_LOG_ERROR("Couldn't get PA (entry @ v0x%p)\n", (void *)va);
 			if (pfe_rtable_phys_entry_is_pool(rtable, va))
@@ -2229,12 +2590,177 @@ static errno_t pfe_rtable_add_entry_by_hash(pfe_rtable_t *rtable, uint32_t hash,
 	return ret;
 }
 
+/**
+ * @brief		Fill the driver-managed fields of an entry about to be written to the table
+ * @param[in]	rtable The routing table instance
+ * @param[in]	entry The entry to be added
+ * @param[in]	ipv_type IP version of the entry
+ * @param[in]	phys_entry_pa The PA (physical bus address) of the entry location in the physical table
+ */
+static void pfe_rtable_entry_prepare(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry, pfe_ipv_type_t ipv_type, addr_t phys_entry_pa)
+{
+	pfe_ct_rtable_entry_t *phys_entry_cache = entry->phys_entry_cache;
+	pfe_l2br_domain_t *domain;
+	uint8_t index;
+
+	phys_entry_cache->status &= ~(uint8_t)RT_STATUS_ACTIVE;
+	index = pfe_rtable_get_free_stats_index(rtable);
+	phys_entry_cache->conntrack_stats_index = oal_htons((uint16_t)index);
+
+	/* Add vlan stats index into the phy_entry structure */
+	if (0U != (oal_ntohl(phys_entry_cache->actions) & ((uint32_t)RT_ACT_ADD_VLAN_HDR | (uint32_t)RT_ACT_MOD_VLAN_HDR)))
+	{
+		if (NULL != rtable->bridge)
+		{
+			domain = pfe_l2br_get_first_domain(rtable->bridge, L2BD_CRIT_BY_VLAN, (void *)(addr_t)oal_ntohs(phys_entry_cache->args.vlan));
+			if (domain != NULL)
+			{
+				phys_entry_cache->args.vlan_stats_index = oal_htons((uint16_t)pfe_l2br_get_vlan_stats_index(domain));
+			}
+			else
+			{
+				/* Index 0 is the fallback domain */
+				phys_entry_cache->args.vlan_stats_index = 0;
+			}
+		}
+	}
+
+	/*	Remember (physical) location of the new entry within the DDR. */
+	phys_entry_cache->rt_orig = oal_htonl((uint32_t)phys_entry_pa);
+
+	/*	Just invalidate the ingress interface here to not confuse the firmware code */
+	phys_entry_cache->i_phy_if = PFE_PHY_IF_ID_INVALID;
+	phys_entry_cache->flags = (pfe_ct_rtable_flags_t)oal_htonl((uint32_t)RT_FL_VALID | (((uint8_t)IPV4 == ipv_type) ? 0U : (uint32_t)RT_FL_IPV6));
+}
+
+/**
+ * @brief		Account an entry written to the physical table within the driver structures
+ * @param[in]	rtable The routing table instance
+ * @param[in]	entry The added entry
+ * @param[in]	hash Hash table index of the entry's bucket
+ * @param[in]	prev_ble Entry preceding the added one within the bucket, NULL if the entry is the bucket head
+ */
+static void pfe_rtable_entry_commit(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry, uint32_t hash, pfe_rtable_entry_t *prev_ble)
+{
+	pfe_5_tuple_t tuple;
+
+	entry->prev_ble = prev_ble;
+	entry->next_ble = NULL;
+	if (NULL != entry->prev_ble)
+	{
+		/*	Store pointer to the new entry */
+		entry->prev_ble->next_ble = entry;
+	}
+	else
+	{
+		rtable->htable_entries[hash] = entry;
+	}
+
+	LLIST_AddAtEnd(&entry->list_entry, &rtable->active_entries);
+
+	/*	Index the entry by its 5-tuple */
+	(void)pfe_rtable_entry_to_5t(entry, &tuple);
+	LLIST_AddAtEnd(&entry->tuple_index_entry, &rtable->tuple_index[pfe_rtable_tuple_index_hash(&tuple) & (rtable->tuple_index_size - 1U)]);
+
+	/*	Index the entry by its route */
+	pfe_rtable_route_index_insert(rtable, entry);
+
+	NXP_LOG_INFO("RTable entry added, hash: 0x%x\n", (uint_t)hash);
+
+	/*	Arm the aging */
+	if (0xffffffffU != entry->timeout)
+	{
+		entry->idle_since = rtable->aging_now;
+		pfe_rtable_aging_arm(rtable, entry, pfe_rtable_timeout_to_ticks(entry->timeout));
+	}
+
+	entry->rtable = rtable;
+	entry->ref_counter++;
+
+	if (0U == rtable->active_entries_count)
+	{
+		NXP_LOG_INFO("RTable first entry added, enable hardware RTable lookup\n");
+		pfe_class_rtable_lookup_enable(rtable->class);
+	}
+
+	rtable->active_entries_count++;
+	NXP_LOG_INFO("RTable active_entries_count: %u\n", (uint_t)(rtable->active_entries_count));
+}
+
+/**
+ * @brief		Get the last entry of a hash bucket
+ * @param[in]	rtable The routing table instance
+ * @param[in]	hash Hash table index of the bucket
+ * @return		The last entry or NULL if the bucket is empty
+ */
+static pfe_rtable_entry_t *pfe_rtable_get_bucket_tail(const pfe_rtable_t *rtable, uint32_t hash)
+{
+	pfe_rtable_entry_t *tail = rtable->htable_entries[hash];
+
+	if (NULL != tail)
+	{
+		while (NULL != tail->next_ble)
+		{
+			tail = tail->next_ble;
+		}
+	}
+
+	return tail;
+}
+
+/**
+ * @brief		Get number of entries within a hash bucket
+ * @param[in]	rtable The routing table instance
+ * @param[in]	hash Hash table index of the bucket
+ * @return		Number of entries in the bucket's chain
+ */
+static uint32_t pfe_rtable_get_bucket_len(const pfe_rtable_t *rtable, uint32_t hash)
+{
+	const pfe_rtable_entry_t *item = rtable->htable_entries[hash];
+	uint32_t len = 0U;
+
+	while (NULL != item)
+	{
+		len++;
+		item = item->next_ble;
+	}
+
+	return len;
+}
+
+/**
+ * @brief		Check whether a hash bucket may take another entry
+ * @param[in]	rtable The routing table instance
+ * @param[in]	hash Hash table index of the bucket
+ * @retval		TRUE The bucket chain reached PFE_RTABLE_CFG_MAX_CHAIN_LEN
+ * @retval		FALSE Entry can be added to the bucket
+ */
+static bool_t pfe_rtable_bucket_is_full(pfe_rtable_t *rtable, uint32_t hash)
+{
+	bool_t full = FALSE;
+
+#if (0U != PFE_RTABLE_CFG_MAX_CHAIN_LEN)
+	if (pfe_rtable_get_bucket_len(rtable, hash) >= PFE_RTABLE_CFG_MAX_CHAIN_LEN)
+	{
+		NXP_LOG_DEBUG("Routing table hash [0x%x] chain length limit reached. Entry refused.\n", (uint_t)hash);
+		rtable->chain_full_count++;
+		full = TRUE;
+	}
+#else
+	(void)rtable;
+	(void)hash;
+#endif /* PFE_RTABLE_CFG_MAX_CHAIN_LEN */
+
+	return full;
+}
+
 /**
  * @brief		Add entry to the table
  * @param[in]	rtable The routing table instance
  * @param[in]	entry The entry to be added
  * @retval		EOK Success
  * @retval		ENOENT Routing table is full
+ * @retval		ENOSPC Hash bucket chain is full (see PFE_RTABLE_CFG_MAX_CHAIN_LEN)
  * @retval		EEXIST Entry is already added
  * @retval		EINVAL Invalid entry
  * @note		IPv4 addresses within entry are in network order due to way how the type is defined
@@ -2244,10 +2770,8 @@ errno_t pfe_rtable_add_entry(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry)
 	pfe_ct_rtable_entry_t *phys_entry_cache = entry->phys_entry_cache;
 	void *new_phys_entry_va = NULL, *last_phys_entry_va = NULL;
 	addr_t new_phys_entry_pa = NULL_ADDR;
-	pfe_l2br_domain_t *domain;
 	pfe_ipv_type_t ipv_type;
 	uint32_t hash;
-	uint8_t index;
 	errno_t ret;
 
 #if defined(PFE_CFG_NULL_ARG_CHECK)
@@ -2280,68 +2804,243 @@ errno_t pfe_rtable_add_entry(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry)
 	ipv_type = ((uint8_t)IPV4 == phys_entry_cache->flag_ipv6) ? IPV4 : IPV6;
 	hash = pfe_rtable_entry_get_hash(phys_entry_cache, ipv_type, (rtable->htable_size - 1U));
 
-	ret = pfe_rtable_add_entry_by_hash(rtable, hash, &new_phys_entry_va, &last_phys_entry_va, &new_phys_entry_pa);
+	if (TRUE == pfe_rtable_bucket_is_full(rtable, hash))
+	{
+		ret = ENOSPC;
+	}
+	else
+	{
+		ret = pfe_rtable_add_entry_by_hash(rtable, hash, &new_phys_entry_va, &last_phys_entry_va, &new_phys_entry_pa);
+	}
+
 	if (EOK == ret)
 	{
 		/*	Remember the physical entry virtual address */
 		entry->phys_entry_va = (addr_t)new_phys_entry_va;
 
-		phys_entry_cache->status &= ~(uint8_t)RT_STATUS_ACTIVE;
-		index = pfe_rtable_get_free_stats_index(rtable);
-		phys_entry_cache->conntrack_stats_index = oal_htons((uint16_t)index);
+		pfe_rtable_entry_prepare(rtable, entry, ipv_type, new_phys_entry_pa);
+
+		/*	Ensure that all previous writes has been done */
+		pfe_rtable_write_phys_entry(entry->phys_entry_va, phys_entry_cache);
+		hal_wmb();
+
+		pfe_rtable_entry_commit(rtable, entry, hash,
+				(new_phys_entry_va == last_phys_entry_va) ? NULL : pfe_rtable_get_bucket_tail(rtable, hash));
+	}
+
+	if (unlikely(EOK != oal_mutex_unlock(rtable->lock)))
+	{
+		NXP_LOG_ERROR("Mutex unlock failed\n");
+	}
+
+	return ret;
+}
+
+/**
+ * @brief		Add multiple entries to the table
+ * @details		Bulk variant of pfe_rtable_add_entry(). The table is locked once for
+ *				the whole batch. Every new entry is written complete and valid while it
+ *				is not reachable by the firmware yet (empty bucket head, or a pool
+ *				entry not linked to any chain). Entries extending a chain of another
+ *				new entry are linked to it directly. Only links from chains already
+ *				visible to the firmware are made at the end, all at once, so the
+ *				firmware synchronization delay is paid once per batch instead of once
+ *				per collision.
+ * @param[in]	rtable The routing table instance
+ * @param[in]	entries Array of entries to be added
+ * @param[in]	count Number of entries within the array
+ * @param[out]	results Per-entry result code, see pfe_rtable_add_entry(). Can be NULL.
+ * @retval		EOK All entries have been added
+ * @retval		EINVAL Invalid argument
+ * @return		Result code of the first entry which has not been added otherwise
+ * @note		IPv4 addresses within entries are in network order due to way how the type is defined
+ */
+errno_t pfe_rtable_add_entries(pfe_rtable_t *rtable, pfe_rtable_entry_t **entries, uint32_t count, errno_t *results)
+{
+	pfe_ct_rtable_entry_t *hash_table_va;
+	pfe_ct_rtable_entry_t phys_entry_cache_tmp;
+	pfe_rtable_entry_t *entry, *tail;
+	pfe_ipv_type_t ipv_type;
+	bool_t need_sync = FALSE;
+	errno_t ret = EOK, entry_ret;
+	addr_t va, pa;
+	uint32_t ii, hash;
+
+#if defined(PFE_CFG_NULL_ARG_CHECK)
+	if (unlikely((NULL == rtable) || (NULL == entries)))
+	{
+		NXP_LOG_ERROR("NULL argument received\n");
+		return EINVAL;
+	}
+#endif /* PFE_CFG_NULL_ARG_CHECK */
+
+	hash_table_va = (pfe_ct_rtable_entry_t *)rtable->htable_base_va;
+
+	/*	Protect table accesses */
+	if (unlikely(EOK != oal_mutex_lock(rtable->lock)))
+	{
+		NXP_LOG_ERROR("Mutex lock failed\n");
+	}
+
+	for (ii = 0U; ii < count; ii++)
+	{
+		entry = entries[ii];
+		entry_ret = EOK;
 
-		/* Add vlan stats index into the phy_entry structure */
-		if (0U != (oal_ntohl(phys_entry_cache->actions) & ((uint32_t)RT_ACT_ADD_VLAN_HDR | (uint32_t)RT_ACT_MOD_VLAN_HDR)))
+		if (NULL == entry)
+		{
+			entry_ret = EINVAL;
+		}
+		else if (TRUE == pfe_rtable_entry_is_in_table(entry))
+		{
+			entry_ret = EINVAL;
+		}
+		else if (TRUE == pfe_rtable_entry_is_duplicate(rtable, entry))
+		{
+			entry_ret = EEXIST;
+		}
+		else
 		{
-			if (NULL != rtable->bridge)
+			ipv_type = ((uint8_t)IPV4 == entry->phys_entry_cache->flag_ipv6) ? IPV4 : IPV6;
+			hash = pfe_rtable_entry_get_hash(entry->phys_entry_cache, ipv_type, (rtable->htable_size - 1U));
+			tail = pfe_rtable_get_bucket_tail(rtable, hash);
+
+			/*	Allocate 'real' entry from hash heads or pool */
+			if (TRUE == pfe_rtable_bucket_is_full(rtable, hash))
+			{
+				entry_ret = ENOSPC;
+			}
+			else if (NULL == tail)
 			{
-				domain = pfe_l2br_get_first_domain(rtable->bridge, L2BD_CRIT_BY_VLAN, (void *)(addr_t)oal_ntohs(phys_entry_cache->args.vlan));
-				if (domain != NULL)
+				va = (addr_t)&hash_table_va[hash];
+			}
+			else
+			{
+				va = (addr_t)fifo_get(rtable->pool_va);
+				if (NULL_ADDR == va)
 				{
-					phys_entry_cache->args.vlan_stats_index = oal_htons((uint16_t)pfe_l2br_get_vlan_stats_index(domain));
+					entry_ret = ENOENT;
 				}
-				else
+			}
+
+			if (EOK == entry_ret)
+			{
+				pa = pfe_rtable_phys_entry_get_pa(rtable, va);
+				if (NULL_ADDR == pa)
 				{
-					/* Index 0 is the fallback domain */
-					phys_entry_cache->args.vlan_stats_index = 0;
+					NXP_LOG_ERROR("Couldn't get PA (entry @ v0x%p)\n", (void *)va);
+					if (NULL != tail)
+					{
+						(void)fifo_put(rtable->pool_va, (void *)va);
+					}
+
+					entry_ret = EFAULT;
 				}
 			}
+
+			if (EOK == entry_ret)
+			{
+				/*	Write the complete entry. It is not reachable by the firmware unless
+					it is a head of an empty bucket which makes it a consistent chain on
+					its own. */
+				entry->phys_entry_va = va;
+				pfe_rtable_entry_prepare(rtable, entry, ipv_type, pa);
+				entry->phys_entry_cache->next = 0U;
+				pfe_rtable_write_phys_entry(entry->phys_entry_va, entry->phys_entry_cache);
+
+				if (NULL != tail)
+				{
+					entry->link_pending = TRUE;
+					if (TRUE == tail->link_pending)
+					{
+						/*	Tail is a new entry not linked yet, it can be updated directly */
+						tail->phys_entry_cache->next = entry->phys_entry_cache->rt_orig;
+						pfe_rtable_write_phys_entry(tail->phys_entry_va, tail->phys_entry_cache);
+					}
+					else
+					{
+						need_sync = TRUE;
+					}
+				}
+
+				pfe_rtable_entry_commit(rtable, entry, hash, tail);
+			}
+		}
+
+		if (NULL != results)
+		{
+			results[ii] = entry_ret;
+		}
+
+		if ((EOK != entry_ret) && (EOK == ret))
+		{
+			ret = entry_ret;
+		}
+	}
+
+	/*	Ensure that all new entries are in place before they get linked */
+	hal_wmb();
+
+	if (TRUE == need_sync)
+	{
+#if (TRUE == PFE_RTABLE_CFG_PARANOID_ENTRY_UPDATE)
+		/*	Invalidate all chain tails to be updated */
+		for (ii = 0U; ii < count; ii++)
+		{
+			entry = entries[ii];
+			if ((NULL != entry) && (TRUE == entry->link_pending) && (FALSE == entry->prev_ble->link_pending))
+			{
+				pfe_rtable_read_phys_entry(entry->prev_ble->phys_entry_va, entry->prev_ble->phys_entry_cache);
+				phys_entry_cache_tmp = *entry->prev_ble->phys_entry_cache;
+				phys_entry_cache_tmp.flags = RT_FL_NONE;
+				pfe_rtable_write_phys_entry(entry->prev_ble->phys_entry_va, &phys_entry_cache_tmp);
+			}
 		}
 
-		/*	Remember (physical) location of the new entry within the DDR. */
-		phys_entry_cache->rt_orig = oal_htonl((uint32_t)new_phys_entry_pa);
+		/*	Wait some time due to sync with firmware */
+		oal_time_usleep(10U);
+#endif /* PFE_RTABLE_CFG_PARANOID_ENTRY_UPDATE */
 
-		/*	Just invalidate the ingress interface here to not confuse the firmware code */
-		phys_entry_cache->i_phy_if = PFE_PHY_IF_ID_INVALID;
-		phys_entry_cache->flags = (pfe_ct_rtable_flags_t)oal_htonl((uint32_t)RT_FL_VALID | (((uint8_t)IPV4 == ipv_type) ? 0U : (uint32_t)RT_FL_IPV6));
+		/*	Link the new chains */
+		for (ii = 0U; ii < count; ii++)
+		{
+			entry = entries[ii];
+			if ((NULL != entry) && (TRUE == entry->link_pending) && (FALSE == entry->prev_ble->link_pending))
+			{
+#if (FALSE == PFE_RTABLE_CFG_PARANOID_ENTRY_UPDATE)
+				pfe_rtable_read_phys_entry(entry->prev_ble->phys_entry_va, entry->prev_ble->phys_entry_cache);
+#endif /* PFE_RTABLE_CFG_PARANOID_ENTRY_UPDATE */
+				entry->prev_ble->phys_entry_cache->next = entry->phys_entry_cache->rt_orig;
+				phys_entry_cache_tmp = *entry->prev_ble->phys_entry_cache;
+#if (TRUE == PFE_RTABLE_CFG_PARANOID_ENTRY_UPDATE)
+				phys_entry_cache_tmp.flags = RT_FL_NONE;
+#endif /* PFE_RTABLE_CFG_PARANOID_ENTRY_UPDATE */
+				pfe_rtable_write_phys_entry(entry->prev_ble->phys_entry_va, &phys_entry_cache_tmp);
+			}
+		}
 
+#if (TRUE == PFE_RTABLE_CFG_PARANOID_ENTRY_UPDATE)
 		/*	Ensure that all previous writes has been done */
-		pfe_rtable_write_phys_entry(entry->phys_entry_va, phys_entry_cache);
 		hal_wmb();
 
-		entry->prev_ble = (NULL == last_phys_entry_va) ? NULL : pfe_rtable_get_by_phys_entry_va(rtable, (addr_t)last_phys_entry_va);
-		entry->next_ble = NULL;
-		if (NULL != entry->prev_ble)
+		/*	Re-enable the chain tails */
+		for (ii = 0U; ii < count; ii++)
 		{
-			/*	Store pointer to the new entry */
-			entry->prev_ble->next_ble = entry;
+			entry = entries[ii];
+			if ((NULL != entry) && (TRUE == entry->link_pending) && (FALSE == entry->prev_ble->link_pending))
+			{
+				pfe_rtable_write_phys_entry(entry->prev_ble->phys_entry_va, entry->prev_ble->phys_entry_cache);
+			}
 		}
+#endif /* PFE_RTABLE_CFG_PARANOID_ENTRY_UPDATE */
+	}
 
-		LLIST_AddAtEnd(&entry->list_entry, &rtable->active_entries);
-
-		NXP_LOG_INFO("RTable entry added, hash: 0x%x\n", (uint_t)hash);
-
-		entry->rtable = rtable;
-		entry->ref_counter++;
-
-		if (0U == rtable->active_entries_count)
+	for (ii = 0U; ii < count; ii++)
+	{
+		if (NULL != entries[ii])
 		{
-			NXP_LOG_INFO("RTable first entry added, enable hardware RTable lookup\n");
-			pfe_class_rtable_lookup_enable(rtable->class);
+			entries[ii]->link_pending = FALSE;
 		}
-
-		rtable->active_entries_count++;
-		NXP_LOG_INFO("RTable active_entries_count: %u\n", (uint_t)(rtable->active_entries_count));
 	}
 
 	if (unlikely(EOK != oal_mutex_unlock(rtable->lock)))
@@ -2383,7 +3082,7 @@ errno_t pfe_rtable_del_entry(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry)
 			entry->callback(entry, RTABLE_ENTRY_TIMEOUT);
 		}
 
-		ret = pfe_rtable_del_entry_nolock(rtable, entry);
+		ret = pfe_rtable_del_entry_nolock(rtable, entry, TRUE);
 
 		if (0U == rtable->active_entries_count)
 		{
@@ -2400,17 +3099,176 @@ errno_t pfe_rtable_del_entry(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry)
 	return ret;
 }
 
+/**
+ * @brief		Delete multiple entries from the routing table
+ * @details		Bulk variant of pfe_rtable_del_entry(). The table is locked once for
+ *				the whole batch and the hardware lookup state is evaluated once at
+ *				the end. Instead of synchronizing with the firmware for every entry,
+ *				the hash buckets of all entries are disabled by invalidating their
+ *				head entries and the firmware is waited for once. The chains are then
+ *				updated directly and their heads are validated again.
+ * @param[in]	rtable The routing table instance
+ * @param[in]	entries Array of entries to be deleted
+ * @param[in]	count Number of entries within the array
+ * @param[out]	results Per-entry result code, see pfe_rtable_del_entry(). Can be NULL.
+ * @retval		EOK All entries have been deleted
+ * @retval		EINVAL Invalid argument
+ * @return		Result code of the first entry which has not been deleted otherwise
+ * @note		IPv4 addresses within entries are in network order due to way how the type is defined
+ */
+errno_t pfe_rtable_del_entries(pfe_rtable_t *rtable, pfe_rtable_entry_t **entries, uint32_t count, errno_t *results)
+{
+	errno_t ret = EOK, entry_ret;
+	pfe_ct_rtable_entry_t phys_entry_cache_tmp;
+	const pfe_rtable_entry_t *head;
+	uint32_t *buckets = NULL;
+	uint32_t ii, buckets_cnt = 0U;
+	bool_t sync = TRUE;
+
+#if defined(PFE_CFG_NULL_ARG_CHECK)
+	if (unlikely((NULL == rtable) || (NULL == entries)))
+	{
+		NXP_LOG_ERROR("NULL argument received\n");
+		return EINVAL;
+	}
+#endif /* PFE_CFG_NULL_ARG_CHECK */
+
+	/*	Protect table accesses */
+	if (unlikely(EOK != oal_mutex_lock(rtable->lock)))
+	{
+		NXP_LOG_ERROR("Mutex lock failed\n");
+	}
+
+	if (count > 1U)
+	{
+		buckets = oal_mm_malloc(count * sizeof(uint32_t));
+	}
+
+	if (NULL != buckets)
+	{
+		/*	Disable the chains of all entries at once. Entries are processed one by
+			one (with own firmware synchronization) when there is no memory. */
+		for (ii = 0U; ii < count; ii++)
+		{
+			if ((NULL == entries[ii]) || (FALSE == pfe_rtable_entry_is_in_table(entries[ii])))
+			{
+				continue;
+			}
+
+			head = entries[ii];
+			while (NULL != head->prev_ble)
+			{
+				head = head->prev_ble;
+			}
+
+			pfe_rtable_read_phys_entry(head->phys_entry_va, &phys_entry_cache_tmp);
+			if (0U != (oal_ntohl(phys_entry_cache_tmp.flags) & (uint32_t)RT_FL_VALID))
+			{
+				phys_entry_cache_tmp.flags = RT_FL_NONE;
+				pfe_rtable_write_phys_entry(head->phys_entry_va, &phys_entry_cache_tmp);
+				buckets[buckets_cnt] = (uint32_t)((head->phys_entry_va - rtable->htable_base_va) / sizeof(pfe_ct_rtable_entry_t));
+				buckets_cnt++;
+			}
+		}
+
+		/*	Ensure that all previous writes has been done */
+		hal_wmb();
+
+		/*	Wait some time due to sync with firmware */
+		oal_time_usleep(10U);
+
+		sync = FALSE;
+	}
+
+	for (ii = 0U; ii < count; ii++)
+	{
+		if (NULL == entries[ii])
+		{
+			entry_ret = EINVAL;
+		}
+		else
+		{
+			if (NULL != entries[ii]->callback)
+			{
+				entries[ii]->callback(entries[ii], RTABLE_ENTRY_TIMEOUT);
+			}
+
+			entry_ret = pfe_rtable_del_entry_nolock(rtable, entries[ii], sync);
+		}
+
+		if (NULL != results)
+		{
+			results[ii] = entry_ret;
+		}
+
+		if ((EOK != entry_ret) && (EOK == ret))
+		{
+			ret = entry_ret;
+		}
+	}
+
+	if (NULL != buckets)
+	{
+		/*	Ensure that the updated chains are in place before they get enabled */
+		hal_wmb();
+
+		for (ii = 0U; ii < buckets_cnt; ii++)
+		{
+			pfe_rtable_chain_set_valid(rtable, buckets[ii]);
+		}
+
+		oal_mm_free(buckets);
+	}
+
+	if (0U == rtable->active_entries_count)
+	{
+		NXP_LOG_INFO("RTable last entry removed, disable hardware RTable lookup\n");
+		pfe_class_rtable_lookup_disable(rtable->class);
+	}
+
+	if (unlikely(EOK != oal_mutex_unlock(rtable->lock)))
+	{
+		NXP_LOG_ERROR("Mutex unlock failed\n");
+	}
+
+	return ret;
+}
+
+/**
+ * @brief		Enable the chain of a hash bucket disabled by pfe_rtable_del_entries()
+ * @param[in]	rtable The routing table instance
+ * @param[in]	bucket The hash table index
+ * @warning		Function is accessing routing table without protection from concurrent accesses.
+ *				Caller shall ensure proper protection.
+ */
+static void pfe_rtable_chain_set_valid(pfe_rtable_t *rtable, uint32_t bucket)
+{
+	pfe_rtable_entry_t *head = rtable->htable_entries[bucket];
+
+	if (NULL != head)
+	{
+		pfe_rtable_read_phys_entry(head->phys_entry_va, head->phys_entry_cache);
+		head->phys_entry_cache->flags = (pfe_ct_rtable_flags_t)oal_htonl((uint32_t)RT_FL_VALID
+				| (((uint8_t)IPV4 == head->phys_entry_cache->flag_ipv6) ? 0U : (uint32_t)RT_FL_IPV6));
+		pfe_rtable_write_phys_entry(head->phys_entry_va, head->phys_entry_cache);
+	}
+}
+
 /**
  * @brief		Delete an entry from the routing table
  * @details		Internal function to delete an entry from the routing table without locking the table
  * @param[in]	rtable The routing table instance
  * @param[in]	entry Entry to be deleted (taken by get_first() or get_next() calls)
+ * @param[in]	sync If FALSE the chain of the entry has been disabled by invalidation of its
+ *					 head and the firmware synchronization has been done by the caller. The
+ *					 head stays invalid and has to be validated by the caller.
  * @return		EOK if success, error code otherwise
  * @note		IPv4 addresses within entry are in network order due to way how the type is defined
  */
-static errno_t pfe_rtable_del_entry_nolock(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry)
+static errno_t pfe_rtable_del_entry_nolock(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry, bool_t sync)
 {
 	pfe_ct_rtable_entry_t *phys_entry_cache = entry->phys_entry_cache;
+	pfe_ct_rtable_entry_t phys_entry_cache_tmp;
 	addr_t next_phys_entry_pa = NULL_ADDR;
 	errno_t ret;
 #if (TRUE == PFE_RTABLE_CFG_PARANOID_ENTRY_UPDATE)
@@ -2439,7 +3297,7 @@ static errno_t pfe_rtable_del_entry_nolock(pfe_rtable_t *rtable, pfe_rtable_entr
 		if (phys_entry_cache->conntrack_stats_index != 0U)
 		{
 			(void)pfe_rtable_clear_stats(rtable, oal_ntohs(phys_entry_cache->conntrack_stats_index));
-			pfe_rtable_free_stats_index(oal_ntohs(phys_entry_cache->conntrack_stats_index));
+			pfe_rtable_free_stats_index(rtable, (uint8_t)oal_ntohs(phys_entry_cache->conntrack_stats_index));
 		}
 
 		if (NULL != entry->next_ble)
@@ -2451,11 +3309,14 @@ static errno_t pfe_rtable_del_entry_nolock(pfe_rtable_t *rtable, pfe_rtable_entr
 			valid_tmp = entry->next_ble->phys_entry_cache->flags;
 			pfe_rtable_clear_phys_entry(entry->next_ble->phys_entry_va);
 
-			/*	Ensure that all previous writes has been done */
-			hal_wmb();
+			if (TRUE == sync)
+			{
+				/*	Ensure that all previous writes has been done */
+				hal_wmb();
 
-			/*	Wait some time due to sync with firmware */
-			oal_time_usleep(10U);
+				/*	Wait some time due to sync with firmware */
+				oal_time_usleep(10U);
+			}
 #endif /* PFE_RTABLE_CFG_PARANOID_ENTRY_UPDATE */
 
 			/*	Replace hash table entry with next (pool) entry */
@@ -2481,9 +3342,20 @@ static errno_t pfe_rtable_del_entry_nolock(pfe_rtable_t *rtable, pfe_rtable_entr
 			/*	Validate the new entry */
 			entry->next_ble->phys_entry_cache->flags = valid_tmp;
 #endif /* PFE_RTABLE_CFG_PARANOID_ENTRY_UPDATE */
-			pfe_rtable_write_phys_entry(entry->phys_entry_va, entry->next_ble->phys_entry_cache);
+			if (TRUE == sync)
+			{
+				pfe_rtable_write_phys_entry(entry->phys_entry_va, entry->next_ble->phys_entry_cache);
+			}
+			else
+			{
+				/*	The chain stays disabled until the caller validates the head */
+				phys_entry_cache_tmp = *entry->next_ble->phys_entry_cache;
+				phys_entry_cache_tmp.flags = RT_FL_NONE;
+				pfe_rtable_write_phys_entry(entry->phys_entry_va, &phys_entry_cache_tmp);
+			}
 			/*	Next entry now points to the copied physical one */
 			entry->next_ble->phys_entry_va = entry->phys_entry_va;
+			rtable->htable_entries[(entry->phys_entry_va - rtable->htable_base_va) / sizeof(pfe_ct_rtable_entry_t)] = entry->next_ble;
 
 			/*	Remove entry from the list of active entries and ensure consistency
 				of get_first() and get_next() calls */
@@ -2493,6 +3365,8 @@ static errno_t pfe_rtable_del_entry_nolock(pfe_rtable_t *rtable, pfe_rtable_entr
 			}
 
 			LLIST_Remove(&entry->list_entry);
+			LLIST_Remove(&entry->tuple_index_entry);
+			pfe_rtable_route_index_remove(rtable, entry);
 
 			entry->next_ble->prev_ble = entry->prev_ble;
 			entry->prev_ble = NULL;
@@ -2501,15 +3375,19 @@ static errno_t pfe_rtable_del_entry_nolock(pfe_rtable_t *rtable, pfe_rtable_entr
 		}
 		else
 		{
-			/*	Ensure that all previous writes has been done */
-			hal_wmb();
+			if (TRUE == sync)
+			{
+				/*	Ensure that all previous writes has been done */
+				hal_wmb();
 
-			/*	Wait some time due to sync with firmware */
-			oal_time_usleep(10U);
+				/*	Wait some time due to sync with firmware */
+				oal_time_usleep(10U);
+			}
 
 			/*	Zero-out the entry */
 			(void)memset(phys_entry_cache, 0, sizeof(pfe_ct_rtable_entry_t));
 			pfe_rtable_clear_phys_entry(entry->phys_entry_va);
+			rtable->htable_entries[(entry->phys_entry_va - rtable->htable_base_va) / sizeof(pfe_ct_rtable_entry_t)] = NULL;
 
 			/*	Remove entry from the list of active entries and ensure consistency
 				of get_first() and get_next() calls */
@@ -2519,6 +3397,8 @@ static errno_t pfe_rtable_del_entry_nolock(pfe_rtable_t *rtable, pfe_rtable_entr
 			}
 
 			LLIST_Remove(&entry->list_entry);
+			LLIST_Remove(&entry->tuple_index_entry);
+			pfe_rtable_route_index_remove(rtable, entry);
 
 			entry->prev_ble = NULL;
 			entry->next_ble = NULL;
@@ -2530,17 +3410,21 @@ static errno_t pfe_rtable_del_entry_nolock(pfe_rtable_t *rtable, pfe_rtable_entr
 		pfe_rtable_read_phys_entry(entry->phys_entry_va, phys_entry_cache);
 		pfe_rtable_read_phys_entry(entry->prev_ble->phys_entry_va, entry->prev_ble->phys_entry_cache);
 #if (TRUE == PFE_RTABLE_CFG_PARANOID_ENTRY_UPDATE)
-		/*	Invalidate the previous entry */
-		valid_tmp = entry->prev_ble->phys_entry_cache->flags;
-		entry->prev_ble->phys_entry_cache->flags = RT_FL_NONE;
-		pfe_rtable_write_phys_entry(entry->prev_ble->phys_entry_va, entry->prev_ble->phys_entry_cache);
+		/*	Nothing to synchronize within a chain disabled by the caller */
+		if (TRUE == sync)
+		{
+			/*	Invalidate the previous entry */
+			valid_tmp = entry->prev_ble->phys_entry_cache->flags;
+			entry->prev_ble->phys_entry_cache->flags = RT_FL_NONE;
+			pfe_rtable_write_phys_entry(entry->prev_ble->phys_entry_va, entry->prev_ble->phys_entry_cache);
 
-		/*	Invalidate the found entry */
-		phys_entry_cache->flags = RT_FL_NONE;
-		pfe_rtable_write_phys_entry(entry->phys_entry_va, phys_entry_cache);
+			/*	Invalidate the found entry */
+			phys_entry_cache->flags = RT_FL_NONE;
+			pfe_rtable_write_phys_entry(entry->phys_entry_va, phys_entry_cache);
 
-		/*	Wait some time to sync with firmware */
-		oal_time_usleep(10U);
+			/*	Wait some time to sync with firmware */
+			oal_time_usleep(10U);
+		}
 #endif /* PFE_RTABLE_CFG_PARANOID_ENTRY_UPDATE */
 
 		/*	Bypass the found entry */
@@ -2548,14 +3432,23 @@ static errno_t pfe_rtable_del_entry_nolock(pfe_rtable_t *rtable, pfe_rtable_entr
 		pfe_rtable_write_phys_entry(entry->prev_ble->phys_entry_va, entry->prev_ble->phys_entry_cache);
 
 #if (TRUE == PFE_RTABLE_CFG_PARANOID_ENTRY_UPDATE)
-		/*	Ensure that all previous writes has been done */
-		hal_wmb();
+		if (TRUE == sync)
+		{
+			/*	Ensure that all previous writes has been done */
+			hal_wmb();
 
-		/*	Validate the previous entry */
-		entry->prev_ble->phys_entry_cache->flags = valid_tmp;
-		pfe_rtable_write_phys_entry(entry->prev_ble->phys_entry_va, entry->prev_ble->phys_entry_cache);
+			/*	Validate the previous entry */
+			entry->prev_ble->phys_entry_cache->flags = valid_tmp;
+			pfe_rtable_write_phys_entry(entry->prev_ble->phys_entry_va, entry->prev_ble->phys_entry_cache);
+		}
 #endif /* PFE_RTABLE_CFG_PARANOID_ENTRY_UPDATE */
 
+		if (phys_entry_cache->conntrack_stats_index != 0U)
+		{
+			(void)pfe_rtable_clear_stats(rtable, oal_ntohs(phys_entry_cache->conntrack_stats_index));
+			pfe_rtable_free_stats_index(rtable, (uint8_t)oal_ntohs(phys_entry_cache->conntrack_stats_index));
+		}
+
 		/*	Clear the found physical entry and return it back to the pool */
 		pfe_rtable_clear_phys_entry(entry->phys_entry_va);
 		ret = fifo_put(rtable->pool_va, (void *)entry->phys_entry_va);
@@ -2572,6 +3465,8 @@ static errno_t pfe_rtable_del_entry_nolock(pfe_rtable_t *rtable, pfe_rtable_entr
 		}
 
 		LLIST_Remove(&entry->list_entry);
+		LLIST_Remove(&entry->tuple_index_entry);
+		pfe_rtable_route_index_remove(rtable, entry);
 
 		/*	Set up links */
 		entry->prev_ble->next_ble = entry->next_ble;
@@ -2589,6 +3484,8 @@ static errno_t pfe_rtable_del_entry_nolock(pfe_rtable_t *rtable, pfe_rtable_entr
 		NXP_LOG_ERROR("Wrong address (found rtable entry @ v0x%p)\n", (void *)entry->phys_entry_va);
 	}
 
+	pfe_rtable_aging_remove(entry);
+
 	entry->rtable = NULL;
 	entry->ref_counter--;
 
@@ -2606,17 +3503,217 @@ static errno_t pfe_rtable_del_entry_nolock(pfe_rtable_t *rtable, pfe_rtable_entr
 }
 
 /**
- * @brief		Scan the table and update timeouts
+ * @brief		Check whether the entry has been matched by the firmware
+ * @details		Returns state of the entry's RT_STATUS_ACTIVE flag and clears it so
+ *				subsequent calls report activity since the previous call only.
+ *				Intended for entries without time-out (managed by an external
+ *				aging mechanism) since pfe_rtable_do_timeouts() consumes the flag
+ *				of the entries with time-out set.
+ * @param[in]	rtable The routing table instance
+ * @param[in]	entry The routing table entry instance
+ * @retval		TRUE Entry has been matched since the last call
+ * @retval		FALSE Entry has not been matched or is not in the table
+ */
+bool_t pfe_rtable_entry_is_active(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry)
+{
+	bool_t active = FALSE;
+
+#if defined(PFE_CFG_NULL_ARG_CHECK)
+	if (unlikely((NULL == rtable) || (NULL == entry)))
+	{
+		NXP_LOG_ERROR("NULL argument received\n");
+	}
+	else
+#endif /* PFE_CFG_NULL_ARG_CHECK */
+	{
+		if (unlikely(EOK != oal_mutex_lock(rtable->lock)))
+		{
+			NXP_LOG_ERROR("Mutex lock failed\n");
+		}
+
+		if (NULL_ADDR != entry->phys_entry_va)
+		{
+			pfe_rtable_read_phys_entry(entry->phys_entry_va, entry->phys_entry_cache);
+
+			if (0U != ((uint8_t)RT_STATUS_ACTIVE & (uint8_t)entry->phys_entry_cache->status))
+			{
+				active = TRUE;
+				entry->phys_entry_cache->status &= ~(uint8_t)RT_STATUS_ACTIVE;
+				pfe_rtable_write_phys_entry(entry->phys_entry_va, entry->phys_entry_cache);
+			}
+		}
+
+		if (unlikely(EOK != oal_mutex_unlock(rtable->lock)))
+		{
+			NXP_LOG_ERROR("Mutex unlock failed\n");
+		}
+	}
+
+	return active;
+}
+
+/**
+ * @brief		Convert entry timeout to number of aging ticks
+ * @param[in]	timeout Timeout value in seconds
+ * @return		Number of ticks, at least 1
+ */
+static uint32_t pfe_rtable_timeout_to_ticks(uint32_t timeout)
+{
+	uint32_t ticks = timeout / PFE_RTABLE_CFG_TICK_PERIOD_SEC;
+
+	return (0U == ticks) ? 1U : ticks;
+}
+
+/**
+ * @brief		Put an entry to the aging wheel slot according to its expiry
+ * @param[in]	rtable The routing table instance
+ * @param[in]	entry The entry. Must not be linked to any slot.
+ * @warning		Function is accessing routing table without protection from concurrent accesses.
+ *				Caller shall ensure proper protection.
+ */
+static void pfe_rtable_aging_insert(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry)
+{
+	uint32_t delta = entry->expiry - rtable->aging_now;
+
+	if (delta > 0x7fffffffU)
+	{
+		/*	Overdue, process with the next tick */
+		LLIST_AddAtEnd(&entry->aging_entry, &rtable->aging_wheel_l0[(rtable->aging_now + 1U) & (PFE_RTABLE_AGING_L0_SIZE - 1U)]);
+	}
+	else if (delta < PFE_RTABLE_AGING_L0_SIZE)
+	{
+		LLIST_AddAtEnd(&entry->aging_entry, &rtable->aging_wheel_l0[entry->expiry & (PFE_RTABLE_AGING_L0_SIZE - 1U)]);
+	}
+	else
+	{
+		/*	Far expiry. Entry is moved to the first level once the second level
+			slot is reached (or put back here if it is still too far). */
+		LLIST_AddAtEnd(&entry->aging_entry, &rtable->aging_wheel_l1[(entry->expiry >> PFE_RTABLE_CFG_AGING_L0_BITS) & (PFE_RTABLE_AGING_L1_SIZE - 1U)]);
+	}
+}
+
+/**
+ * @brief		Schedule the next activity check of an entry
+ * @details		The firmware only tells whether the entry has been used since the
+ *				activity flag has been cleared. The flag is sampled at least twice
+ *				per timeout so an idle entry is removed between 1 and 1.5 of its
+ *				timeout after the last use.
+ * @param[in]	rtable The routing table instance
+ * @param[in]	entry The entry with valid 'idle_since'. Must not be linked to any slot.
+ * @param[in]	ticks The entry timeout in ticks
+ * @warning		Function is accessing routing table without protection from concurrent accesses.
+ *				Caller shall ensure proper protection.
+ */
+static void pfe_rtable_aging_arm(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry, uint32_t ticks)
+{
+	uint32_t half = (ticks + 1U) / 2U;
+	uint32_t left = (entry->idle_since + ticks) - rtable->aging_now;
+
+	if ((0U == left) || (left > ticks))
+	{
+		/*	Idle for the whole timeout, time-out with the next tick */
+		entry->expiry = rtable->aging_now + 1U;
+	}
+	else if (left < half)
+	{
+		entry->expiry = rtable->aging_now + left;
+	}
+	else
+	{
+		entry->expiry = rtable->aging_now + half;
+	}
+
+	pfe_rtable_aging_insert(rtable, entry);
+}
+
+/**
+ * @brief		Remove an entry from the aging wheel
+ * @param[in]	entry The entry
+ */
+static void pfe_rtable_aging_remove(pfe_rtable_entry_t *entry)
+{
+	if (NULL != entry->aging_entry.prNext)
+	{
+		LLIST_Remove(&entry->aging_entry);
+	}
+}
+
+/**
+ * @brief		Move all items of a list to another (empty) list head
+ * @param[out]	dst The destination list head
+ * @param[in]	src The source list head. Is empty on return.
+ */
+static void pfe_rtable_aging_take(LLIST_t *dst, LLIST_t *src)
+{
+	if (TRUE == LLIST_IsEmpty(src))
+	{
+		LLIST_Init(dst);
+	}
+	else
+	{
+		dst->prNext = src->prNext;
+		dst->prPrev = src->prPrev;
+		dst->prNext->prPrev = dst;
+		dst->prPrev->prNext = dst;
+		LLIST_Init(src);
+	}
+}
+
+/**
+ * @brief		Remove a timed-out entry from the table
+ * @param[in]	rtable The routing table instance
+ * @param[in]	entry The entry
+ * @warning		Function is accessing routing table without protection from concurrent accesses.
+ *				Caller shall ensure proper protection.
+ */
+static void pfe_rtable_aging_expire(pfe_rtable_t *rtable, pfe_rtable_entry_t *entry)
+{
+	errno_t err;
+
+	/*	Call user's callback if requested */
+	if (NULL != entry->callback)
+	{
+		entry->callback(entry, RTABLE_ENTRY_TIMEOUT);
+	}
+
+	/*	Physically remove the entry from table */
+	err = pfe_rtable_del_entry_nolock(rtable, entry, TRUE);
+	if (EOK != err)
+	{
+		NXP_LOG_ERROR("Couldn't delete timed-out entry: %d\n", err);
+
+		/*	Keep the entry aging, otherwise it would stay in the table forever */
+		pfe_rtable_aging_remove(entry);
+		if ((TRUE == pfe_rtable_entry_is_in_table(entry)) && (0xffffffffU != entry->timeout))
+		{
+			entry->idle_since = rtable->aging_now;
+			pfe_rtable_aging_arm(rtable, entry, pfe_rtable_timeout_to_ticks(entry->timeout));
+		}
+	}
+	else
+	{
+		pfe_rtable_entry_free_nolock(entry, FALSE);
+	}
+}
+
+/**
+ * @brief		Advance the aging wheel by one tick and process the due entries
+ * @details		Only entries whose check tick has been reached are examined. Their
+ *				firmware activity flag is read: an active entry is re-armed for
+ *				a full timeout, an entry idle for the whole timeout is removed together
+ *				with its paired ('reply' direction) entry, others are checked again
+ *				by pfe_rtable_aging_arm(). At most PFE_RTABLE_CFG_AGING_BUDGET
+ *				entries are examined per tick; the rest is deferred to the next one.
  * @param[in]	rtable The routing table instance
  * @note		Runs within the rtable worker thread context
  */
 void pfe_rtable_do_timeouts(pfe_rtable_t *rtable)
 {
-	LLIST_t *item, *aux;
-	LLIST_t to_be_removed_list;
-	pfe_rtable_entry_t *entry;
-	uint8_t flags;
-	errno_t err;
+	LLIST_t due, *item;
+	pfe_rtable_entry_t *entry, *child;
+	uint32_t budget = PFE_RTABLE_CFG_AGING_BUDGET;
+	uint32_t ticks;
+	LLIST_t *next_slot;
 
 #if defined(PFE_CFG_NULL_ARG_CHECK)
 	if (unlikely(NULL == rtable))
@@ -2631,89 +3728,79 @@ void pfe_rtable_do_timeouts(pfe_rtable_t *rtable)
 			NXP_LOG_ERROR("Mutex lock failed\n");
 		}
 
-		LLIST_Init(&to_be_removed_list);
+		rtable->aging_now++;
 
-		/*	Go through all active entries */
-		LLIST_ForEach(item, &rtable->active_entries)
+		/*	Cascade the second level slot once per first level revolution */
+		if (0U == (rtable->aging_now & (PFE_RTABLE_AGING_L0_SIZE - 1U)))
 		{
-			entry = LLIST_Data(item, pfe_rtable_entry_t, list_entry);
+			pfe_rtable_aging_take(&due, &rtable->aging_wheel_l1[(rtable->aging_now >> PFE_RTABLE_CFG_AGING_L0_BITS) & (PFE_RTABLE_AGING_L1_SIZE - 1U)]);
+			while (FALSE == LLIST_IsEmpty(&due))
+			{
+				item = due.prNext;
+				LLIST_Remove(item);
+				pfe_rtable_aging_insert(rtable, LLIST_Data(item, pfe_rtable_entry_t, aging_entry));
+			}
+		}
 
-			if (0xffffffffU == entry->timeout)
+		pfe_rtable_aging_take(&due, &rtable->aging_wheel_l0[rtable->aging_now & (PFE_RTABLE_AGING_L0_SIZE - 1U)]);
+		next_slot = &rtable->aging_wheel_l0[(rtable->aging_now + 1U) & (PFE_RTABLE_AGING_L0_SIZE - 1U)];
+
+		while (FALSE == LLIST_IsEmpty(&due))
+		{
+			item = due.prNext;
+			LLIST_Remove(item);
+			entry = LLIST_Data(item, pfe_rtable_entry_t, aging_entry);
+
+			if (0U == budget)
+			{
+				/*	Out of budget for this tick */
+				LLIST_AddAtEnd(item, next_slot);
+				continue;
+			}
+
+			if ((entry->expiry != rtable->aging_now) && ((entry->expiry - rtable->aging_now) <= 0x7fffffffU))
 			{
+				/*	Not due yet (timeout has been extended) */
+				pfe_rtable_aging_insert(rtable, entry);
 				continue;
 			}
 
+			budget--;
+			ticks = pfe_rtable_timeout_to_ticks(entry->timeout);
+
 			if (NULL_ADDR != entry->phys_entry_va)
 			{
 				pfe_rtable_read_phys_entry(entry->phys_entry_va, entry->phys_entry_cache);
 			}
-			flags = (uint8_t)entry->phys_entry_cache->status;
 
-			if (0U != ((uint8_t)RT_STATUS_ACTIVE & flags))
+			if (0U != ((uint8_t)RT_STATUS_ACTIVE & (uint8_t)entry->phys_entry_cache->status))
 			{
-				/*	Entry is active. Reset timeout and the active flag. */
-				entry->curr_timeout = entry->timeout;
+				/*	Entry has been used since the last check. Clear the active flag and re-arm. */
 				entry->phys_entry_cache->status &= ~(uint8_t)RT_STATUS_ACTIVE;
 				if (NULL_ADDR != entry->phys_entry_va)
 				{
 					pfe_rtable_write_phys_entry(entry->phys_entry_va, entry->phys_entry_cache);
 				}
-			}
-			else
-			{
-				if (entry->curr_timeout >= PFE_RTABLE_CFG_TICK_PERIOD_SEC)
-				{
-					entry->curr_timeout -= PFE_RTABLE_CFG_TICK_PERIOD_SEC;
-				}
-				else
-				{
-					entry->curr_timeout = 0;
-				}
 
-				/*	Entry is not active */
-				if (0U == entry->curr_timeout)
-				{
-					/*	Call user's callback if requested */
-					if (NULL != entry->callback)
-					{
-						entry->callback(entry, RTABLE_ENTRY_TIMEOUT);
-					}
-
-					/*	Collect entries to be removed */
-					LLIST_AddAtEnd(&entry->list_to_remove_entry, &to_be_removed_list);
-
-					/* For entries which are part of a bidirectional pair, check the paired partner */
-					if (NULL != entry->child)
-					{
-						/* If paired partner is not yet marked as 'processed', then process it */
-						/* Magic number is a flag for timeout loop to skip this entry if it is later encountered. */
-						if (0xffffffffU != entry->child->timeout)
-						{
-							if (NULL != entry->child->callback)
-							{
-								entry->child->callback(entry->child, RTABLE_ENTRY_TIMEOUT);
-							}
-							LLIST_AddAtEnd(&entry->child->list_to_remove_entry, &to_be_removed_list);
-							entry->child->timeout = 0xffffffffU;  /* mark the paired partner as 'processed' */
-						}
-					}
-				}
+				entry->idle_since = rtable->aging_now;
+				pfe_rtable_aging_arm(rtable, entry, ticks);
 			}
-		}
-
-		LLIST_ForEachRemovable(item, aux, &to_be_removed_list)
-		{
-			entry = LLIST_Data(item, pfe_rtable_entry_t, list_to_remove_entry);
-
-			/*	Physically remove the entry from table */
-			err = pfe_rtable_del_entry_nolock(rtable, entry);
-			if (EOK != err)
+			else if ((rtable->aging_now - entry->idle_since) < ticks)
 			{
-				NXP_LOG_ERROR("Couldn't delete timed-out entry: %d\n", err);
+				/*	Idle, but not for the whole timeout yet */
+				pfe_rtable_aging_arm(rtable, entry, ticks);
 			}
 			else
 			{
-				pfe_rtable_entry_free_nolock(entry, FALSE);
+				/*	For entries which are part of a bidirectional pair, remove also the paired partner */
+				child = entry->child;
+
+				pfe_rtable_aging_expire(rtable, entry);
+
+				if ((NULL != child) && (TRUE == pfe_rtable_entry_is_in_table(child)))
+				{
+					pfe_rtable_aging_expire(rtable, child);
+				}
 			}
 		}
 
@@ -2953,7 +4040,20 @@ pfe_rtable_t *pfe_rtable_create(pfe_class_t *class, pfe_l2br_t *bridge, pfe_rtab
 
 				rtable->conntrack_stats_table_size = PFE_CFG_CONN_STATS_SIZE;
 
-				(void)memset(&stats_tbl_index, 0, sizeof(stats_tbl_index));
+				/* Index 0 is the default one, keep it allocated */
+				rtable->stats_index_map = oal_mm_malloc((((uint32_t)rtable->conntrack_stats_table_size + 31U) >> 5U) * sizeof(uint32_t));
+				if (NULL == rtable->stats_index_map)
+				{
+					NXP_LOG_ERROR("Unable to allocate memory\n");
+					pfe_rtable_destroy(rtable);
+					return NULL;
+				}
+
+				(void)memset(rtable->stats_index_map, 0, (((uint32_t)rtable->conntrack_stats_table_size + 31U) >> 5U) * sizeof(uint32_t));
+				rtable->stats_index_map[0] = 1U;
+				rtable->stats_index_hint = 0U;
+
+				pfe_crc32_be_init();
 
 				rtable->conntrack_stats_table_addr = pfe_rtable_create_stats_table(class ,PFE_CFG_CONN_STATS_SIZE + 1U);
 
@@ -2991,56 +4091,402 @@ pfe_rtable_t *pfe_rtable_create(pfe_class_t *class, pfe_l2br_t *bridge, pfe_rtab
 					return NULL;
 				}
 
-				/*	Fill the pool */
-				table_va = (pfe_ct_rtable_entry_t *)rtable->pool_base_va;
+				/*	Fill the pool */
+				table_va = (pfe_ct_rtable_entry_t *)rtable->pool_base_va;
+
+				for (ii=0U; ii<rtable->pool_size; ii++)
+				{
+					ret = fifo_put(rtable->pool_va, (void *)&table_va[ii]);
+					if (EOK != ret)
+					{
+						NXP_LOG_ERROR("Pool filling failed (VA pool)\n");
+						pfe_rtable_destroy(rtable);
+						return NULL;
+					}
+				}
+
+				/* Create list */
+				LLIST_Init(&rtable->active_entries);
+
+				/* Create the aging wheel */
+				rtable->aging_now = 0U;
+				for (ii=0U; ii<PFE_RTABLE_AGING_L0_SIZE; ii++)
+				{
+					LLIST_Init(&rtable->aging_wheel_l0[ii]);
+				}
+
+				for (ii=0U; ii<PFE_RTABLE_AGING_L1_SIZE; ii++)
+				{
+					LLIST_Init(&rtable->aging_wheel_l1[ii]);
+				}
+
+				/* Create the hash table slot owners */
+				rtable->htable_entries = oal_mm_malloc(rtable->htable_size * sizeof(pfe_rtable_entry_t *));
+				if (NULL == rtable->htable_entries)
+				{
+					NXP_LOG_ERROR("Unable to allocate memory\n");
+					pfe_rtable_destroy(rtable);
+					return NULL;
+				}
+
+				(void)memset(rtable->htable_entries, 0, rtable->htable_size * sizeof(pfe_rtable_entry_t *));
+
+				/* Create the 5-tuple index. One bucket per hash table entry. */
+				rtable->tuple_index_size = rtable->htable_size;
+				rtable->tuple_index = oal_mm_malloc(rtable->tuple_index_size * sizeof(LLIST_t));
+				if (NULL == rtable->tuple_index)
+				{
+					NXP_LOG_ERROR("Unable to allocate memory\n");
+					pfe_rtable_destroy(rtable);
+					return NULL;
+				}
+
+				for (ii=0U; ii<rtable->tuple_index_size; ii++)
+				{
+					LLIST_Init(&rtable->tuple_index[ii]);
+				}
+
+				/* Create the route ID index */
+				for (ii=0U; ii<PFE_RTABLE_ROUTE_INDEX_SIZE; ii++)
+				{
+					LLIST_Init(&rtable->route_index[ii]);
+				}
+
+				#if !defined(PFE_CFG_TARGET_OS_AUTOSAR)
+				/* Create mbox */
+				rtable->mbox = oal_mbox_create();
+				if (NULL == rtable->mbox)
+				{
+					NXP_LOG_ERROR("Mbox creation failed\n");
+					pfe_rtable_destroy(rtable);
+					return NULL;
+				}
+
+				/* Create worker thread */
+				rtable->worker = oal_thread_create(&rtable_worker_func, rtable, "rtable worker", 0);
+				if (NULL == rtable->worker)
+				{
+					NXP_LOG_ERROR("Couldn't start worker thread\n");
+					pfe_rtable_destroy(rtable);
+					return NULL;
+				}
+				else
+				{
+					if (EOK != oal_mbox_attach_timer(rtable->mbox, (uint32_t)PFE_RTABLE_CFG_TICK_PERIOD_SEC * 1000U, SIG_TIMER_TICK))
+					{
+						NXP_LOG_ERROR("Unable to attach timer\n");
+						pfe_rtable_destroy(rtable);
+						return NULL;
+					}
+				}
+				#endif /* !defined(PFE_CFG_TARGET_OS_AUTOSAR) */
+			}
+		}
+	}
+
+	return rtable;
+}
+
+/**
+ * @brief		Move the routing table to a new memory region of a different size
+ * @details		The new table is built from the active entries while the classifier
+ *				keeps using the current one. Since the new table is not visible to the
+ *				firmware yet, entries are written without the firmware synchronization
+ *				delays and the build runs under the table lock, so both tables describe
+ *				the same set of entries. Once the new table is complete the classifier
+ *				is switched to it and the driver structures are updated. Entry handles
+ *				and conntrack statistics remain valid.
+ *				The migration is not incremental: the classifier can only use one
+ *				table, so the whole table is switched at once. The hardware lookup
+ *				is disabled for the switch and frames received meanwhile miss the
+ *				routing table and are not fast-path routed (they are handled as
+ *				a routing table miss). Activity flags set by the firmware in the
+ *				original table after the entry has been copied are lost, so such
+ *				entries are seen idle by the next aging check. The table lock is
+ *				held for the whole build, so table updates are blocked for a time
+ *				proportional to the number of active entries.
+ * @param[in]	rtable The routing table instance
+ * @param[in]	config Location and size of the new table
+ * @retval		EOK Success. The original table memory is not used anymore and can be released.
+ * @retval		EINVAL Invalid argument
+ * @retval		ENOTSUP Table placed in LMEM can't be resized
+ * @retval		ENOSPC Active entries don't fit into the new table
+ * @retval		ENOMEM Memory allocation failed
+ * @note		The routing table remains unchanged when failed.
+ */
+errno_t pfe_rtable_resize(pfe_rtable_t *rtable, const pfe_rtable_cfg_t *config)
+{
+	pfe_ct_rtable_entry_t *table_va;
+	pfe_ct_rtable_entry_t phys_entry_cache_tmp;
+	pfe_rtable_resize_item_t *items = NULL;
+	uint32_t *tails = NULL;
+	pfe_rtable_entry_t **htable_entries = NULL;
+	LLIST_t *tuple_index = NULL;
+	fifo_t *pool_va = NULL;
+	pfe_rtable_entry_t *entry;
+	pfe_ipv_type_t ipv_type;
+	pfe_5_tuple_t tuple;
+	LLIST_t *item;
+	uint32_t ii, hash, count = 0U;
+	addr_t pa;
+	errno_t ret = EOK;
+
+#if defined(PFE_CFG_NULL_ARG_CHECK)
+	if (unlikely((NULL == rtable) || (NULL == config)))
+	{
+		NXP_LOG_ERROR("NULL argument received\n");
+		return EINVAL;
+	}
+#endif /* PFE_CFG_NULL_ARG_CHECK */
+
+	if ((NULL_ADDR == config->htable_base_va) || (NULL_ADDR == config->pool_base_va)
+			|| (0U == config->htable_size) || (0U != (config->htable_size & (config->htable_size - 1U))))
+	{
+		NXP_LOG_ERROR("Invalid routing table configuration\n");
+		return EINVAL;
+	}
+
+	if ((TRUE == rtable_in_lmem) || (TRUE == config->lmem_allocated))
+	{
+		NXP_LOG_ERROR("Routing table in LMEM can't be resized\n");
+		return ENOTSUP;
+	}
+
+	/*	Protect table accesses */
+	if (unlikely(EOK != oal_mutex_lock(rtable->lock)))
+	{
+		NXP_LOG_ERROR("Mutex lock failed\n");
+	}
+
+	if (rtable->active_entries_count > (config->htable_size + config->pool_size))
+	{
+		ret = ENOSPC;
+	}
+	else
+	{
+		items = oal_mm_malloc((rtable->active_entries_count + 1U) * sizeof(pfe_rtable_resize_item_t));
+		tails = oal_mm_malloc(config->htable_size * sizeof(uint32_t));
+		htable_entries = oal_mm_malloc(config->htable_size * sizeof(pfe_rtable_entry_t *));
+		tuple_index = oal_mm_malloc(config->htable_size * sizeof(LLIST_t));
+		pool_va = fifo_create(config->pool_size);
+		if ((NULL == items) || (NULL == tails) || (NULL == htable_entries) || (NULL == tuple_index) || (NULL == pool_va))
+		{
+			NXP_LOG_ERROR("Unable to allocate memory\n");
+			ret = ENOMEM;
+		}
+	}
+
+	if (EOK == ret)
+	{
+		(void)memset(tails, 0, config->htable_size * sizeof(uint32_t));
+		(void)memset(htable_entries, 0, config->htable_size * sizeof(pfe_rtable_entry_t *));
+
+		/*	5-tuple index follows the hash table size, see pfe_rtable_create() */
+		for (ii = 0U; ii < config->htable_size; ii++)
+		{
+			LLIST_Init(&tuple_index[ii]);
+		}
+
+		/*	Initialize the new table and its pool */
+		table_va = (pfe_ct_rtable_entry_t *)config->htable_base_va;
+		for (ii = 0U; ii < config->htable_size; ii++)
+		{
+			pfe_rtable_clear_phys_entry((addr_t)&table_va[ii]);
+		}
+
+		table_va = (pfe_ct_rtable_entry_t *)config->pool_base_va;
+		for (ii = 0U; ii < config->pool_size; ii++)
+		{
+			pfe_rtable_clear_phys_entry((addr_t)&table_va[ii]);
+			ret = fifo_put(pool_va, (void *)&table_va[ii]);
+			if (EOK != ret)
+			{
+				NXP_LOG_ERROR("Pool filling failed (VA pool)\n");
+				break;
+			}
+		}
+	}
+
+	if (EOK == ret)
+	{
+		/*	Build the new table. It is not used by the firmware so the entries
+			are written complete and linked directly. */
+		table_va = (pfe_ct_rtable_entry_t *)config->htable_base_va;
+		LLIST_ForEach(item, &rtable->active_entries)
+		{
+			entry = LLIST_Data(item, pfe_rtable_entry_t, list_entry);
+
+			/*	Take the current state including fields updated by the firmware */
+			pfe_rtable_read_phys_entry(entry->phys_entry_va, &phys_entry_cache_tmp);
+			ipv_type = ((uint8_t)IPV4 == phys_entry_cache_tmp.flag_ipv6) ? IPV4 : IPV6;
+			hash = pfe_rtable_entry_get_hash(&phys_entry_cache_tmp, ipv_type, (config->htable_size - 1U));
+
+			if (0U == tails[hash])
+			{
+				items[count].va = (addr_t)&table_va[hash];
+				pa = config->htable_base_pa + ((addr_t)hash * sizeof(pfe_ct_rtable_entry_t));
+			}
+			else
+			{
+				items[count].va = (addr_t)fifo_get(pool_va);
+				if (NULL_ADDR == items[count].va)
+				{
+					NXP_LOG_ERROR("Active entries don't fit into the new routing table pool\n");
+					ret = ENOSPC;
+					break;
+				}
+
+				pa = config->pool_base_pa + (items[count].va - config->pool_base_va);
+			}
+
+			items[count].entry = entry;
+			items[count].hash = hash;
+			items[count].prev = tails[hash];
+
+			/*	Write the entry to its new location */
+			phys_entry_cache_tmp.rt_orig = oal_htonl((uint32_t)(pa & 0xffffffffU));
+			phys_entry_cache_tmp.next = 0U;
+			pfe_rtable_write_phys_entry(items[count].va, &phys_entry_cache_tmp);
+
+			if (0U != tails[hash])
+			{
+				/*	Link it with the previous entry of the bucket */
+				pfe_rtable_read_phys_entry(items[tails[hash] - 1U].va, &phys_entry_cache_tmp);
+				phys_entry_cache_tmp.next = oal_htonl((uint32_t)(pa & 0xffffffffU));
+				pfe_rtable_write_phys_entry(items[tails[hash] - 1U].va, &phys_entry_cache_tmp);
+			}
+
+			count++;
+			tails[hash] = count;
+		}
+	}
+
+	if (EOK == ret)
+	{
+		/*	Ensure that the new table is in place before the classifier uses it */
+		hal_wmb();
+
+		ret = pfe_class_switch_rtable(rtable->class, config->htable_base_pa, config->htable_size, sizeof(pfe_ct_rtable_entry_t));
+		if (EOK != ret)
+		{
+			NXP_LOG_ERROR("Unable to set routing table address\n");
+
+			/*	Return the classifier to the original table, the lookup stays disabled
+				if even that fails so the firmware never walks a table the driver does not track */
+			if (EOK != pfe_class_switch_rtable(rtable->class, rtable->htable_base_pa, rtable->htable_size, sizeof(pfe_ct_rtable_entry_t)))
+			{
+				NXP_LOG_ERROR("Unable to restore routing table address, routing table lookup disabled\n");
+			}
+			else if (0U != rtable->active_entries_count)
+			{
+				pfe_class_rtable_lookup_enable(rtable->class);
+			}
+			else
+			{
+				; /*	No entries, lookup stays disabled */
+			}
+		}
+		else
+		{
+			if (0U != rtable->active_entries_count)
+			{
+				pfe_class_rtable_lookup_enable(rtable->class);
+			}
+
+			/*	Wait some time to let the firmware finish lookups within the original table */
+			oal_time_usleep(10U);
+		}
+	}
+
+	if (EOK == ret)
+	{
+		/*	Move the API entries to the new table */
+		for (ii = 0U; ii < count; ii++)
+		{
+			entry = items[ii].entry;
+			entry->phys_entry_va = items[ii].va;
+			entry->next_ble = NULL;
+			if (0U == items[ii].prev)
+			{
+				entry->prev_ble = NULL;
+				htable_entries[items[ii].hash] = entry;
+			}
+			else
+			{
+				entry->prev_ble = items[items[ii].prev - 1U].entry;
+				entry->prev_ble->next_ble = entry;
+			}
+
+			pfe_rtable_read_phys_entry(entry->phys_entry_va, entry->phys_entry_cache);
+
+			/*	Re-index the entry by its 5-tuple */
+			LLIST_Remove(&entry->tuple_index_entry);
+			(void)pfe_rtable_entry_to_5t(entry, &tuple);
+			LLIST_AddAtEnd(&entry->tuple_index_entry, &tuple_index[pfe_rtable_tuple_index_hash(&tuple) & (config->htable_size - 1U)]);
+		}
+
+		oal_mm_free(rtable->htable_entries);
+		rtable->htable_entries = htable_entries;
+		htable_entries = NULL;
+
+		oal_mm_free(rtable->tuple_index);
+		rtable->tuple_index = tuple_index;
+		rtable->tuple_index_size = config->htable_size;
+		tuple_index = NULL;
+
+		fifo_destroy(rtable->pool_va);
+		rtable->pool_va = pool_va;
+		pool_va = NULL;
+
+		rtable->htable_base_va = config->htable_base_va;
+		rtable->htable_base_pa = config->htable_base_pa;
+		rtable->htable_size = config->htable_size;
+		rtable->htable_end_va = rtable->htable_base_va + (rtable->htable_size * sizeof(pfe_ct_rtable_entry_t)) - 1U;
+		rtable->htable_end_pa = rtable->htable_base_pa + (rtable->htable_size * sizeof(pfe_ct_rtable_entry_t)) - 1U;
+		rtable->htable_va_pa_offset = rtable->htable_base_va - rtable->htable_base_pa;
+
+		rtable->pool_base_va = config->pool_base_va;
+		rtable->pool_base_pa = config->pool_base_pa;
+		rtable->pool_size = config->pool_size;
+		rtable->pool_end_va = rtable->pool_base_va + (rtable->pool_size * sizeof(pfe_ct_rtable_entry_t)) - 1U;
+		rtable->pool_end_pa = rtable->pool_base_pa + (rtable->pool_size * sizeof(pfe_ct_rtable_entry_t)) - 1U;
+		rtable->pool_va_pa_offset = rtable->pool_base_va - rtable->pool_base_pa;
+
+		NXP_LOG_INFO("Routing table resized, Hash Table @ p0x%"PRINTADDR_T" (%u entries), Pool @ p0x%"PRINTADDR_T" (%u entries)\n",
+				rtable->htable_base_pa, (uint_t)rtable->htable_size, rtable->pool_base_pa, (uint_t)rtable->pool_size);
+	}
+
+	if (unlikely(EOK != oal_mutex_unlock(rtable->lock)))
+	{
+		NXP_LOG_ERROR("Mutex unlock failed\n");
+	}
+
+	if (NULL != items)
+	{
+		oal_mm_free(items);
+	}
 
-				for (ii=0U; ii<rtable->pool_size; ii++)
-				{
-					ret = fifo_put(rtable->pool_va, (void *)&table_va[ii]);
-					if (EOK != ret)
-					{
-						NXP_LOG_ERROR("Pool filling failed (VA pool)\n");
-						pfe_rtable_destroy(rtable);
-						return NULL;
-					}
-				}
+	if (NULL != tails)
+	{
+		oal_mm_free(tails);
+	}
 
-				/* Create list */
-				LLIST_Init(&rtable->active_entries);
+	if (NULL != htable_entries)
+	{
+		oal_mm_free(htable_entries);
+	}
 
-				#if !defined(PFE_CFG_TARGET_OS_AUTOSAR)
-				/* Create mbox */
-				rtable->mbox = oal_mbox_create();
-				if (NULL == rtable->mbox)
-				{
-					NXP_LOG_ERROR("Mbox creation failed\n");
-					pfe_rtable_destroy(rtable);
-					return NULL;
-				}
+	if (NULL != tuple_index)
+	{
+		oal_mm_free(tuple_index);
+	}
 
-				/* Create worker thread */
-				rtable->worker = oal_thread_create(&rtable_worker_func, rtable, "rtable worker", 0);
-				if (NULL == rtable->worker)
-				{
-					NXP_LOG_ERROR("Couldn't start worker thread\n");
-					pfe_rtable_destroy(rtable);
-					return NULL;
-				}
-				else
-				{
-					if (EOK != oal_mbox_attach_timer(rtable->mbox, (uint32_t)PFE_RTABLE_CFG_TICK_PERIOD_SEC * 1000U, SIG_TIMER_TICK))
-					{
-						NXP_LOG_ERROR("Unable to attach timer\n");
-						pfe_rtable_destroy(rtable);
-						return NULL;
-					}
-				}
-				#endif /* !defined(PFE_CFG_TARGET_OS_AUTOSAR) */
-			}
-		}
+	if (NULL != pool_va)
+	{
+		fifo_destroy(pool_va);
 	}
 
-	return rtable;
+	return ret;
 }
 
 /**
@@ -3067,6 +4513,30 @@ uint32_t pfe_rtable_get_size(const pfe_rtable_t *rtable)
 	return ret;
 }
 
+/**
+* @brief		Returns count of entries currently added to the table
+* @param[in]	rtable The routing table instance
+* @return		Count of active entries within the table
+*/
+uint32_t pfe_rtable_get_entry_count(const pfe_rtable_t *rtable)
+{
+	uint32_t ret;
+
+#if defined(PFE_CFG_NULL_ARG_CHECK)
+	if (unlikely(NULL == rtable))
+	{
+		NXP_LOG_ERROR("NULL argument received\n");
+		ret = 0U;
+	}
+	else
+#endif /* PFE_CFG_NULL_ARG_CHECK */
+	{
+		ret = rtable->active_entries_count;
+	}
+
+	return ret;
+}
+
 /**
  * @brief		Destroy routing table instance
  * @param[in]	rtable The routing table instance
@@ -3133,6 +4603,24 @@ void pfe_rtable_destroy(pfe_rtable_t *rtable)
 			rtable->pool_va = NULL;
 		}
 
+		if (NULL != rtable->tuple_index)
+		{
+			oal_mm_free(rtable->tuple_index);
+			rtable->tuple_index = NULL;
+		}
+
+		if (NULL != rtable->htable_entries)
+		{
+			oal_mm_free(rtable->htable_entries);
+			rtable->htable_entries = NULL;
+		}
+
+		if (NULL != rtable->stats_index_map)
+		{
+			oal_mm_free(rtable->stats_index_map);
+			rtable->stats_index_map = NULL;
+		}
+
 		if (EOK != pfe_rtable_destroy_stats_table(rtable->class, rtable->conntrack_stats_table_addr))
 		{
 			NXP_LOG_ERROR("Could not destroy conntrack stats\n");
@@ -3384,6 +4872,8 @@ pfe_rtable_entry_t *pfe_rtable_get_first(pfe_rtable_t *rtable, pfe_rtable_get_cr
 	{
 		/*	Remember criterion and argument for possible subsequent pfe_rtable_get_next() calls */
 		rtable->cur_crit = crit;
+		rtable->cur_head = &rtable->active_entries;
+		rtable->cur_item = &rtable->active_entries;
 		switch (rtable->cur_crit)
 		{
 			case RTABLE_CRIT_ALL:
@@ -3424,16 +4914,29 @@ pfe_rtable_entry_t *pfe_rtable_get_first(pfe_rtable_t *rtable, pfe_rtable_get_cr
 				NXP_LOG_ERROR("Mutex lock failed\n");
 			};
 
-			/*	Get first matching entry */
-			LLIST_ForEach(item, &rtable->active_entries)
+			if (RTABLE_CRIT_BY_5_TUPLE == rtable->cur_crit)
 			{
-				/*	Get data */
-				entry = LLIST_Data(item, pfe_rtable_entry_t, list_entry);
-
-				/*	Remember current item to know where to start later */
-				rtable->cur_item = item->prNext;
+				/*	5-tuple is unique within the table, use the index. There is
+					nothing more to be returned by pfe_rtable_get_next(). */
+				entry = pfe_rtable_tuple_index_find(rtable, &rtable->cur_crit_arg.five_tuple);
+				rtable->cur_item = &rtable->active_entries;
 				if (NULL != entry)
 				{
+					match = TRUE;
+					entry->ref_counter++;
+				}
+			}
+			else if (RTABLE_CRIT_BY_ROUTE_ID == rtable->cur_crit)
+			{
+				/*	Walk only entries of the route's index bucket */
+				rtable->cur_head = pfe_rtable_route_index_bucket(rtable, rtable->cur_crit_arg.route_id);
+				rtable->cur_item = rtable->cur_head;
+				LLIST_ForEach(item, rtable->cur_head)
+				{
+					entry = LLIST_Data(item, pfe_rtable_entry_t, route_index_entry);
+
+					/*	Remember current item to know where to start later */
+					rtable->cur_item = item->prNext;
 					if (TRUE == pfe_rtable_match_criterion(rtable->cur_crit, &rtable->cur_crit_arg, entry))
 					{
 						match = TRUE;
@@ -3442,6 +4945,27 @@ pfe_rtable_entry_t *pfe_rtable_get_first(pfe_rtable_t *rtable, pfe_rtable_get_cr
 					}
 				}
 			}
+			else
+			{
+				/*	Get first matching entry */
+				LLIST_ForEach(item, &rtable->active_entries)
+				{
+					/*	Get data */
+					entry = LLIST_Data(item, pfe_rtable_entry_t, list_entry);
+
+					/*	Remember current item to know where to start later */
+					rtable->cur_item = item->prNext;
+					if (NULL != entry)
+					{
+						if (TRUE == pfe_rtable_match_criterion(rtable->cur_crit, &rtable->cur_crit_arg, entry))
+						{
+							match = TRUE;
+							entry->ref_counter++;
+							break;
+						}
+					}
+				}
+			}
 
 			if (unlikely(EOK != oal_mutex_unlock(rtable->lock)))
 			{
@@ -3483,7 +5007,7 @@ pfe_rtable_entry_t *pfe_rtable_get_next(pfe_rtable_t *rtable)
 	else
 #endif /* PFE_CFG_NULL_ARG_CHECK */
 	{
-		if (rtable->cur_item == &rtable->active_entries)
+		if (rtable->cur_item == rtable->cur_head)
 		{
 			/*	No more entries */
 			entry = NULL;
@@ -3496,10 +5020,17 @@ pfe_rtable_entry_t *pfe_rtable_get_next(pfe_rtable_t *rtable)
 				NXP_LOG_ERROR("Mutex lock failed\n");
 			}
 
-			while (rtable->cur_item != &rtable->active_entries)
+			while (rtable->cur_item != rtable->cur_head)
 			{
 				/*	Get data */
-				entry = LLIST_Data(rtable->cur_item, pfe_rtable_entry_t, list_entry);
+				if (RTABLE_CRIT_BY_ROUTE_ID == rtable->cur_crit)
+				{
+					entry = LLIST_Data(rtable->cur_item, pfe_rtable_entry_t, route_index_entry);
+				}
+				else
+				{
+					entry = LLIST_Data(rtable->cur_item, pfe_rtable_entry_t, list_entry);
+				}
 
 				/*	Remember current item to know where to start later */
 				rtable->cur_item = rtable->cur_item->prNext;
@@ -3530,6 +5061,100 @@ pfe_rtable_entry_t *pfe_rtable_get_next(pfe_rtable_t *rtable)
 	return entry;
 }
 
+/**
+ * @brief		Re-point all entries depending on a route
+ * @details		Sets new egress interface and output MAC addresses of every active entry
+ *				with given route ID. Dependents are found via the route ID index, the
+ *				physical entries are read and updated first and then written back in
+ *				a single pass so the firmware sees the new next hop on all of them at
+ *				once.
+ * @param[in]	rtable The routing table instance
+ * @param[in]	route_id The route ID (as passed to pfe_rtable_entry_set_route_id())
+ * @param[in]	iface The new egress interface
+ * @param[in]	smac The new output source MAC address
+ * @param[in]	dmac The new output destination MAC address
+ * @param[out]	count Number of updated entries. Can be NULL.
+ * @retval		EOK Success
+ * @retval		EINVAL Invalid argument
+ */
+errno_t pfe_rtable_update_route(pfe_rtable_t *rtable, uint32_t route_id, const pfe_phy_if_t *iface,
+								const pfe_mac_addr_t smac, const pfe_mac_addr_t dmac, uint32_t *count)
+{
+	pfe_ct_phy_if_id_t if_id;
+	pfe_rtable_entry_t *entry;
+	LLIST_t *bucket, *item;
+	uint32_t updated = 0U;
+	errno_t ret = EOK;
+
+#if defined(PFE_CFG_NULL_ARG_CHECK)
+	if (unlikely((NULL == rtable) || (NULL == iface)))
+	{
+		NXP_LOG_ERROR("NULL argument received\n");
+		ret = EINVAL;
+	}
+	else
+#endif /* PFE_CFG_NULL_ARG_CHECK */
+	{
+		if_id = pfe_phy_if_get_id(iface);
+		if (if_id > PFE_PHY_IF_ID_MAX)
+		{
+			NXP_LOG_ERROR("Physical interface ID is invalid: 0x%x\n", if_id);
+			ret = EINVAL;
+		}
+		else
+		{
+			if (unlikely(EOK != oal_mutex_lock(rtable->lock)))
+			{
+				NXP_LOG_ERROR("Mutex lock failed\n");
+			}
+
+			bucket = pfe_rtable_route_index_bucket(rtable, route_id);
+
+			/*	Prepare the new content of all dependents */
+			LLIST_ForEach(item, bucket)
+			{
+				entry = LLIST_Data(item, pfe_rtable_entry_t, route_index_entry);
+				if (route_id == entry->route_id)
+				{
+					pfe_rtable_read_phys_entry(entry->phys_entry_va, entry->phys_entry_cache);
+					entry->phys_entry_cache->e_phy_if = if_id;
+					(void)memcpy(entry->phys_entry_cache->args.smac, smac, sizeof(pfe_mac_addr_t));
+					(void)memcpy(entry->phys_entry_cache->args.dmac, dmac, sizeof(pfe_mac_addr_t));
+					entry->phys_entry_cache->actions |= oal_htonl(RT_ACT_ADD_ETH_HDR);
+				}
+			}
+
+			/*	Write them back in one pass */
+			LLIST_ForEach(item, bucket)
+			{
+				entry = LLIST_Data(item, pfe_rtable_entry_t, route_index_entry);
+				if (route_id == entry->route_id)
+				{
+					pfe_rtable_write_phys_entry(entry->phys_entry_va, entry->phys_entry_cache);
+					updated++;
+				}
+			}
+
+			/*	Ensure that all writes has been done */
+			hal_wmb();
+
+			if (unlikely(EOK != oal_mutex_unlock(rtable->lock)))
+			{
+				NXP_LOG_ERROR("Mutex unlock failed\n");
+			}
+
+			NXP_LOG_DEBUG("Route 0x%x: %u entries updated\n", (uint_t)route_id, (uint_t)updated);
+		}
+	}
+
+	if (NULL != count)
+	{
+		*count = updated;
+	}
+
+	return ret;
+}
+
 /**
  * @brief		Get conntrack statistics
  * @param[in]	rtable		The routing table instance
@@ -3597,6 +5222,109 @@ errno_t pfe_rtable_get_stats(const pfe_rtable_t *rtable, pfe_ct_conntrack_stats_
 	return ret;
 }
 
+/**
+ * @brief		Get number of entries in the conntrack statistics table
+ * @details		Entry 0 holds the default (no conntrack match) counters, the
+ *				conntracks use indices 1 to (return value - 1).
+ * @param[in]	rtable		The routing table instance
+ * @return		Number of entries in the conntrack statistics table
+ */
+uint32_t pfe_rtable_get_stats_table_size(const pfe_rtable_t *rtable)
+{
+	uint32_t size = 0U;
+
+#if defined(PFE_CFG_NULL_ARG_CHECK)
+	if (unlikely(NULL == rtable))
+	{
+		NXP_LOG_ERROR("NULL argument received\n");
+	}
+	else
+#endif /* PFE_CFG_NULL_ARG_CHECK */
+	{
+		size = (uint32_t)rtable->conntrack_stats_table_size + 1U;
+	}
+
+	return size;
+}
+
+/**
+ * @brief		Get a snapshot of a range of the conntrack statistics table
+ * @details		Instead of one DMEM transfer per index and PE (as done by
+ *				pfe_rtable_get_stats()) the whole range is copied from each PE in a
+ *				single burst. PEs are read one after another so only a single PE is
+ *				held by the transfer at a time.
+ * @param[in]	rtable		The routing table instance
+ * @param[out]	stats		Array of 'count' items, stats[i] receives the totals of index 'first' + i
+ * @param[in]	first		First conntrack statistics index to read
+ * @param[in]	count		Number of indices to read
+ * @retval		EOK Success
+ * @retval		EINVAL Invalid argument or range outside of the statistics table
+ * @retval		ENOMEM Not possible to allocate memory for read
+ */
+errno_t pfe_rtable_get_stats_bulk(const pfe_rtable_t *rtable, pfe_ct_conntrack_stats_t *stats, uint8_t first, uint32_t count)
+{
+	uint32_t i = 0U;
+	uint32_t j;
+	errno_t ret = EOK;
+	pfe_ct_conntrack_stats_t *buf = NULL;
+	uint32_t offset;
+	uint32_t len;
+
+#if defined(PFE_CFG_NULL_ARG_CHECK)
+	if (unlikely((NULL == rtable) || (NULL == stats)))
+	{
+		NXP_LOG_ERROR("NULL argument received\n");
+		ret = EINVAL;
+	}
+	else
+#endif /* PFE_CFG_NULL_ARG_CHECK */
+	if ((0U == count) || (((uint32_t)first + count) > ((uint32_t)rtable->conntrack_stats_table_size + 1U)))
+	{
+		NXP_LOG_ERROR("Invalid conntrack index range\n");
+		ret = EINVAL;
+	}
+	else
+	{
+		(void)memset(stats, 0, count * sizeof(pfe_ct_conntrack_stats_t));
+
+		len = count * (uint32_t)sizeof(pfe_ct_conntrack_stats_t);
+		buf = oal_mm_malloc(len);
+
+		if (NULL == buf)
+		{
+			NXP_LOG_ERROR("Memory allocation failed\n");
+			ret = ENOMEM;
+		}
+		else
+		{
+			offset = (uint32_t)sizeof(pfe_ct_conntrack_stats_t) * (uint32_t)first;
+
+			while (i < pfe_class_get_num_of_pes(rtable->class))
+			{
+				/* One burst per PE */
+				ret = pfe_class_read_dmem((void *)rtable->class, (int32_t)i, buf, rtable->conntrack_stats_table_addr + offset, len);
+				if (EOK != ret)
+				{
+					break;
+				}
+
+				/* Calculate total statistics */
+				for (j = 0U; j < count; j++)
+				{
+					stats[j].hit += oal_ntohl(buf[j].hit);
+					stats[j].hit_bytes += oal_ntohl(buf[j].hit_bytes);
+				}
+
+				++i;
+			}
+
+			oal_mm_free(buf);
+		}
+	}
+
+	return ret;
+}
+
 /**
  * @brief		Clear conntrack statistics
  * @param[in]	rtable		The routing table instance
@@ -3643,18 +5371,34 @@ errno_t pfe_rtable_clear_stats(const pfe_rtable_t *rtable, uint8_t conntrack_ind
 uint32_t pfe_rtable_get_text_statistics(const pfe_rtable_t *rtable, struct seq_file *seq, uint8_t verb_level)
 {
 	errno_t ret;
-	pfe_ct_conntrack_stats_t stats = {0};
+	pfe_ct_conntrack_stats_t *stats;
+	uint32_t stats_size;
+	uint16_t stats_index;
+	uint32_t chain_hist[PFE_RTABLE_CHAIN_HIST_SIZE] = {0U};
+	uint32_t chain_len, chain_max = 0U;
+	uint32_t ii;
 	LLIST_t *item;
 	const pfe_rtable_entry_t *entry;
 
 	/* We keep unused parameter verb_level for consistency with rest of the *_get_text_statistics() functions */
 	(void)verb_level;
 
-	ret = pfe_rtable_get_stats(rtable, &stats, 0);
+	/*	Take the whole statistics table at once instead of reading it index by index */
+	stats_size = pfe_rtable_get_stats_table_size(rtable);
+	stats = oal_mm_malloc(stats_size * sizeof(pfe_ct_conntrack_stats_t));
+	if (NULL == stats)
+	{
+		NXP_LOG_ERROR("Memory allocation failed\n");
+		ret = ENOMEM;
+	}
+	else
+	{
+		ret = pfe_rtable_get_stats_bulk(rtable, stats, 0U, stats_size);
+	}
 
 	if (EOK == ret)
 	{
-		seq_printf(seq, "Default				  hit: %12u hit_bytes: %12u\n", stats.hit, stats.hit_bytes);
+		seq_printf(seq, "Default				  hit: %12u hit_bytes: %12u\n", stats[0].hit, stats[0].hit_bytes);
 
 		/*	Protect table accesses */
 		if (unlikely(EOK != oal_mutex_lock(rtable->lock)))
@@ -3662,6 +5406,21 @@ uint32_t pfe_rtable_get_text_statistics(const pfe_rtable_t *rtable, struct seq_f
 			NXP_LOG_ERROR("Mutex lock failed\n");
 		}
 
+		/*	Hash bucket chain lengths */
+		for (ii = 0U; ii < rtable->htable_size; ii++)
+		{
+			chain_len = pfe_rtable_get_bucket_len(rtable, ii);
+			chain_max = (chain_len > chain_max) ? chain_len : chain_max;
+			chain_hist[(chain_len < (PFE_RTABLE_CHAIN_HIST_SIZE - 1U)) ? chain_len : (PFE_RTABLE_CHAIN_HIST_SIZE - 1U)]++;
+		}
+
+		seq_printf(seq, "Chain length histogram (%u buckets, longest chain: %u, refused entries: %u)\n",
+				(uint_t)rtable->htable_size, (uint_t)chain_max, (uint_t)rtable->chain_full_count);
+		for (ii = 0U; ii < PFE_RTABLE_CHAIN_HIST_SIZE; ii++)
+		{
+			seq_printf(seq, "  length %s%u: %u\n", (ii == (PFE_RTABLE_CHAIN_HIST_SIZE - 1U)) ? ">=" : "  ", (uint_t)ii, (uint_t)chain_hist[ii]);
+		}
+
 		LLIST_ForEach(item, &rtable->active_entries)
 		{
 			entry = LLIST_Data(item, pfe_rtable_entry_t, list_entry);
@@ -3671,16 +5430,10 @@ uint32_t pfe_rtable_get_text_statistics(const pfe_rtable_t *rtable, struct seq_f
 				pfe_rtable_read_phys_entry(entry->phys_entry_va, entry->phys_entry_cache);
 			}
 
-			if (oal_ntohs(entry->phys_entry_cache->conntrack_stats_index) != 0U)
+			stats_index = oal_ntohs(entry->phys_entry_cache->conntrack_stats_index);
+			if ((0U != stats_index) && (stats_index < stats_size))
 			{
-				ret = pfe_rtable_get_stats(rtable, &stats, oal_ntohs(entry->phys_entry_cache->conntrack_stats_index));
-
-				if (EOK != ret)
-				{
-					continue;
-				}
-
-				seq_printf(seq, "Conntrack route_id %2d hit: %12u hit_bytes: %12u\n", oal_ntohl(entry->route_id) , stats.hit, stats.hit_bytes);
+				seq_printf(seq, "Conntrack route_id %2d hit: %12u hit_bytes: %12u\n", oal_ntohl(entry->route_id) , stats[stats_index].hit, stats[stats_index].hit_bytes);
 			}
 		}
 
@@ -3690,6 +5443,11 @@ uint32_t pfe_rtable_get_text_statistics(const pfe_rtable_t *rtable, struct seq_f
 		}
 	}
 
+	if (NULL != stats)
+	{
+		oal_mm_free(stats);
+	}
+
 	return 0;
 }
 
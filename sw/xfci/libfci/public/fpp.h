@@ -686,7 +686,10 @@ typedef struct CAL_PACKED_ALIGNED(4) {
 /* [fpp_ct_cmd_t] */
 typedef struct CAL_PACKED_ALIGNED(4) {
     uint16_t action;          /*< Action */
-    uint16_t rsvd0;           /*< RESERVED (do not use) */
+    uint8_t stats_index;      /*< 'orig' direction: Index of the conntrack statistics [ro]
+                                  See FPP_CMD_CONNTRACK_STATS. */
+    uint8_t stats_index_reply; /*< 'reply' direction: Index of the conntrack statistics [ro]
+                                  See FPP_CMD_CONNTRACK_STATS. */
     
     uint32_t saddr;           /*< 'orig' direction: Source IP address. [NBO] */
     uint32_t daddr;           /*< 'orig' direction: Destination IP address. [NBO] */
@@ -771,7 +774,10 @@ typedef struct CAL_PACKED {
 /* [fpp_ct6_cmd_t] */
 typedef struct CAL_PACKED_ALIGNED(4) {
     uint16_t action;          /*< Action */
-    uint16_t rsvd1;           /*< RESERVED (do not use) */
+    uint8_t stats_index;      /*< 'orig' direction: Index of the conntrack statistics [ro]
+                                  See FPP_CMD_CONNTRACK_STATS. */
+    uint8_t stats_index_reply; /*< 'reply' direction: Index of the conntrack statistics [ro]
+                                  See FPP_CMD_CONNTRACK_STATS. */
     
     uint32_t saddr[4];        /*< 'orig' direction: Source IP address. [NBO] */
     uint32_t daddr[4];        /*< 'orig' direction: Destination IP address. [NBO] */
@@ -815,6 +821,87 @@ typedef struct CAL_PACKED_ALIGNED(4) {
 } fpp_ct6_cmd_t;
 /* [fpp_ct6_cmd_t] */
 
+/**
+ * @def         FPP_CMD_CONNTRACK_STATS
+ * @brief       FCI command for bulk readout of conntrack statistics.
+ * @details     Related topics: @ref l3_router
+ * @details     Related data types: @ref fpp_conntrack_stats_bulk_cmd_t, @ref fpp_conntrack_stats_t
+ * @details     Returns statistics of many conntracks in a single reply. The statistics are
+ *              indexed by the conntrack statistics index which is reported in the
+ *              `.stats_index` and `.stats_index_reply` members of @ref fpp_ct_cmd_t and
+ *              @ref fpp_ct6_cmd_t. Index 0 holds statistics of traffic which did not match
+ *              any conntrack. Each reply carries up to @ref FPP_CONNTRACK_STATS_BULK_MAX items.
+ * @details     Supported `.action` values:
+ *              - @c FPP_ACTION_QUERY: Get statistics starting with index 0.
+ *              - @c FPP_ACTION_QUERY_CONT: Get statistics of the next range of indices.
+ * <br>
+ * @code{.c}
+ *  .............................................  
+ *  fpp_conntrack_stats_bulk_cmd_t cmd_to_fci = 
+ *  {
+ *    .action = FPP_ACTION_QUERY  // Action
+ *  };
+ *    
+ *  fpp_conntrack_stats_bulk_cmd_t reply_from_fci = {0};
+ *  unsigned short reply_length = 0u; 
+ *    
+ *  int rtn = 0;
+ *  rtn = fci_query(client, FPP_CMD_CONNTRACK_STATS,
+ *                  sizeof(fpp_conntrack_stats_bulk_cmd_t), (unsigned short*)(&cmd_to_fci),
+ *                  &reply_length, (unsigned short*)(&reply_from_fci));
+ *    
+ *  // 'reply_from_fci.stats[i]' now holds statistics of index 'reply_from_fci.first_index + i'
+ *  //  for 'i' lower than 'reply_from_fci.count'.
+ *    
+ *  cmd_to_fci.action = FPP_ACTION_QUERY_CONT;
+ *  rtn = fci_query(client, FPP_CMD_CONNTRACK_STATS,
+ *                  sizeof(fpp_conntrack_stats_bulk_cmd_t), (unsigned short*)(&cmd_to_fci),
+ *                  &reply_length, (unsigned short*)(&reply_from_fci));
+ *    
+ *  // 'reply_from_fci' now holds statistics of the next range of indices.
+ *  .............................................  
+ * @endcode
+ *
+ * Command return values
+ * ---------------------
+ * - @c FPP_ERR_OK <br>
+ *        Success
+ * - @c FPP_ERR_CT_ENTRY_NOT_FOUND <br>
+ *        The end of the query session (no more statistics).
+ * - @c FPP_ERR_WRONG_COMMAND_PARAM <br>
+ *        Unsupported action.
+ * - @c FPP_ERR_INTERNAL_FAILURE <br>
+ *        Internal FCI failure.
+ *
+ * @hideinitializer
+ */
+#define FPP_CMD_CONNTRACK_STATS                 0x0322
+
+/**
+ * @def         FPP_CONNTRACK_STATS_BULK_MAX
+ * @brief       Maximal number of statistics items in one @ref FPP_CMD_CONNTRACK_STATS reply.
+ * @hideinitializer
+ */
+#define FPP_CONNTRACK_STATS_BULK_MAX            30U
+
+/**
+ * @brief       Data structure for bulk conntrack statistics.
+ * @details     Related FCI commands: @ref FPP_CMD_CONNTRACK_STATS
+ *
+ * @note        Some values are in a network byte order [NBO].
+ *
+ * @snippet     fpp.h  fpp_conntrack_stats_bulk_cmd_t
+ */
+/* [fpp_conntrack_stats_bulk_cmd_t] */
+typedef struct CAL_PACKED_ALIGNED(4) {
+    uint16_t action;          /*< Action */
+    uint16_t first_index;     /*< Statistics index of the first item in '.stats'. [NBO,ro] */
+    uint16_t count;           /*< Number of valid items in '.stats'. [NBO,ro] */
+    uint16_t total;           /*< Number of entries of the statistics table. [NBO,ro] */
+    fpp_conntrack_stats_t CAL_PACKED_ALIGNED(4) stats[FPP_CONNTRACK_STATS_BULK_MAX]; /*< Statistics [ro] */
+} fpp_conntrack_stats_bulk_cmd_t;
+/* [fpp_conntrack_stats_bulk_cmd_t] */
+
 typedef struct CAL_PACKED {
 	uint16_t action;                       /*Action to perform*/
 	uint16_t format;                       /* indicates if SA info are present in command */
@@ -865,6 +952,9 @@ typedef struct CAL_PACKED {
  *                   Create a new route.
  *              - @c FPP_ACTION_DEREGISTER <br>
  *                   Remove (destroy) an existing route.
+ *              - @c FPP_ACTION_UPDATE <br>
+ *                   Change egress interface and MAC addresses of an existing route.
+ *                   All conntracks using the route are updated as well.
  *              - @c FPP_ACTION_QUERY <br>
  *                   Initiate (or reinitiate) a route query session and get properties 
  *                   of the first route from the internal collective list of all routes
@@ -911,6 +1001,27 @@ typedef struct CAL_PACKED {
  *  .............................................  
  * @endcode
  *
+ * FPP_ACTION_UPDATE
+ * -----------------
+ * Re-point an existing route to a new next hop. Destination IP address and flags
+ * of the route are kept.
+ * @code{.c}
+ *  .............................................  
+ *  fpp_rt_cmd_t cmd_to_fci = 
+ *  {
+ *    .action  = FPP_ACTION_UPDATE,    // Action
+ *    .src_mac = ...,                  // New source MAC address.
+ *    .dst_mac = ...,                  // New destination MAC address.
+ *    .output_device = ...,            // Name of the new egress physical interface.
+ *    .id    = ...                     // Route ID. [NBO]. User-defined.
+ *  };
+ *    
+ *  int rtn = 0;
+ *  rtn = fci_write(client, FPP_CMD_IP_ROUTE, sizeof(fpp_rt_cmd_t), 
+ *                                           (unsigned short*)(&cmd_to_fci));
+ *  .............................................  
+ * @endcode
+ *
  * FPP_ACTION_QUERY and FPP_ACTION_QUERY_CONT
  * ------------------------------------------
  * Get properties of a route.
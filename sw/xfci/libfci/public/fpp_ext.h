@@ -3508,6 +3508,48 @@ typedef struct CAL_PACKED_ALIGNED(2)
 /* [fpp_health_monitor_cmd_t] */
 
 
+/**
+ * @def FPP_CMD_L2_FDB_EVENT
+ * @brief       FCI event that notifies client about a change of the MAC table.
+ * @details     Related topics: @ref l2_bridge, @ref l2l3_bridge
+ * @details     Related data types: @ref fpp_l2_fdb_event_t
+ * @details     Sent for every MAC table entry which has been added, removed or modified,
+ *              including entries learned and aged by the hardware. Hardware-made changes
+ *              are discovered by periodic comparison of the table with its host copy so
+ *              they are reported with a delay.
+ * @details     Values of `.action`:
+ *              - @c FPP_ACTION_REGISTER <br>
+ *                   Entry has been added (configured or learned).
+ *              - @c FPP_ACTION_REMOVED <br>
+ *                   Entry has been removed (deleted, flushed or aged).
+ *              - @c FPP_ACTION_UPDATE <br>
+ *                   Forwarding properties of the entry have changed.
+ */
+#define FPP_CMD_L2_FDB_EVENT    0xf661
+
+/**
+ * @brief       Data structure for MAC table change event.
+ * @details     Related FCI commands: @ref FPP_CMD_L2_FDB_EVENT
+ * @note        Some values are in a network byte order [NBO].
+ *
+ * @snippet     fpp_ext.h  fpp_l2_fdb_event_t
+ */
+/* [fpp_l2_fdb_event_t] */
+typedef struct CAL_PACKED_ALIGNED(4)
+{
+    uint16_t action;        /*< Action */
+    uint16_t vlan;          /*< VLAN ID of the entry. [NBO] */
+    uint32_t forward_list;  /*< Egress physical interfaces. [NBO]. A bitset, see fpp_l2_static_ent_cmd_t. */
+    uint8_t mac[6];         /*< MAC address of the entry. */
+    uint8_t local;          /*< Local MAC address. (0 == false, 1 == true) */
+    uint8_t dst_discard;    /*< Frames with matching destination MAC address are discarded. (0 == disabled, 1 == enabled) */
+    uint8_t src_discard;    /*< Frames with matching source MAC address are discarded. (0 == disabled, 1 == enabled) */
+    uint8_t is_static;      /*< Static entry (0 == learned, 1 == static) */
+    uint16_t reserved;      /*< RESERVED (do not use) */
+} fpp_l2_fdb_event_t;
+/* [fpp_l2_fdb_event_t] */
+
+
 #endif /* FPP_EXT_H_ */
 
 /** @}*/
@@ -154,6 +154,8 @@
  *                <i>Management of IPv6 conntracks.</i>
  *              - @ref FPP_CMD_IPV4_SET_TIMEOUT <br>
  *                <i>Configuration of conntrack timeouts.</i>
+ *              - @ref FPP_CMD_CONNTRACK_STATS <br>
+ *                <i>Bulk readout of conntrack statistics.</i>
  *              - @ref FPP_CMD_DATA_BUF_PUT <br>
  *                <i>Send arbitrary data to the accelerator.</i>
  *              - @ref FPP_CMD_SPD <br>